@@ -34,6 +34,8 @@
 #include <OpenSim/Simulation/Manager/Manager.h>
 #include <OpenSim/Simulation/SimulationUtilities.h>
 #include <OpenSim/Analyses/BodyKinematics.h>
+#include <OpenSim/Analyses/Kinematics.h>
+#include <OpenSim/Analyses/StatesReporter.h>
 #include <OpenSim/Analyses/IMUDataReporter.h>
 #include <OpenSim/Actuators/ModelFactory.h>
 
@@ -51,6 +53,10 @@ void testBodyKinematics();
 
 void testIMUDataReporter();
 
+// Analyses run in parallel over ranges of the frames must produce the same
+// results as when run serially.
+void testParallelAnalyses();
+
 int main()
 {
     SimTK::Array_<std::string> failures;
@@ -97,6 +103,11 @@ int main()
         cout << e.what() << endl;
         failures.push_back("testIMUDataReporter");
     }   
+    try { testParallelAnalyses(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testParallelAnalyses");
+    }
 
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
@@ -443,3 +454,57 @@ void testIMUDataReporter() {
     AnalyzeTool roundTrip("analyzeReportIMUData.xml");
     roundTrip.run();
 }
+
+void testParallelAnalyses() {
+    Model model = ModelFactory::createDoublePendulum();
+    SimTK::State& s0 = model.initSystem();
+    model.getCoordinateSet().get(0).setValue(s0, 0.5);
+    Manager manager(model);
+    manager.initialize(s0);
+    manager.integrate(1.0);
+    const Storage& states = manager.getStateStorage();
+    const int iFinal = states.getSize() - 1;
+
+    // Run BodyKinematics and Kinematics (which support parallel frames) and
+    // StatesReporter (which runs serially) on a copy of the model, and
+    // return the storages they record.
+    auto analyze = [&](int numThreads) -> std::vector<Storage> {
+        std::unique_ptr<Model> copy(model.clone());
+        BodyKinematics* bodyKinematics = new BodyKinematics(copy.get());
+        Kinematics* kinematics = new Kinematics(copy.get());
+        StatesReporter* statesReporter = new StatesReporter(copy.get());
+        copy->addAnalysis(bodyKinematics);
+        copy->addAnalysis(kinematics);
+        copy->addAnalysis(statesReporter);
+        SimTK::State& s = copy->initSystem();
+        AnalyzeTool::run(s, *copy, 0, iFinal, states, false, numThreads);
+        for (int i = 0; i < copy->getAnalysisSet().getSize(); ++i) {
+            ASSERT(copy->getAnalysisSet().get(i).getOn());
+        }
+        return {*bodyKinematics->getPositionStorage(),
+                *bodyKinematics->getAccelerationStorage(),
+                *kinematics->getPositionStorage(),
+                *kinematics->getVelocityStorage(),
+                statesReporter->getStatesStorage()};
+    };
+
+    const std::vector<Storage> serial = analyze(1);
+    for (int numThreads : {2, 3, 0}) {
+        const std::vector<Storage> parallel = analyze(numThreads);
+        ASSERT_EQUAL(serial.size(), parallel.size());
+        for (int k = 0; k < (int)serial.size(); ++k) {
+            ASSERT_EQUAL(states.getSize(), serial[k].getSize());
+            ASSERT_EQUAL(serial[k].getSize(), parallel[k].getSize());
+            for (int r = 0; r < serial[k].getSize(); ++r) {
+                const StateVector& expected = *serial[k].getStateVector(r);
+                const StateVector& actual = *parallel[k].getStateVector(r);
+                ASSERT_EQUAL(expected.getTime(), actual.getTime(), 1e-15);
+                ASSERT_EQUAL(expected.getSize(), actual.getSize());
+                for (int j = 0; j < expected.getSize(); ++j) {
+                    ASSERT_EQUAL(expected.getData()[j], actual.getData()[j],
+                            1e-12);
+                }
+            }
+        }
+    }
+}
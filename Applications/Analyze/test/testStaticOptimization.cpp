@@ -40,6 +40,8 @@ void testArm26(const string& muscleModelClassName, double atol, double ftol);
 
 void testArm26DisabledMuscles();
 
+void testActiveSetSolver();
+
 void testLapackErrorDLASD4();
 
 void testModelWithPassiveForces();
@@ -105,6 +107,14 @@ int main()
         failures.push_back("testArm26DisabledMuscles");
     }
 
+    try {
+        testActiveSetSolver();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testActiveSetSolver");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -265,4 +275,34 @@ void testArm26DisabledMuscles() {
     ASSERT_EQUAL(forces.getColumnLabels().findIndex("TRIlat"), -1);
     ASSERT_EQUAL(forces.getColumnLabels().findIndex("TRImed"), -1);
 
-}
\ No newline at end of file
+}
+
+void testActiveSetSolver() {
+    // The active-set solution of the quadratic program must match that of
+    // the optimizer, both without (arm26) and with (arm26_bounds) activations
+    // at their bounds.
+    for (const string name : {"arm26", "arm26_bounds"}) {
+        const string setup = name + "_Setup_StaticOptimization.xml";
+        AnalyzeTool optimizer(setup);
+        optimizer.setResultsDir("Results_" + name + "_Optimizer");
+        optimizer.run();
+
+        AnalyzeTool activeSet(setup);
+        activeSet.setResultsDir("Results_" + name + "_ActiveSet");
+        auto& so = dynamic_cast<StaticOptimization&>(
+                activeSet.updAnalysisSet().get("StaticOptimization"));
+        so.setUseActiveSetSolver(true);
+        activeSet.run();
+
+        const string suffix = "/" + name + "_StaticOptimization_activation.sto";
+        Storage activationsOptimizer(optimizer.getResultsDir() + suffix);
+        Storage activationsActiveSet(activeSet.getResultsDir() + suffix);
+        ASSERT_EQUAL(activationsOptimizer.getSize(),
+                activationsActiveSet.getSize());
+        CHECK_STORAGE_AGAINST_STANDARD(activationsActiveSet,
+                activationsOptimizer, std::vector<double>(6, 1e-3),
+                __FILE__, __LINE__,
+                name + " activations with the active-set solver failed.");
+    }
+    cout << "testActiveSetSolver passed." << endl;
+}
@@ -38,6 +38,7 @@ using namespace OpenSim;
 using namespace std;
 
 void testThoracoscapularShoulderModel();
+void testParallelFrames();
 void testBallJoint();
 
 int main()
@@ -59,6 +60,9 @@ int main()
             "testGait failed");
         cout << "testGait passed" << endl;
 
+        testParallelFrames();
+        cout << "testParallelFrames passed" << endl;
+
         testThoracoscapularShoulderModel();
         cout << "testThoracoscapularShoulderModel passed" << endl;
         // Commented out testBallJoint due to sporadic crash in Model destructor
@@ -127,6 +131,23 @@ void testThoracoscapularShoulderModel() {
         "testThoracoscapularShoulderModel failed");
 }
 
+void testParallelFrames() {
+    // Solving the frames on several threads must give the same generalized
+    // forces as solving them serially.
+    Storage serial("Results/subject01_InverseDynamics.sto");
+    for (int numThreads : {2, 0}) {
+        InverseDynamicsTool id("subject01_Setup_InverseDynamics.xml");
+        id.setNumThreads(numThreads);
+        id.setResultsDir("Results_parallel");
+        id.run();
+        Storage parallel("Results_parallel/subject01_InverseDynamics.sto");
+        ASSERT_EQUAL(serial.getSize(), parallel.getSize());
+        CHECK_STORAGE_AGAINST_STANDARD(parallel, serial,
+            std::vector<double>(23, 1e-8), __FILE__, __LINE__,
+            "testParallelFrames failed");
+    }
+}
+
 void testBallJoint() {
     Model mdl;
     Body* bdy = new Body("body", 1.0, SimTK::Vec3(0), SimTK::Inertia(1));
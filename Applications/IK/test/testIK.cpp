@@ -42,6 +42,7 @@ void checkMarkersReferenceConsistencyFromTool(InverseKinematicsTool& ik);
 
 void testInverseKinematicsSolverWithOrientations();
 void testInverseKinematicsSolverWithEulerAnglesFromFile();
+void testInverseKinematicsSolverInParallel();
 
 int main()
 {
@@ -65,6 +66,15 @@ int main()
         failures.push_back("testInverseKinematicsSolverWithEulerAnglesFromFile");
     }
 
+    try {
+        ++itc;
+        testInverseKinematicsSolverInParallel();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testInverseKinematicsSolverInParallel");
+    }
+
     try {
         ++itc;
         testMarkerWeightAssignments("subject01_Setup_InverseKinematics.xml");
@@ -106,6 +116,35 @@ int main()
         failures.push_back("testInverseKinematicsGait2354_GUI_workflow");
     }
 
+    try {
+        // Solve two copies of the same trial concurrently; each must match
+        // the result of solving the trial on its own.
+        InverseKinematicsTool ikBatch("subject01_Setup_InverseKinematics.xml");
+        const std::string markerFile = ikBatch.getMarkerDataFileName();
+        const std::vector<std::string> outputFiles{
+                "subject01_walk1_ik_batch0.mot", "subject01_walk1_ik_batch1.mot"};
+        std::vector<double> trialTimes = ikBatch.runBatch(
+                {markerFile, markerFile}, outputFiles, 2);
+        ASSERT(trialTimes.size() == 2);
+        for (const auto& outputFile : outputFiles) {
+            Storage result(outputFile);
+            CHECK_STORAGE_AGAINST_STANDARD(result, standard,
+                std::vector<double>(24, 0.2), __FILE__, __LINE__,
+                "testInverseKinematicsBatch failed");
+        }
+        // Trials whose results would be written to the same files are
+        // rejected before any trial is solved.
+        ASSERT_THROW(OpenSim::Exception,
+                ikBatch.runBatch({markerFile, markerFile},
+                        {"subject01_walk1_ik_batch0.mot",
+                         "results/subject01_walk1_ik_batch0.mot"}, 2));
+        cout << "testInverseKinematicsBatch passed" << endl;
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testInverseKinematicsBatch");
+    }
+
     try {
         InverseKinematicsTool ik3("constraintTest_setup_ik.xml");
         ik3.run();
@@ -489,3 +528,52 @@ void testInverseKinematicsSolverWithEulerAnglesFromFile()
     const TimeSeriesTable standard("std_subject01_walk1_ik.mot");
     compareMotionTables(report, standard);
 }
+
+void testInverseKinematicsSolverInParallel()
+{
+    InverseKinematicsTool ik("subject01_Setup_InverseKinematics.xml");
+    Model model(ik.get_model_file());
+    SimTK::State& s = model.initSystem();
+    ik.setModel(model);
+
+    MarkersReference markersReference;
+    SimTK::Array_<CoordinateReference> coordinateReferences;
+    ik.populateReferences(markersReference, coordinateReferences);
+    const auto& times = markersReference.getMarkerTable().getIndependentColumn();
+    SimTK::Array_<double> solveTimes(times.begin(), times.end());
+
+    InverseKinematicsSolver ikSolver(model,
+            std::make_shared<MarkersReference>(markersReference),
+            coordinateReferences, ik.get_constraint_weight());
+    ikSolver.setAccuracy(ik.get_accuracy());
+
+    // The parallel solve does not depend on the solver's current solution.
+    const SimTK::State initialGuess = s;
+    SimTK::Matrix qParallel = ikSolver.trackInParallel(
+            initialGuess, solveTimes, 4, 4, 10);
+    ASSERT(qParallel.nrow() == (int)solveTimes.size(), __FILE__, __LINE__);
+    ASSERT(qParallel.ncol() == s.getNQ(), __FILE__, __LINE__);
+
+    // Solving in parallel must be deterministic.
+    SimTK::Matrix qParallelAgain = ikSolver.trackInParallel(
+            initialGuess, solveTimes, 2, 4, 10);
+    ASSERT((qParallel - qParallelAgain).norm() == 0, __FILE__, __LINE__,
+            "Parallel IK is not deterministic.");
+
+    // Compare with solving the frames one after another.
+    s.updTime() = solveTimes[0];
+    ikSolver.assemble(s);
+    double maxError = 0;
+    for (int i = 0; i < (int)solveTimes.size(); ++i) {
+        s.updTime() = solveTimes[i];
+        ikSolver.track(s);
+        const SimTK::Vector qSequential = s.getQ();
+        const SimTK::Vector qRow = ~qParallel.row(i);
+        maxError = std::max(maxError, (qRow - qSequential).normInf());
+    }
+    cout << "testInverseKinematicsSolverInParallel: max difference from "
+            "sequential solve = " << maxError << endl;
+    // Same tolerance (0.2 degrees) as the regression tests for the tool.
+    ASSERT(maxError < SimTK::convertDegreesToRadians(0.2),
+            __FILE__, __LINE__, "Parallel IK does not match sequential IK.");
+}
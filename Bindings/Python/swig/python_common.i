@@ -19,6 +19,14 @@ using namespace OpenSim;
 using namespace SimTK;
 %}
 
+// Add support for converting between NumPy and C arrays (for zero-copy
+// views of tables and states). This must appear before any %import.
+%include "numpy.i"
+%init %{
+    import_array();
+%}
+%include "python_numpy_view.i"
+
 %include "python_preliminaries.i"
 
 // Tell SWIG about the simbody module.
@@ -167,8 +175,6 @@ note: ## is a "glue" operator: `a ## b` --> `ab`.
 // ====================
 //%include <OpenSim/Common/LoadOpenSimLibrary.h>
 
-// %include "numpy.i"
-
 // Pythonic operators
 // ==================
 // Extend the template Vec class; these methods will apply for all template
@@ -289,6 +295,66 @@ note: ## is a "glue" operator: `a ## b` --> `ab`.
     }
 }
 
+// Zero-copy NumPy views of the data in a table. The views keep the table alive
+// but are invalidated if rows or columns are added to or removed from the
+// table.
+%extend OpenSim::DataTable_<double, double> {
+    PyObject* _getMatrixNumPyView(PyObject* owner, bool writeable) {
+        const auto& matrix = $self->getMatrix();
+        SimTK_ASSERT_ALWAYS(matrix.hasContiguousData(),
+                "Expected the table's matrix to have contiguous data.");
+        // The data is stored column by column.
+        npy_intp dims[2] = {matrix.nrow(), matrix.ncol()};
+        npy_intp strides[2] = {sizeof(double), sizeof(double) * dims[0]};
+        return opensimNumPyView(owner, matrix.getContiguousScalarData(), 2,
+                dims, strides, writeable);
+    }
+    PyObject* _getIndependentColumnNumPyView(PyObject* owner) {
+        const auto& column = $self->getIndependentColumn();
+        npy_intp dims[1] = {(npy_intp)column.size()};
+        return opensimNumPyView(owner, column.data(), 1, dims, NULL, false);
+    }
+%pythoncode %{
+    def getMatrixNumPyView(self, writeable=False):
+        """Get the table's matrix as a NumPy array (rows are times) that shares
+        memory with the table instead of copying it."""
+        return self._getMatrixNumPyView(self, writeable)
+    def getIndependentColumnNumPyView(self):
+        """Get the (read-only) independent column as a NumPy array that shares
+        memory with the table."""
+        return self._getIndependentColumnNumPyView(self)
+%};
+}
+%extend OpenSim::DataTable_<double, SimTK::Vec3> {
+    PyObject* _getMatrixNumPyView(PyObject* owner, bool writeable) {
+        const auto& matrix = $self->getMatrix();
+        SimTK_ASSERT_ALWAYS(matrix.hasContiguousData(),
+                "Expected the table's matrix to have contiguous data.");
+        // Elements are stored column by column; each element is 3 doubles.
+        npy_intp dims[3] = {matrix.nrow(), matrix.ncol(), 3};
+        npy_intp strides[3] = {sizeof(SimTK::Vec3),
+                               sizeof(SimTK::Vec3) * dims[0], sizeof(double)};
+        return opensimNumPyView(owner, matrix.getContiguousScalarData(), 3,
+                dims, strides, writeable);
+    }
+    PyObject* _getIndependentColumnNumPyView(PyObject* owner) {
+        const auto& column = $self->getIndependentColumn();
+        npy_intp dims[1] = {(npy_intp)column.size()};
+        return opensimNumPyView(owner, column.data(), 1, dims, NULL, false);
+    }
+%pythoncode %{
+    def getMatrixNumPyView(self, writeable=False):
+        """Get the table's matrix as a NumPy array with shape
+        (rows, columns, 3) that shares memory with the table instead of
+        copying it."""
+        return self._getMatrixNumPyView(self, writeable)
+    def getIndependentColumnNumPyView(self):
+        """Get the (read-only) independent column as a NumPy array that shares
+        memory with the table."""
+        return self._getIndependentColumnNumPyView(self)
+%};
+}
+
 // Include all the OpenSim code.
 // =============================
 %include <Bindings/preliminaries.i>
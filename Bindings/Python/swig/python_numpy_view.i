@@ -0,0 +1,26 @@
+// Zero-copy NumPy views
+// =====================
+// Helper for creating NumPy arrays that refer to (rather than copy) memory
+// owned by a wrapped C++ object. Include this file after numpy.i (and after
+// calling import_array()) in any module that creates such views.
+%{
+// Create a NumPy array of doubles that refers to the memory at `data`.
+// The array holds a reference to `owner` (the Python object owning the
+// memory) so that the memory remains valid at least as long as the array.
+// Returns NULL (with a Python error set) on failure.
+static PyObject* opensimNumPyView(PyObject* owner, const double* data,
+        int nd, npy_intp* dims, npy_intp* strides, bool writeable) {
+    int flags = NPY_ARRAY_ALIGNED;
+    if (writeable) flags |= NPY_ARRAY_WRITEABLE;
+    PyObject* array = PyArray_New(&PyArray_Type, nd, dims, NPY_DOUBLE,
+            strides, const_cast<double*>(data), 0, flags, NULL);
+    if (!array) return NULL;
+    // PyArray_SetBaseObject() steals the reference, even on failure.
+    Py_INCREF(owner);
+    if (PyArray_SetBaseObject((PyArrayObject*)array, owner) < 0) {
+        Py_DECREF(array);
+        return NULL;
+    }
+    return array;
+}
+%}
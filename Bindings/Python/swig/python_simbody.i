@@ -21,6 +21,7 @@ using namespace SimTK;
 %init %{
     import_array();
 %}
+%include "python_numpy_view.i"
 
 %include "python_preliminaries.i"
 
@@ -200,9 +201,22 @@ namespace SimTK {
                              $self->size());
         std::copy_n($self->getContiguousScalarData(), n, numpyout);
     }
+    PyObject* _to_numpy_view(PyObject* owner, bool writeable) {
+        SimTK_ASSERT_ALWAYS($self->hasContiguousData(),
+                "Cannot create a view of a Vector with non-contiguous data.");
+        npy_intp dims[1] = {$self->size()};
+        return opensimNumPyView(owner, $self->getContiguousScalarData(), 1,
+                dims, NULL, writeable);
+    }
 %pythoncode %{
     def to_numpy(self):
         return self._to_numpy(self.size())
+    def to_numpy_view(self, writeable=False):
+        """Get a NumPy array that shares memory with this Vector (no copy).
+        The array keeps this Python object alive, but is invalidated if the
+        Vector is resized or if this object refers to memory owned by another
+        object (e.g., State.getQ()) that is destroyed."""
+        return self._to_numpy_view(self, writeable)
 %};
 }
 
@@ -229,9 +243,21 @@ namespace SimTK {
                              $self->size());
         std::copy_n($self->getContiguousScalarData(), n, numpyout);
     }
+    PyObject* _to_numpy_view(PyObject* owner, bool writeable) {
+        SimTK_ASSERT_ALWAYS($self->hasContiguousData(),
+                "Cannot create a view of a RowVector with non-contiguous "
+                "data.");
+        npy_intp dims[1] = {$self->size()};
+        return opensimNumPyView(owner, $self->getContiguousScalarData(), 1,
+                dims, NULL, writeable);
+    }
 %pythoncode %{
     def to_numpy(self):
         return self._to_numpy(self.size())
+    def to_numpy_view(self, writeable=False):
+        """Get a NumPy array that shares memory with this RowVector (no copy).
+        See VectorBase.to_numpy_view()."""
+        return self._to_numpy_view(self, writeable)
 %};
 }
 
@@ -249,12 +275,25 @@ namespace SimTK {
                 "Number of columns must be %i.", $self->ncol());
         std::copy_n($self->getContiguousScalarData(), nrow * ncol, numpyout);
     }
+    PyObject* _to_numpy_view(PyObject* owner, bool writeable) {
+        SimTK_ASSERT_ALWAYS($self->hasContiguousData(),
+                "Cannot create a view of a Matrix with non-contiguous data.");
+        // The data is stored column by column.
+        npy_intp dims[2] = {$self->nrow(), $self->ncol()};
+        npy_intp strides[2] = {sizeof(double), sizeof(double) * dims[0]};
+        return opensimNumPyView(owner, $self->getContiguousScalarData(), 2,
+                dims, strides, writeable);
+    }
 %pythoncode %{
     def to_numpy(self):
         import numpy as np
         mat = np.empty([self.nrow(), self.ncol()])
         self._to_numpy(mat)
         return mat
+    def to_numpy_view(self, writeable=False):
+        """Get a NumPy array that shares memory with this Matrix (no copy).
+        See VectorBase.to_numpy_view()."""
+        return self._to_numpy_view(self, writeable)
 %};
 }
 
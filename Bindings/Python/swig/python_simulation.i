@@ -22,6 +22,14 @@ using namespace SimTK;
 %ignore OpenSim::Coordinate::setRange;
 
 
+// Add support for converting between NumPy and C arrays (for zero-copy
+// views of tables and states). This must appear before any %import.
+%include "numpy.i"
+%init %{
+    import_array();
+%}
+%include "python_numpy_view.i"
+
 %include "python_preliminaries.i"
 
 // Tell SWIG about the modules we depend on.
@@ -175,3 +183,67 @@ SET_ADOPT_HELPER(Analysis);
         return $self->get(i);
     }
 };
+
+// NumPy access to the state variables in a StatesTrajectory. Each state's
+// q, u and z are views of the state's memory; the matrices of all states are
+// assembled in a single pass in C++.
+%apply (int DIM1, int DIM2, double* INPLACE_ARRAY2) {
+    (int nstates, int nvars, double* numpyout)
+};
+%extend OpenSim::StatesTrajectory {
+    PyObject* _getStateVariableNumPyView(PyObject* owner, int index,
+            int which) {
+        const SimTK::Vector& values = which == 0 ? $self->get(index).getQ()
+                : which == 1 ? $self->get(index).getU()
+                             : $self->get(index).getZ();
+        npy_intp dims[1] = {values.size()};
+        return opensimNumPyView(owner, values.getContiguousScalarData(), 1,
+                dims, NULL, false);
+    }
+    void _getStateVariableMat(int nstates, int nvars, double* numpyout,
+            int which) {
+        SimTK_ASSERT1_ALWAYS(nstates == (int)$self->getSize(),
+                "Number of rows must be %i.", (int)$self->getSize());
+        for (int i = 0; i < nstates; ++i) {
+            const SimTK::State& state = $self->get(i);
+            const SimTK::Vector& values = which == 0 ? state.getQ()
+                    : which == 1 ? state.getU() : state.getZ();
+            SimTK_ASSERT1_ALWAYS(nvars == values.size(),
+                    "Number of columns must be %i.", values.size());
+            std::copy_n(values.getContiguousScalarData(), nvars,
+                    numpyout + i * nvars);
+        }
+    }
+%pythoncode %{
+    def getQView(self, index):
+        """Get the generalized coordinates of the state at the given index as
+        a read-only NumPy array that shares memory with the state."""
+        return self._getStateVariableNumPyView(self, index, 0)
+    def getUView(self, index):
+        """Get the generalized speeds of the state at the given index as a
+        read-only NumPy array that shares memory with the state."""
+        return self._getStateVariableNumPyView(self, index, 1)
+    def getZView(self, index):
+        """Get the auxiliary state variables of the state at the given index
+        as a read-only NumPy array that shares memory with the state."""
+        return self._getStateVariableNumPyView(self, index, 2)
+
+    def _getMat(self, which, numVars):
+        import numpy as np
+        mat = np.empty([self.getSize(), numVars])
+        self._getStateVariableMat(mat, which)
+        return mat
+    def getQMat(self):
+        """Get the generalized coordinates of all states as a NumPy array
+        with one row per state."""
+        return self._getMat(0, self.get(0).getNQ() if self.getSize() else 0)
+    def getUMat(self):
+        """Get the generalized speeds of all states as a NumPy array with one
+        row per state."""
+        return self._getMat(1, self.get(0).getNU() if self.getSize() else 0)
+    def getZMat(self):
+        """Get the auxiliary state variables of all states as a NumPy array
+        with one row per state."""
+        return self._getMat(2, self.get(0).getNZ() if self.getSize() else 0)
+%};
+};
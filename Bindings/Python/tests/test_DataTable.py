@@ -565,3 +565,33 @@ class TestDataTable(unittest.TestCase):
                                                  '2_x', '2_y', '2_z')
         print(tableDouble)
         
+
+    def test_numpy_views(self):
+        import numpy as np
+        table = osim.TimeSeriesTable()
+        table.setColumnLabels(['a', 'b', 'c'])
+        table.appendRow(0.1, osim.RowVector([1, 2, 3]))
+        table.appendRow(0.2, osim.RowVector([4, 5, 6]))
+        mat = table.getMatrixNumPyView()
+        assert mat.shape == (2, 3)
+        assert np.array_equal(mat, [[1, 2, 3], [4, 5, 6]])
+        assert not mat.flags.writeable
+        time = table.getIndependentColumnNumPyView()
+        assert np.array_equal(time, [0.1, 0.2])
+
+        # Writing through the view modifies the table.
+        mat = table.getMatrixNumPyView(writeable=True)
+        mat[1, 2] = 60
+        assert table.getRowAtIndex(1)[2] == 60
+
+        # The view keeps the table alive.
+        del table
+        assert mat[1, 2] == 60
+
+        tableVec3 = osim.TimeSeriesTableVec3()
+        tableVec3.setColumnLabels(['0', '1'])
+        tableVec3.appendRow(0.1, osim.RowVectorVec3([osim.Vec3(1, 2, 3),
+                                                     osim.Vec3(4, 5, 6)]))
+        mat = tableVec3.getMatrixNumPyView()
+        assert mat.shape == (1, 2, 3)
+        assert np.array_equal(mat[0, 1], [4, 5, 6])
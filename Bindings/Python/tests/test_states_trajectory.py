@@ -102,6 +102,26 @@ class TestStatesTrajectory(unittest.TestCase):
         self.assertEqual(states.getSize(), 2)
         self.assertEqual(states[1].getTime(), 1.0)
 
+    def test_numpy(self):
+        import numpy as np
+        model = osim.Model(os.path.join(test_dir,
+            "gait10dof18musc_subject01.osim"))
+        state = model.initSystem()
+        states = osim.StatesTrajectory()
+        states.append(state)
+        state.setTime(1.0)
+        state.updQ()[0] = 0.5
+        states.append(state)
+
+        q = states.getQView(1)
+        self.assertEqual(q.shape, (state.getNQ(),))
+        self.assertEqual(q[0], 0.5)
+        qmat = states.getQMat()
+        self.assertEqual(qmat.shape, (2, state.getNQ()))
+        self.assertTrue(np.array_equal(qmat[1], q))
+        self.assertEqual(states.getUMat().shape, (2, state.getNU()))
+        self.assertEqual(states.getZMat().shape, (2, state.getNZ()))
+
     def test_out_of_range(self):
         model = osim.Model(os.path.join(test_dir,
             "gait10dof18musc_subject01.osim"))
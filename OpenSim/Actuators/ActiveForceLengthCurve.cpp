@@ -80,6 +80,7 @@ void ActiveForceLengthCurve::constructProperties()
     constructProperty_max_norm_active_fiber_length(1.8123);
     constructProperty_shallow_ascending_slope(0.8616);
     constructProperty_minimum_value(0.1);
+    constructProperty_lookup_table_tolerance();
 }
 
 void ActiveForceLengthCurve::buildCurve()
@@ -87,6 +88,9 @@ void ActiveForceLengthCurve::buildCurve()
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
     delete f;
+    if(!getProperty_lookup_table_tolerance().empty()) {
+        m_curve.buildLookupTable(get_lookup_table_tolerance());
+    }
     setObjectIsUpToDateWithProperties();
 }
 
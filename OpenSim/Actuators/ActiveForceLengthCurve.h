@@ -127,6 +127,8 @@ public:
         "Slope of the shallow ascending limb");
     OpenSim_DECLARE_PROPERTY(minimum_value, double,
         "Minimum value of the active-force-length curve");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(lookup_table_tolerance, double,
+        "Tolerance of the lookup table used to evaluate the curve, if set; see SmoothSegmentedFunction::buildLookupTable().");
 
 //==============================================================================
 // PUBLIC METHODS
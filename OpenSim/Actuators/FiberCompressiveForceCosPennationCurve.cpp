@@ -82,6 +82,7 @@ void FiberCompressiveForceCosPennationCurve::constructProperties()
     constructProperty_engagement_angle_in_degrees(85);
     constructProperty_stiffness_at_perpendicular();
     constructProperty_curviness();
+    constructProperty_lookup_table_tolerance();
 
 }
 
@@ -99,6 +100,9 @@ void FiberCompressiveForceCosPennationCurve::buildCurve( bool computeIntegral )
     m_curve = *f; 
     
     delete f;  
+    if(!getProperty_lookup_table_tolerance().empty()) {
+        m_curve.buildLookupTable(get_lookup_table_tolerance());
+    }
        
     setObjectIsUpToDateWithProperties();
 }
@@ -72,6 +72,7 @@ void FiberCompressiveForceLengthCurve::constructProperties()
     constructProperty_norm_length_at_zero_force(0.5);
     constructProperty_stiffness_at_zero_length();
     constructProperty_curviness();
+    constructProperty_lookup_table_tolerance();
 }
 
 
@@ -88,6 +89,9 @@ void FiberCompressiveForceLengthCurve::buildCurve( bool computeIntegral )
     m_curve = *f;  
 
     delete f; 
+    if(!getProperty_lookup_table_tolerance().empty()) {
+        m_curve.buildLookupTable(get_lookup_table_tolerance());
+    }
 
     setObjectIsUpToDateWithProperties();
 }
@@ -70,6 +70,8 @@ public:
         "Fiber stiffness at zero length");
     OpenSim_DECLARE_OPTIONAL_PROPERTY(curviness, double, 
         "Fiber curve bend, from linear to maximum bend (0-1)");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(lookup_table_tolerance, double,
+        "Tolerance of the lookup table used to evaluate the curve, if set; see SmoothSegmentedFunction::buildLookupTable().");
 
 //==============================================================================
 // PUBLIC METHODS
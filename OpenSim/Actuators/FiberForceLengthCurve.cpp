@@ -77,6 +77,7 @@ void FiberForceLengthCurve::constructProperties()
     constructProperty_stiffness_at_low_force();
     constructProperty_stiffness_at_one_norm_force();
     constructProperty_curviness();
+    constructProperty_lookup_table_tolerance();
 }
 
 void FiberForceLengthCurve::buildCurve(bool computeIntegral)
@@ -93,6 +94,9 @@ void FiberForceLengthCurve::buildCurve(bool computeIntegral)
 
     m_curve = *f;
     delete f;
+    if(!getProperty_lookup_table_tolerance().empty()) {
+        m_curve.buildLookupTable(get_lookup_table_tolerance());
+    }
 
     setObjectIsUpToDateWithProperties();
 }
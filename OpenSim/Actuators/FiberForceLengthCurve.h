@@ -172,6 +172,8 @@ public:
         "Fiber stiffness at a tension of 1 normalized force");
     OpenSim_DECLARE_OPTIONAL_PROPERTY(curviness, double,
         "Fiber curve bend, from linear (0) to maximum bend (1)");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(lookup_table_tolerance, double,
+        "Tolerance of the lookup table used to evaluate the curve, if set; see SmoothSegmentedFunction::buildLookupTable().");
 
 //==============================================================================
 // PUBLIC METHODS
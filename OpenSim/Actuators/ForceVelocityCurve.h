@@ -158,6 +158,8 @@ public:
         "Concentric curve shape, from linear (0) to maximal curve (1)");
     OpenSim_DECLARE_PROPERTY(eccentric_curviness, double,
         "Eccentric curve shape, from linear (0) to maximal curve (1)");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(lookup_table_tolerance, double,
+        "Tolerance of the lookup table used to evaluate the curve, if set; see SmoothSegmentedFunction::buildLookupTable().");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -253,7 +253,31 @@ void testActiveForceLengthCurve()
             fname.append(".csv");
             remove(fname.c_str());
 
-        cout << "Passed: Testing Services for connectivity" << endl;                            
+        cout << "Passed: Testing Services for connectivity" << endl;
+
+        cout <<"6. Testing lookup table:" << endl;
+            ActiveForceLengthCurve falCurve5;
+            SimTK_TEST(falCurve5.getProperty_lookup_table_tolerance().empty());
+            falCurve5.set_lookup_table_tolerance(1e-8);
+            falCurve5.ensureCurveUpToDate();
+            SimTK_TEST_EQ_TOL(falCurve5.calcValue(0.8),
+                              falCurve4.calcValue(0.8), 1e-7);
+            SimTK_TEST_EQ_TOL(falCurve5.calcDerivative(0.8,1),
+                              falCurve4.calcDerivative(0.8,1), 1e-6);
+
+            falCurve5.print("lookup_ActiveForceLengthCurve.xml");
+            tmpObj = Object::
+                       makeObjectFromFile("lookup_ActiveForceLengthCurve.xml");
+            ActiveForceLengthCurve falCurve6 =
+                *dynamic_cast<ActiveForceLengthCurve*>(tmpObj);
+            delete tmpObj;
+            remove("lookup_ActiveForceLengthCurve.xml");
+
+            SimTK_TEST(falCurve6 == falCurve5);
+            SimTK_TEST(falCurve6.get_lookup_table_tolerance() == 1e-8);
+            falCurve6.ensureCurveUpToDate();
+            SimTK_TEST(falCurve6.calcValue(0.8) == falCurve5.calcValue(0.8));
+        cout << "Passed: Testing lookup table" << endl;
 
         //cout <<"**************************************************"<<endl;
         cout <<"Service correctness is tested by underlying utility class"<<endl;
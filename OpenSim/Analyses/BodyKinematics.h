@@ -113,6 +113,8 @@ public:
 
 
     void setModel(Model& aModel) override;
+    ArrayPtrs<Storage>& getStorageList() override;
+    bool getSupportsParallelFrames() const override { return true; }
     //--------------------------------------------------------------------------
     // ANALYSIS
     //--------------------------------------------------------------------------
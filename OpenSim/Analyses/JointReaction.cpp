@@ -524,6 +524,20 @@ setModel(Model& aModel)
     // for force, moment, and point of application
     _Loads.setSize(9*numJoints);
 }
+//_____________________________________________________________________________
+/**
+ * Get the list of storages holding the results, which contains only the
+ * storage of the reaction loads. The list does not own the storage.
+ *
+ * @return List of storages.
+ */
+ArrayPtrs<Storage>& JointReaction::
+getStorageList()
+{
+    _storageList.setSize(0);
+    _storageList.append(&_storeReactionLoads);
+    return(_storageList);
+}
 
 
 //=============================================================================
@@ -181,6 +181,9 @@ public:
     const Array<std::string>& getInFrame() const { return _inFrame; }
     void setInFrame( Array<std::string>& inFrame) { _inFrame = inFrame; }
 
+    ArrayPtrs<Storage>& getStorageList() override;
+    bool getSupportsParallelFrames() const override { return true; }
+
     //-------------------------------------------------------------------------
     // INTEGRATION
     //----------------------------------------------------------------------
@@ -96,6 +96,7 @@ public:
     void setModel(Model& aModel) override;
 
     void setRecordAccelerations(bool aRecordAccelerations) { _recordAccelerations = aRecordAccelerations; } // TODO: re-allocate storage or delete storage
+    bool getSupportsParallelFrames() const override { return true; }
 
     //--------------------------------------------------------------------------
     // ANALYSIS
@@ -641,23 +641,34 @@ int MuscleAnalysis::record(const SimTK::State& s)
 
     if (_computeMoments){
         // LOOP OVER ACTIVE MOMENT ARM STORAGE OBJECTS
-        Coordinate *q = NULL;
         Storage *maStore=NULL, *mStore=NULL;
         int nq = _momentArmStorageArray.getSize();
         Array<double> ma(0.0,nm),m(0.0,nm);
 
+        // Solve for the moment arms of all muscles about all coordinates at
+        // once, rather than for each muscle and coordinate separately.
+        _model->getMultibodySystem().realize(s, s.getSystemStage());
+        if (!_momentArmSolver)
+            _momentArmSolver.reset(new MomentArmSolver(*_model));
+        std::vector<const Coordinate*> coordinates(nq);
+        for(int i=0; i<nq; i++) {
+            coordinates[i] = _momentArmStorageArray[i]->q;
+        }
+        std::vector<const GeometryPath*> paths(nm);
+        for(int j=0; j<nm; j++) {
+            paths[j] = &_muscleArray[j]->getGeometryPath();
+        }
+        const SimTK::Matrix momentArms =
+                _momentArmSolver->solve(s, coordinates, paths);
+
         for(int i=0; i<nq; i++) {
 
-            q = _momentArmStorageArray[i]->q;
             maStore = _momentArmStorageArray[i]->momentArmStore;
             mStore = _momentArmStorageArray[i]->momentStore;
-           
-            // bool locked = q->getLocked(s);
 
-            _model->getMultibodySystem().realize(s, s.getSystemStage());
             // LOOP OVER MUSCLES
             for(int j=0; j<nm; j++) {
-                ma[j] = _muscleArray[j]->computeMomentArm(s,*q);
+                ma[j] = momentArms(j, i);
                 m[j] = ma[j] * force[j];
             }
             maStore->append(s.getTime(),nm,&ma[0]);
@@ -686,6 +697,8 @@ int MuscleAnalysis::begin(const SimTK::State&s )
     if(!proceed()) return 0;
 
     allocateStorageObjects();
+    // The system may have been re-initialized since the last analysis.
+    _momentArmSolver.reset();
 
     // RESET STORAGE
     Storage *store;
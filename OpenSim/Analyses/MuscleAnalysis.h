@@ -137,6 +137,9 @@ private:
 #ifndef SWIG
     /** Array of active storage and coordinate pairs. */
     ArrayPtrs<StorageCoordinatePair> _momentArmStorageArray;
+    /** Solver for the moment arms of all muscles about all coordinates;
+    created when first needed after begin(). */
+    std::unique_ptr<MomentArmSolver> _momentArmSolver;
 #endif
     /** Array of active muscles. */
     ArrayPtrs<Muscle> _muscleArray;
@@ -221,6 +224,7 @@ public:
 #ifndef SWIG
     const ArrayPtrs<StorageCoordinatePair>& getMomentArmStorageArray() const { return _momentArmStorageArray; }
 #endif
+    bool getSupportsParallelFrames() const override { return true; }
     //--------------------------------------------------------------------------
     // ANALYSIS
     //--------------------------------------------------------------------------
@@ -487,6 +487,22 @@ getPositionStorage()
 {
     return(_pStore);
 }
+//_____________________________________________________________________________
+/**
+ * Get the list of the acceleration, velocity, and position storages. The
+ * list does not own the storages.
+ *
+ * @return List of storages.
+ */
+ArrayPtrs<Storage>& PointKinematics::
+getStorageList()
+{
+    _storageList.setSize(0);
+    if(_aStore!=NULL) _storageList.append(_aStore);
+    if(_vStore!=NULL) _storageList.append(_vStore);
+    if(_pStore!=NULL) _storageList.append(_pStore);
+    return(_storageList);
+}
 
 //-----------------------------------------------------------------------------
 // STORAGE CAPACITY
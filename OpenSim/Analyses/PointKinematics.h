@@ -139,6 +139,8 @@ public:
     Storage* getAccelerationStorage();
     Storage* getVelocityStorage();
     Storage* getPositionStorage();
+    ArrayPtrs<Storage>& getStorageList() override;
+    bool getSupportsParallelFrames() const override { return true; }
 
     //--------------------------------------------------------------------------
     // ANALYSIS
@@ -61,6 +61,7 @@ StaticOptimization::StaticOptimization(Model *aModel) :
     _useMusclePhysiology(_useMusclePhysiologyProp.getValueBool()),
     _convergenceCriterion(_convergenceCriterionProp.getValueDbl()),
     _maximumIterations(_maximumIterationsProp.getValueInt()),
+    _useActiveSetSolver(_useActiveSetSolverProp.getValueBool()),
     _modelWorkingCopy(NULL)
 {
     setNull();
@@ -82,6 +83,7 @@ StaticOptimization::StaticOptimization(const StaticOptimization &aStaticOptimiza
     _useMusclePhysiology(_useMusclePhysiologyProp.getValueBool()),
     _convergenceCriterion(_convergenceCriterionProp.getValueDbl()),
     _maximumIterations(_maximumIterationsProp.getValueInt()),
+    _useActiveSetSolver(_useActiveSetSolverProp.getValueBool()),
     _modelWorkingCopy(NULL)
 {
     setNull();
@@ -114,7 +116,10 @@ operator=(const StaticOptimization &aStaticOptimization)
     _activationExponent=aStaticOptimization._activationExponent;
     _convergenceCriterion=aStaticOptimization._convergenceCriterion;
     _maximumIterations=aStaticOptimization._maximumIterations;
+    _useActiveSetSolver=aStaticOptimization._useActiveSetSolver;
     _forceReporter = nullptr;
+    _optimizer = nullptr;
+    _target = nullptr;
     _useMusclePhysiology=aStaticOptimization._useMusclePhysiology;
     return(*this);
 }
@@ -138,6 +143,7 @@ void StaticOptimization::setNull()
     _numCoordinateActuators = 0;
     _convergenceCriterion = 1e-4;
     _maximumIterations = 100;
+    _useActiveSetSolver = false;
     _forceReporter = nullptr;
     setName("StaticOptimization");
 }
@@ -173,6 +179,13 @@ setupProperties()
         "An integer for setting the maximum number of iterations the optimizer can use at each time.  ");
     _maximumIterationsProp.setName("optimizer_max_iterations");
     _propertySet.append(&_maximumIterationsProp);
+
+    _useActiveSetSolverProp.setComment(
+        "If true and the activation exponent is 2, the quadratic program of "
+        "each time is solved directly with an active-set method; the "
+        "optimizer is used only if that fails.");
+    _useActiveSetSolverProp.setName("use_active_set_solver");
+    _propertySet.append(&_useActiveSetSolverProp);
 }
 
 //=============================================================================
@@ -332,35 +345,45 @@ record(const SimTK::State& s)
     //_maxIterations = 2000;
 
     // Optimization target
+    // The target (and its copy of the states splines) is built once per
+    // analysis; only the constraints are recomputed for each frame.
     _modelWorkingCopy->setAllControllersEnabled(false);
-    StaticOptimizationTarget target(sWorkingCopy,_modelWorkingCopy,na,nacc,_useMusclePhysiology);
-    target.setStatesStore(_statesStore);
-    target.setStatesSplineSet(_statesSplineSet);
-    target.setActivationExponent(_activationExponent);
-    target.setDX(_numericalDerivativeStepSize);
+    if(!_target) {
+        _target.reset(new StaticOptimizationTarget(sWorkingCopy,
+                _modelWorkingCopy,na,nacc,_useMusclePhysiology));
+        _target->setStatesStore(_statesStore);
+        _target->setStatesSplineSet(_statesSplineSet);
+        _target->setActivationExponent(_activationExponent);
+        _target->setDX(_numericalDerivativeStepSize);
+    }
+    StaticOptimizationTarget& target = *_target;
 
     // Pick optimizer algorithm
     SimTK::OptimizerAlgorithm algorithm = SimTK::InteriorPoint;
     //SimTK::OptimizerAlgorithm algorithm = SimTK::CFSQP;
 
     // Optimizer
-    SimTK::Optimizer *optimizer = new SimTK::Optimizer(target, algorithm);
-
-    // Optimizer options
-    //cout<<"\nSetting optimizer print level to "<<_printLevel<<".\n";
-    optimizer->setDiagnosticsLevel(_printLevel);
-    //cout<<"Setting optimizer convergence criterion to "<<_convergenceCriterion<<".\n";
-    optimizer->setConvergenceTolerance(_convergenceCriterion);
-    //cout<<"Setting optimizer maximum iterations to "<<_maximumIterations<<".\n";
-    optimizer->setMaxIterations(_maximumIterations);
-    optimizer->useNumericalGradient(false);
-    optimizer->useNumericalJacobian(false);
-    if(algorithm == SimTK::InteriorPoint) {
-        // Some IPOPT-specific settings
-        optimizer->setLimitedMemoryHistory(500); // works well for our small systems
-        optimizer->setAdvancedBoolOption("warm_start",true);
-        optimizer->setAdvancedRealOption("obj_scaling_factor",1);
-        optimizer->setAdvancedRealOption("nlp_scaling_max_gradient",1);
+    // Reusing the optimizer across frames lets IPOPT warm start each frame
+    // from the solution (including the multipliers) of the previous frame.
+    if(!_optimizer) {
+        _optimizer.reset(new SimTK::Optimizer(target, algorithm));
+
+        // Optimizer options
+        //cout<<"\nSetting optimizer print level to "<<_printLevel<<".\n";
+        _optimizer->setDiagnosticsLevel(_printLevel);
+        //cout<<"Setting optimizer convergence criterion to "<<_convergenceCriterion<<".\n";
+        _optimizer->setConvergenceTolerance(_convergenceCriterion);
+        //cout<<"Setting optimizer maximum iterations to "<<_maximumIterations<<".\n";
+        _optimizer->setMaxIterations(_maximumIterations);
+        _optimizer->useNumericalGradient(false);
+        _optimizer->useNumericalJacobian(false);
+        if(algorithm == SimTK::InteriorPoint) {
+            // Some IPOPT-specific settings
+            _optimizer->setLimitedMemoryHistory(500); // works well for our small systems
+            _optimizer->setAdvancedBoolOption("warm_start",true);
+            _optimizer->setAdvancedRealOption("obj_scaling_factor",1);
+            _optimizer->setAdvancedRealOption("nlp_scaling_max_gradient",1);
+        }
     }
 
     // Parameter bounds
@@ -376,7 +399,8 @@ record(const SimTK::State& s)
     
     target.setParameterLimits(lowerBounds, upperBounds);
 
-    _parameters = 0; // Set initial guess to zeros
+    // The initial guess is the solution of the previous frame (zeros for the
+    // first frame).
 
     // Static optimization
     _modelWorkingCopy->getMultibodySystem().realize(sWorkingCopy,SimTK::Stage::Velocity);
@@ -389,11 +413,16 @@ record(const SimTK::State& s)
     //QueryPerformanceFrequency(&frequency);
     //QueryPerformanceCounter(&start);
 
+    bool failed = false;
     try {
         target.setCurrentState( &sWorkingCopy );
-        optimizer->optimize(_parameters);
+        if(!(_useActiveSetSolver && _activationExponent == 2 &&
+                target.solveQuadraticProgram(_parameters))) {
+            _optimizer->optimize(_parameters);
+        }
     }
     catch (const SimTK::Exception::Base& ex) {
+        failed = true;
         log_warn(ex.getMessage());
         log_warn("OPTIMIZATION FAILED...");
         log_warn("StaticOptimization.record: The optimizer could not find a "
@@ -495,6 +524,12 @@ record(const SimTK::State& s)
 
     _forceReporter->step(sWorkingCopy, 1);
 
+    // Do not warm start the next frame from a failed solution.
+    if(failed) {
+        _optimizer.reset();
+        _parameters = 0;
+    }
+
     return 0;
 }
 //_____________________________________________________________________________
@@ -512,6 +547,10 @@ int StaticOptimization::begin(const SimTK::State& s )
 {
     if(!proceed()) return(0);
 
+    // The target and optimizer refer to the previous working copy.
+    _optimizer.reset();
+    _target.reset();
+
     // Make a working copy of the model
     delete _modelWorkingCopy;
     _modelWorkingCopy = _model->clone();
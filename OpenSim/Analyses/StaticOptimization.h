@@ -33,6 +33,10 @@
 #include <OpenSim/Common/GCVSplineSet.h>
 #include "ForceReporter.h"
 
+namespace SimTK {
+class Optimizer;
+}
+
 //=============================================================================
 //=============================================================================
 /**
@@ -41,6 +45,7 @@ namespace OpenSim {
 
 class Model;
 class ForceSet;
+class StaticOptimizationTarget;
 
 /**
  * This class implements static optimization to compute Muscle Forces and 
@@ -59,6 +64,12 @@ private:
 
     std::unique_ptr<ForceReporter> _forceReporter;
 
+    /** The optimization target and the optimizer are created in the first
+    frame and reused for the remaining frames of the analysis, so that each
+    frame is warm started from the solution of the previous one. */
+    std::unique_ptr<StaticOptimizationTarget> _target;
+    std::unique_ptr<SimTK::Optimizer> _optimizer;
+
 protected:
     /** Use force set from model. */
     PropertyBool _useModelForceSetProp;
@@ -76,6 +87,9 @@ protected:
     PropertyInt _maximumIterationsProp;
     int &_maximumIterations;
 
+    PropertyBool _useActiveSetSolverProp;
+    bool &_useActiveSetSolver;
+
     Storage *_activationStorage;
     Storage *_forceStorage;
     GCVSplineSet _statesSplineSet;
@@ -135,6 +149,11 @@ public:
     double getConvergenceCriterion() { return _convergenceCriterion; }
     void setMaxIterations( const int maxIt) { _maximumIterations = maxIt; }
     int getMaxIterations() {return _maximumIterations; }
+    /** If true and the activation exponent is 2, solve the quadratic program
+    of each frame directly with an active-set method, and use the optimizer
+    only for the frames in which that fails. */
+    void setUseActiveSetSolver(const bool useIt) { _useActiveSetSolver = useIt; }
+    bool getUseActiveSetSolver() const { return _useActiveSetSolver; }
     //--------------------------------------------------------------------------
     // ANALYSIS
     //--------------------------------------------------------------------------
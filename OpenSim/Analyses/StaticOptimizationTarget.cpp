@@ -30,8 +30,12 @@
 // INCLUDES
 //=============================================================================
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Actuators/CoordinateActuator.h>
 #include "StaticOptimizationTarget.h"
 
+#include <algorithm>
+#include <vector>
+
 using namespace OpenSim;
 using namespace std;
 using SimTK::Vector;
@@ -127,17 +131,146 @@ prepareToOptimize(SimTK::State& s, double *x)
     pVector = 0;
     computeConstraintVector(s, pVector,_constraintVector);
 
-    for(int p=0; p<np; p++) {
-        pVector[p] = 1;
-        computeConstraintVector(s, pVector, cVector);
-        for(int c=0; c<nc; c++) _constraintMatrix(c,p) = (cVector[c] - _constraintVector[c]);
-        pVector[p] = 0;
+    // The accelerations are linear in the actuator forces, so the column of
+    // an actuator is the change in the accelerations caused by its optimal
+    // force. For muscles, path actuators, and coordinate actuators, the
+    // generalized forces applied by the actuator are known, and the change
+    // in the accelerations is computed directly from them, without realizing
+    // the whole model again. Other actuators are perturbed.
+    const SimTK::SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
+    SimTK::Vector_<SimTK::SpatialVec> bodyForces(matter.getNumBodies());
+    SimTK::Vector mobilityForces(s.getNU());
+    SimTK::Vector_<SimTK::SpatialVec> A_GB;
+    Vector udot0, udot;
+    bodyForces = SimTK::SpatialVec(SimTK::Vec3(0), SimTK::Vec3(0));
+    mobilityForces = 0;
+    matter.calcAcceleration(s, mobilityForces, bodyForces, udot0, A_GB);
+
+    const ForceSet& fSet = _model->getForceSet();
+    for(int i=0, p=0; i<fSet.getSize(); i++) {
+        const ScalarActuator* act =
+                dynamic_cast<const ScalarActuator*>(&fSet.get(i));
+        if(!act) continue;
+        // Only actuators whose force is the overridden actuation along their
+        // path (or coordinate) can be handled directly.
+        const PathActuator* pathAct = dynamic_cast<const Muscle*>(act) ||
+                act->getConcreteClassName() == "PathActuator" ?
+                        dynamic_cast<const PathActuator*>(act) : nullptr;
+        const CoordinateActuator* coordAct =
+                dynamic_cast<const CoordinateActuator*>(act);
+        const Coordinate* coord = coordAct ? coordAct->getCoordinate() : nullptr;
+        if(pathAct || coord) {
+            bodyForces = SimTK::SpatialVec(SimTK::Vec3(0), SimTK::Vec3(0));
+            mobilityForces = 0;
+            if(pathAct) {
+                pathAct->getGeometryPath().addInEquivalentForces(s,
+                        _optimalForce[p], bodyForces, mobilityForces);
+            } else {
+                matter.addInMobilityForce(s,
+                        SimTK::MobilizedBodyIndex(coord->getBodyIndex()),
+                        SimTK::MobilizerUIndex(coord->getMobilizerQIndex()),
+                        _optimalForce[p], mobilityForces);
+            }
+            matter.calcAcceleration(s, mobilityForces, bodyForces, udot, A_GB);
+            for(int c=0; c<nc; c++) {
+                const int u = _accelerationIndices[c];
+                _constraintMatrix(c,p) = udot0[u] - udot[u];
+            }
+        } else {
+            pVector[p] = 1;
+            computeConstraintVector(s, pVector, cVector);
+            for(int c=0; c<nc; c++) _constraintMatrix(c,p) = (cVector[c] - _constraintVector[c]);
+            pVector[p] = 0;
+        }
+        p++;
     }
 #endif
 
     // return false to indicate that we still need to proceed with optimization
     return false;
 }
+//______________________________________________________________________________
+/**
+ * Solve the quadratic program min sum(x^2) s.t. A*x + b = 0, lower <= x <=
+ * upper, where A and b are the linear constraint matrix and vector. With the
+ * parameters at their limits fixed, the remaining (free) parameters of
+ * minimum norm are x_F = ~A_F*y, with (A_F*~A_F)*y = -b - A_X*x_X. Free
+ * parameters that violate their limits are fixed at them, and fixed
+ * parameters whose multipliers have the wrong sign are freed, until neither
+ * happens.
+ */
+bool StaticOptimizationTarget::
+solveQuadraticProgram(Vector& parameters) const
+{
+#ifndef USE_LINEAR_CONSTRAINT_MATRIX
+    return false;
+#else
+    const int np = getNumParameters();
+    const int nc = getNumConstraints();
+    double *lower, *upper;
+    getParameterLimits(&lower, &upper);
+    if(!lower || !upper) return false;
+
+    // 0: free, -1: at lower limit, 1: at upper limit.
+    std::vector<int> active(np, 0);
+    Vector x(np), y(nc), z(np), r(nc);
+    Matrix AAT(nc,nc);
+    const double tol = 1e-10;
+    const int maxIterations = 2*np + 10;
+    for(int iter=0; iter<maxIterations; iter++) {
+        r = -_constraintVector;
+        AAT = 0;
+        for(int p=0; p<np; p++) {
+            const Vector col = _constraintMatrix(p);
+            if(active[p] == 0) {
+                for(int j=0; j<nc; j++)
+                    for(int k=0; k<nc; k++) AAT(j,k) += col[j]*col[k];
+            } else {
+                x[p] = active[p] < 0 ? lower[p] : upper[p];
+                r -= col * x[p];
+            }
+        }
+        SimTK::FactorQTZ factor(AAT);
+        factor.solve(r, y);
+        z = ~_constraintMatrix * y;
+
+        // Fix free parameters that violate their limits.
+        bool changed = false;
+        for(int p=0; p<np; p++) {
+            if(active[p] != 0) continue;
+            x[p] = z[p];
+            if(x[p] < lower[p] - tol) { active[p] = -1; changed = true; }
+            else if(x[p] > upper[p] + tol) { active[p] = 1; changed = true; }
+        }
+        if(changed) continue;
+
+        // Free the fixed parameter whose multiplier, 2*(x - z), has the
+        // largest wrong sign.
+        int release = -1;
+        double worst = tol;
+        for(int p=0; p<np; p++) {
+            const double violation = active[p] * (x[p] - z[p]);
+            if(active[p] != 0 && violation > worst) {
+                worst = violation;
+                release = p;
+            }
+        }
+        if(release >= 0) {
+            active[release] = 0;
+            continue;
+        }
+
+        // The constraints may not be satisfiable (e.g., by a weak model); let
+        // the optimizer handle (and diagnose) that case.
+        const Vector residual = _constraintMatrix * x + _constraintVector;
+        const double scale = std::max(1.0, _constraintVector.normInf());
+        if(residual.normInf() > 1e-8 * scale) return false;
+        parameters = x;
+        return true;
+    }
+    return false;
+#endif
+}
 //==============================================================================
 // SET AND GET
 //==============================================================================
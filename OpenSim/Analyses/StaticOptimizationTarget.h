@@ -113,6 +113,16 @@ public:
 
     bool prepareToOptimize(SimTK::State& s, double *x);
 
+    /** For an activation exponent of 2, the problem is a quadratic program
+     * (minimize the sum of squared parameters subject to the linear
+     * acceleration constraints and the parameter limits), which is solved
+     * here with an active-set method instead of the optimizer. Call after
+     * prepareToOptimize(). The parameters are changed only if a solution
+     * satisfying the constraints and the limits is found.
+     *
+     * @return true if a solution was found. */
+    bool solveQuadraticProgram(SimTK::Vector& parameters) const;
+
     //--------------------------------------------------------------------------
     // REQUIRED OPTIMIZATION TARGET METHODS
     //--------------------------------------------------------------------------
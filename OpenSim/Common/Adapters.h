@@ -25,7 +25,9 @@
 #include "TRCFileAdapter.h"
 #include "DelimFileAdapter.h"
 #include "STOFileAdapter.h"
+#include "STOFileStream.h"
 #include "CSVFileAdapter.h"
+#include "TSBFileAdapter.h"
 
 #if defined (WITH_EZC3D) || defined (WITH_BTK)
 
@@ -26,11 +26,15 @@
 #include "PiecewiseLinearFunction.h"
 #include "STOFileAdapter.h"
 #include "TimeSeriesTable.h"
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <ctime>
+#include <exception>
 #include <iomanip>
 #include <memory>
 #include <sstream>
+#include <thread>
 
 #include <SimTKcommon/internal/Pathname.h>
 
@@ -183,3 +187,52 @@ SimTK::Real OpenSim::solveBisection(
     }
     return midpoint;
 }
+
+int OpenSim::getNumThreadsToUse(int numThreads) {
+    if (numThreads > 0) return numThreads;
+    const int numHardwareThreads = (int)std::thread::hardware_concurrency();
+    return numHardwareThreads > 0 ? numHardwareThreads : 1;
+}
+
+void OpenSim::executeInParallel(int numTasks, int numThreads,
+        const std::function<void(int, int)>& task) {
+    OPENSIM_THROW_IF(numTasks < 0, Exception,
+            "Expected numTasks to be non-negative, but got {}.", numTasks);
+    OPENSIM_THROW_IF(numThreads < 0, Exception,
+            "Expected numThreads to be non-negative, but got {}.", numThreads);
+
+    numThreads = std::min(getNumThreadsToUse(numThreads), numTasks);
+    if (numThreads <= 1) {
+        for (int itask = 0; itask < numTasks; ++itask) task(itask, 0);
+        return;
+    }
+
+    std::atomic<int> nextTask(0);
+    std::atomic<bool> failed(false);
+    std::exception_ptr firstException;
+    std::mutex exceptionMutex;
+    auto work = [&](int threadIndex) {
+        while (!failed) {
+            const int itask = nextTask++;
+            if (itask >= numTasks) break;
+            try {
+                task(itask, threadIndex);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(exceptionMutex);
+                if (!firstException) firstException = std::current_exception();
+                failed = true;
+            }
+        }
+    };
+
+    // The calling thread does its share of the work as thread 0.
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (int ithread = 1; ithread < numThreads; ++ithread) {
+        threads.emplace_back(work, ithread);
+    }
+    work(0);
+    for (auto& thread : threads) thread.join();
+
+    if (firstException) std::rethrow_exception(firstException);
+}
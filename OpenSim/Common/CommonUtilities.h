@@ -124,6 +124,32 @@ SimTK::Real solveBisection(std::function<double(const double&)> calcResidual,
         double left, double right, const double& tolerance = 1e-6,
         int maxIterations = 1000);
 
+/// Obtain the number of threads to use for a parallel computation. If
+/// `numThreads` is less than 1, this returns the number of concurrent threads
+/// supported by the hardware (or 1 if that number is unknown); otherwise,
+/// `numThreads` is returned unchanged.
+/// @ingroup commonutil
+OSIMCOMMON_API int getNumThreadsToUse(int numThreads);
+
+#ifndef SWIG
+/// Invoke `task(taskIndex, threadIndex)` for every taskIndex in
+/// [0, numTasks), using `numThreads` threads (including the calling thread).
+/// Tasks are handed out to threads one at a time, in increasing order of
+/// taskIndex, as threads become available. The threadIndex argument is in
+/// [0, numThreads) and identifies the thread running the task, so that
+/// callers can give each thread its own copy of objects that are not
+/// threadsafe (e.g., a Model and its SimTK::State). If numThreads is 1 (or
+/// there is at most one task), the tasks are run in series on the calling
+/// thread.
+/// If a task throws an exception, no new tasks are started, and the first
+/// exception is rethrown on the calling thread once all threads have
+/// finished.
+/// @throws Exception if numTasks or numThreads is negative.
+/// @ingroup commonutil
+OSIMCOMMON_API void executeInParallel(int numTasks, int numThreads,
+        const std::function<void(int taskIndex, int threadIndex)>& task);
+#endif
+
 /// This class lets you store objects of a single type for reuse by multiple
 /// threads, ensuring threadsafe access to each of those objects.
 /// @ingroup commonutil
@@ -27,6 +27,7 @@
 #include "OpenSim/Common/IO.h"
 #include "XMLDocument.h"
 #include <unordered_map>
+#include <mutex>
 #include <set>
 #include <regex>
 
@@ -108,6 +109,18 @@ private:
 };
 
 
+//==============================================================================
+//                           RESOLVED PATH CACHE
+//==============================================================================
+// Held by a root component. The version is incremented whenever a component
+// is added to or removed from a list of subcomponents anywhere in the tree
+// under the root, so that lookups in progress can detect that they are stale.
+struct Component::ResolvedPathCache {
+    std::mutex mutex;
+    unsigned long long version{0};
+    std::unordered_map<std::string, const Component*> components;
+};
+
 //==============================================================================
 //                              COMPONENT
 //==============================================================================
@@ -271,6 +284,7 @@ void Component::finalizeFromProperties()
     // End of duplicate finding and renaming.
 
     extendFinalizeFromProperties();
+    buildSubcomponentIndex();
     setObjectIsUpToDateWithProperties();
 }
 
@@ -973,6 +987,67 @@ void Component::
     }
 }
 
+Component::StateVariableHandle Component::
+    getStateVariableHandle(const std::string& name) const
+{
+    // Must have already called initSystem.
+    OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
+
+    const StateVariable* rsv = traverseToStateVariable(name);
+    OPENSIM_THROW_IF_FRMOBJ(!rsv, Exception,
+            "State variable '{}' not found.", name);
+    return StateVariableHandle(*rsv, getSystem());
+}
+
+std::vector<Component::StateVariableHandle> Component::
+    getStateVariableHandles(const std::vector<std::string>& names) const
+{
+    std::vector<StateVariableHandle> handles;
+    handles.reserve(names.size());
+    for (const auto& name : names)
+        handles.push_back(getStateVariableHandle(name));
+    return handles;
+}
+
+void Component::
+    getStateVariableValues(const SimTK::State& state,
+                           const std::vector<StateVariableHandle>& handles,
+                           SimTK::Vector& values) const
+{
+    // Must have already called initSystem.
+    OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
+
+    const int n = (int)handles.size();
+    if (values.size() != n) values.resize(n);
+    const SimTK::System& system = getSystem();
+    for (int i = 0; i < n; ++i) {
+        OPENSIM_THROW_IF_FRMOBJ(!handles[i].isSameSystem(system), Exception,
+                "State variable handle {} is invalid or was obtained for a "
+                "different System.", i);
+        values[i] = handles[i].getValue(state);
+    }
+}
+
+void Component::
+    setStateVariableValues(SimTK::State& state,
+                           const std::vector<StateVariableHandle>& handles,
+                           const SimTK::Vector& values) const
+{
+    // Must have already called initSystem.
+    OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
+
+    const int n = (int)handles.size();
+    OPENSIM_THROW_IF_FRMOBJ(values.size() != n, Exception,
+            "Expected {} values, but got {}.", n, values.size());
+    const SimTK::System& system = getSystem();
+    for (int i = 0; i < n; ++i) {
+        OPENSIM_THROW_IF_FRMOBJ(!handles[i].isSameSystem(system), Exception,
+                "State variable handle {} is invalid or was obtained for a "
+                "different System.", i);
+        handles[i].setValue(state, values[i]);
+    }
+}
+
 // Set the derivative of a state variable computed by this Component by name.
 void Component::
     setStateVariableDerivativeValue(const State& state, 
@@ -1195,6 +1270,7 @@ void Component::markPropertiesAsSubcomponents()
     // or the properties have been modified. In the latter case
     // we must make sure that pointers to old properties are cleared
     _propertySubcomponents.clear();
+    clearSubcomponentIndex();
 
     // Now mark properties that are Components as subcomponents
     //loop over all its properties
@@ -1250,6 +1326,7 @@ void Component::markAsPropertySubcomponent(const Component* component)
         // otherwise it will copy and reset the Component pointer to null.
         _propertySubcomponents.push_back(
             SimTK::ReferencePtr<Component>(const_cast<Component*>(component)));
+        clearSubcomponentIndex();
     }
     else{
         auto compPath = component->getAbsolutePathString();
@@ -1284,6 +1361,7 @@ void Component::adoptSubcomponent(Component* subcomponent)
 
     subcomponent->setOwner(*this);
     _adoptedSubcomponents.push_back(SimTK::ClonePtr<Component>(subcomponent));
+    clearSubcomponentIndex();
 }
 
 std::vector<SimTK::ReferencePtr<const Component>> 
@@ -1824,9 +1902,139 @@ void Component::reset()
 
     _propertySubcomponents.clear();
     _adoptedSubcomponents.clear();
+    clearSubcomponentIndex();
     resetSubcomponentOrder();
 }
 
+void Component::buildSubcomponentIndex()
+{
+    _subcomponentsByName.clear();
+    // If names are repeated, the first match in the order of
+    // getImmediateSubcomponents() is used, as when scanning the lists.
+    for (auto& comp : _memberSubcomponents)
+        _subcomponentsByName.emplace(comp->getName(), comp.get());
+    for (auto& comp : _propertySubcomponents)
+        _subcomponentsByName.emplace(comp->getName(), comp.get());
+    for (auto& comp : _adoptedSubcomponents)
+        _subcomponentsByName.emplace(comp->getName(), comp.get());
+
+    if (!hasOwner()) {
+        // The cache is only ever created here (and not by const methods), so
+        // that lookups remain safe to perform from multiple threads.
+        _resolvedPathCache = std::make_shared<ResolvedPathCache>();
+    }
+}
+
+void Component::clearSubcomponentIndex()
+{
+    _subcomponentsByName.clear();
+
+    // Paths resolved from the root of this tree may refer to components that
+    // were just removed from it.
+    const Component* root = this;
+    while (root->hasOwner()) root = &root->getOwner();
+    if (ResolvedPathCache* cache = root->_resolvedPathCache.get()) {
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        ++cache->version;
+        cache->components.clear();
+    }
+}
+
+const Component* Component::findImmediateSubcomponent(
+        const std::string& name) const
+{
+    // Subcomponents may have been renamed since the index was built, so an
+    // entry is only used if its name still matches.
+    const auto it = _subcomponentsByName.find(name);
+    if (it != _subcomponentsByName.end() && it->second->getName() == name)
+        return it->second;
+
+    for (auto& comp : _memberSubcomponents)
+        if (comp->getName() == name) return comp.get();
+    for (auto& comp : _propertySubcomponents)
+        if (comp->getName() == name) return comp.get();
+    for (auto& comp : _adoptedSubcomponents)
+        if (comp->getName() == name) return comp.get();
+    return nullptr;
+}
+
+namespace {
+// Check that the names of `comp` and its owners match the elements of the
+// (trimmed) absolute path `path`, and that the path starts at `root`.
+bool isComponentAtAbsolutePath(const Component* comp, const std::string& path,
+        const Component& root) {
+    size_t end = path.size();
+    while (end > 0) {
+        const size_t sep = path.rfind('/', end - 1);
+        if (sep == std::string::npos || comp == &root || !comp->hasOwner())
+            return false;
+        const std::string& name = comp->getName();
+        const size_t length = end - sep - 1;
+        if (length != name.size() || path.compare(sep + 1, length, name) != 0)
+            return false;
+        comp = &comp->getOwner();
+        end = sep;
+    }
+    return comp == &root;
+}
+}
+
+const Component* Component::resolveComponentPath(ComponentPath path) const
+{
+    // Get rid of all the ".."'s that are not at the front of the path.
+    path.trimDotAndDotDotElements();
+
+    // Move up either to the root component or just enough to resolve all
+    // the ".."'s.
+    size_t iPathEltStart = 0u;
+    const Component* current = this;
+    ResolvedPathCache* cache = nullptr;
+    unsigned long long version = 0;
+    std::string key;
+    if (path.isAbsolute()) {
+        current = &current->getRoot();
+        if (path.getNumPathLevels() > 0)
+            cache = current->_resolvedPathCache.get();
+        if (cache) {
+            key = path.toString();
+            if (key.back() == '/') key.pop_back();
+            const Component* found = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(cache->mutex);
+                version = cache->version;
+                const auto it = cache->components.find(key);
+                if (it != cache->components.end()) found = it->second;
+            }
+            // Components may have been renamed since the entry was cached.
+            if (found && isComponentAtAbsolutePath(found, key, *current))
+                return found;
+        }
+    } else {
+        while (iPathEltStart < path.getNumPathLevels() &&
+                path.getSubcomponentNameAtLevel(iPathEltStart) == "..") {
+            // The path sends us up farther than the root.
+            if (!current->hasOwner()) return nullptr;
+            current = &current->getOwner();
+            ++iPathEltStart;
+        }
+    }
+
+    for (size_t i = iPathEltStart; i < path.getNumPathLevels(); ++i) {
+        // At this depth in the tree, is there a component whose name
+        // matches the corresponding path element?
+        current = current->findImmediateSubcomponent(
+                path.getSubcomponentNameAtLevel(i));
+        if (!current) return nullptr;
+    }
+
+    if (cache) {
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        // Do not cache the result if the tree changed during the lookup.
+        if (cache->version == version) cache->components[key] = current;
+    }
+    return current;
+}
+
 void Component::warnBeforePrint() const {
     if (!isObjectUpToDateWithProperties()) return;
     std::string message;
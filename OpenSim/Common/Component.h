@@ -1338,6 +1338,57 @@ public:
     void setStateVariableValues(SimTK::State& state,
                                 const SimTK::Vector& values) const;
 
+#ifndef SWIG // StateVariable is protected.
+    class StateVariableHandle;
+
+    /**
+     * Look up a state variable (anywhere in the Component tree, as with
+     * getStateVariableValue()) once, and obtain a handle that gives direct
+     * access to its value. Use handles instead of names to access the same
+     * state variables repeatedly (e.g., at every time step or every row of a
+     * table); no names are looked up when using a handle. A handle remains
+     * valid until the System is re-created (e.g., by Model::initSystem()).
+     *
+     * @param name    the path (or name) of the state variable of interest
+     * @throws ComponentHasNoSystem if this Component has not been added to a
+     *         System (i.e., if initSystem has not been called)
+     * @throws Exception if there is no state variable with the given path
+     */
+    StateVariableHandle getStateVariableHandle(const std::string& name) const;
+
+    /**
+     * Obtain handles for the state variables with the given paths, in the
+     * same order.
+     * @see getStateVariableHandle()
+     */
+    std::vector<StateVariableHandle> getStateVariableHandles(
+            const std::vector<std::string>& names) const;
+
+    /**
+     * Gather the values of the state variables referred to by `handles` into
+     * `values`, which is resized to the number of handles if necessary.
+     *
+     * @throws Exception if a handle is invalid or was obtained for a
+     *         different System
+     */
+    void getStateVariableValues(const SimTK::State& state,
+            const std::vector<StateVariableHandle>& handles,
+            SimTK::Vector& values) const;
+
+    /**
+     * Scatter `values` to the state variables referred to by `handles`. As
+     * with setStateVariableValues(SimTK::State&, const SimTK::Vector&), this
+     * only sets the values on the State.
+     *
+     * @throws Exception if a handle is invalid or was obtained for a
+     *         different System, or if the sizes of `handles` and `values`
+     *         differ
+     */
+    void setStateVariableValues(SimTK::State& state,
+            const std::vector<StateVariableHandle>& handles,
+            const SimTK::Vector& values) const;
+#endif
+
     /**
      * Get the value of a state variable derivative computed by this Component.
      *
@@ -1954,6 +2005,7 @@ protected:
         component->setName(name);
         component->setOwner(*this);
         _memberSubcomponents.push_back(SimTK::ClonePtr<Component>(component));
+        clearSubcomponentIndex();
         return MemberSubcomponentIndex(_memberSubcomponents.size()-1);
     }
     template<class C = Component>
@@ -2562,43 +2614,8 @@ protected:
     template<class C>
     const C* traversePathToComponent(ComponentPath path) const
     {
-        // Get rid of all the ".."'s that are not at the front of the path.
-        path.trimDotAndDotDotElements();
-
-        // Move up either to the root component or just enough to resolve all
-        // the ".."'s.
-        size_t iPathEltStart = 0u;
-        const Component* current = this;
-        if (path.isAbsolute()) {
-            current = &current->getRoot();
-        } else {
-            while (iPathEltStart < path.getNumPathLevels() &&
-                    path.getSubcomponentNameAtLevel(iPathEltStart) == "..") {
-                // The path sends us up farther than the root.
-                if (!current->hasOwner()) return nullptr;
-                current = &current->getOwner();
-                ++iPathEltStart;
-            }
-        }
-
-        using RefComp = SimTK::ReferencePtr<const Component>;
-
-        // Skip over the root component name.
-        for (size_t i = iPathEltStart; i < path.getNumPathLevels(); ++i) {
-            // At this depth in the tree, is there a component whose name
-            // matches the corresponding path element?
-            const auto& currentPathElement =
-                path.getSubcomponentNameAtLevel(i);
-            const auto& currentSubs = current->getImmediateSubcomponents();
-            const auto it = std::find_if(currentSubs.begin(), currentSubs.end(),
-                    [currentPathElement](const RefComp& sub)
-                    { return sub->getName() == currentPathElement; });
-            if (it != currentSubs.end())
-                current = it->get();
-            else
-                return nullptr;
-        }
-        if (const C* comp = dynamic_cast<const C*>(current))
+        if (const C* comp = dynamic_cast<const C*>(
+                    resolveComponentPath(std::move(path))))
             return comp;
         return nullptr;
     }
@@ -2907,6 +2924,19 @@ private:
     // Reset by clearing underlying system indices.
     void reset();
 
+    // Find the component at the given path (relative to this component, or
+    // absolute). Returns nullptr if there is no such component.
+    const Component* resolveComponentPath(ComponentPath path) const;
+    // Find the immediate subcomponent with the given name, using the name
+    // index if it is available. Returns nullptr if there is no such component.
+    const Component* findImmediateSubcomponent(const std::string& name) const;
+    // Rebuild the name index of the immediate subcomponents and, for the
+    // root component, the cache of resolved absolute paths.
+    void buildSubcomponentIndex();
+    // Clear the name index after the list of subcomponents changes, and
+    // invalidate all caches of resolved paths.
+    void clearSubcomponentIndex();
+
     void warnBeforePrint() const override;
 
 protected:
@@ -3051,6 +3081,18 @@ private:
     // Hold onto adopted components
     SimTK::Array_<SimTK::ClonePtr<Component> > _adoptedSubcomponents;
 
+    // Immediate subcomponents indexed by name, used to resolve paths without
+    // scanning the lists above. Built by finalizeFromProperties() and cleared
+    // whenever the lists change; an empty index means the lists are scanned.
+    SimTK::ResetOnCopy<std::unordered_map<std::string, const Component*>>
+        _subcomponentsByName;
+
+    // Components found at absolute paths, held by the root component. Entries
+    // are discarded whenever a component is added to or removed from the tree
+    // under the root.
+    struct ResolvedPathCache;
+    SimTK::ResetOnCopy<std::shared_ptr<ResolvedPathCache>> _resolvedPathCache;
+
     // A flat list of subcomponents (immediate and otherwise) under this
     // Component. This list must be populated prior to addToSystem(), and is
     // used strictly to specify the order in which addToSystem() is invoked
@@ -3212,6 +3254,56 @@ private:
 //==============================================================================
 };  // END of class Component
 //==============================================================================
+
+#ifndef SWIG
+/** A handle to a continuous state variable of a Component, obtained from
+Component::getStateVariableHandle(). The handle refers directly to the state
+variable, so accessing its value does not involve looking up its name. The
+handle is invalidated when the System of the Component is re-created. */
+class Component::StateVariableHandle {
+public:
+    /** A default-constructed handle does not refer to any state variable. */
+    StateVariableHandle() = default;
+
+    /** Does this handle refer to a state variable? */
+    bool isValid() const { return !_stateVariable.empty(); }
+
+    /** Was this handle obtained for the given System? */
+    bool isSameSystem(const SimTK::System& system) const {
+        return !_system.empty() && system.isSameSystem(*_system);
+    }
+
+    /** The name of the state variable, as known to its owner. */
+    const std::string& getName() const { return _stateVariable->getName(); }
+    /** The Component that owns the state variable. */
+    const Component& getOwner() const { return _stateVariable->getOwner(); }
+    /** The Subsystem in which the state variable is allocated. */
+    SimTK::SubsystemIndex getSubsystemIndex() const {
+        return _stateVariable->getSubsysIndex();
+    }
+    /** The index of the state variable within its Subsystem. */
+    int getVarIndex() const { return _stateVariable->getVarIndex(); }
+
+    double getValue(const SimTK::State& state) const {
+        return _stateVariable->getValue(state);
+    }
+    void setValue(SimTK::State& state, double value) const {
+        _stateVariable->setValue(state, value);
+    }
+    double getDerivative(const SimTK::State& state) const {
+        return _stateVariable->getDerivative(state);
+    }
+
+private:
+    friend class Component;
+    StateVariableHandle(const StateVariable& stateVariable,
+                        const SimTK::System& system) :
+            _stateVariable(&stateVariable), _system(&system) {}
+
+    SimTK::ReferencePtr<const StateVariable> _stateVariable;
+    SimTK::ReferencePtr<const SimTK::System> _system;
+};
+#endif
 //==============================================================================
 
 // Implement methods for ComponentListIterator
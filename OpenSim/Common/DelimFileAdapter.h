@@ -28,10 +28,15 @@
 #include "FileAdapter.h"
 #include "TimeSeriesTable.h"
 #include "OpenSim/Common/IO.h"
+#include "OpenSim/Common/CommonUtilities.h"
 
 #include <string>
 #include <fstream>
 #include <regex>
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <type_traits>
 
 namespace OpenSim {
 
@@ -135,6 +140,38 @@ protected:
                           const T& elem,
                           const unsigned& prec) const;
 
+    /** Read the header (all lines up to "endheader") and the line of column
+    labels from the stream. The key-value pairs of the header are stored in
+    `keyValuePairs` and the column labels, excluding the time column, in
+    `columnLabels`. `lineNum` is incremented for every line read.            */
+    void readHeader(std::istream& in_stream,
+                    const std::string& fileName,
+                    size_t& lineNum,
+                    ValueArrayDictionary& keyValuePairs,
+                    std::vector<std::string>& columnLabels) const;
+
+    /** Read the next row of data from the stream. Returns false if there are
+    no more rows.                                                             */
+    bool readRow(std::istream& in_stream,
+                 const std::string& fileName,
+                 size_t& lineNum,
+                 size_t numColumns,
+                 double& time,
+                 SimTK::RowVector_<T>& row) const;
+
+    /** Write the header, including the line of column labels, to the 
+    stream.                                                                   */
+    void writeHeader(std::ostream& out_stream,
+                     const ValueArrayDictionary& metaData,
+                     const std::vector<std::string>& columnLabels) const;
+
+    /** Write a row of data to the stream. RowType is a row (or row view) of
+    elements of type T.                                                       */
+    template<typename RowType>
+    void writeRow(std::ostream& out_stream,
+                  double time,
+                  const RowType& row) const;
+
 private:
     /** Following overloads implement dataTypeName().                         */
     static inline std::string dataTypeName_impl(double);
@@ -162,6 +199,34 @@ private:
     readElems_impl(const std::vector<std::string>& tokens,
                    SimTK::Vec<M>) const;
 
+    /** Parse all the data rows in `buffer`, which holds the contents of the
+    file following the line of column labels, in place (without creating a
+    string for each token). Large files are parsed in blocks of rows on
+    multiple threads. Returns false if any line is not in the expected form;
+    the caller then reads the rows with readRow(), which reports the error.  */
+    bool parseRows(const std::string& buffer,
+                   size_t numColumns,
+                   std::vector<double>& time,
+                   SimTK::Matrix_<T>& matrix) const;
+    /** Parse a single row, tokenized the same way as by getNextLine().      */
+    bool parseRow(const char* begin,
+                  const char* end,
+                  size_t numColumns,
+                  double& time,
+                  SimTK::RowVectorView_<T> row) const;
+    /** Parse an element of type T, split into components the same way as by
+    readElems().                                                             */
+    bool parseElem(const char* begin, const char* end, T& elem) const;
+
+    /** Following overloads construct an element from its components for
+    parseElem().                                                             */
+    static void makeElem(const double* comps, double& elem);
+    static void makeElem(const double* comps, SimTK::UnitVec3& elem);
+    static void makeElem(const double* comps, SimTK::Quaternion& elem);
+    static void makeElem(const double* comps, SimTK::SpatialVec& elem);
+    template<int M>
+    static void makeElem(const double* comps, SimTK::Vec<M>& elem);
+
     /** Following overloads implement writeElem().                            */
     inline void writeElem_impl(std::ostream& stream,
                                const double& elem,
@@ -320,12 +385,204 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
                      fileName);
 
     size_t line_num{};
+    ValueArrayDictionary keyValuePairs;
+    std::vector<std::string> column_labels{};
+    readHeader(in_stream, fileName, line_num, keyValuePairs, column_labels);
+
+    // Read the rest of the file into memory and parse it in place.
+    const std::string buffer = readToEnd(in_stream);
+
+    std::vector<double> timeVec;
+    int ncol = static_cast<int>(column_labels.size());
+    SimTK::Matrix_<T> matrix;
+    if (!parseRows(buffer, column_labels.size(), timeVec, matrix)) {
+        // Read the rows one at a time and fill up the time column container
+        // and the data container. This provides the line number of any error.
+        // Start with a reasonable initial capacity for tradeoff between a
+        // small file and larger files. 100 worked well for a 50 MB file with
+        // ~80000 lines.
+        std::istringstream data_stream{buffer};
+        int initCapacity = 100;
+        timeVec.clear();
+        timeVec.reserve(initCapacity);
+        matrix.resize(initCapacity, ncol);
+
+        // Initialize current row and capacity
+        int curCapacity = initCapacity;
+        int curRow = 0;
+
+        // Start looping through each line
+        double time;
+        SimTK::RowVector_<T> row_vector;
+        while (readRow(data_stream, fileName, line_num, column_labels.size(),
+                       time, row_vector)) {
+            // Double capacity if we reach the end of the containers.
+            // This is necessary until Simbody issue #401 is addressed.
+            if (curRow+1 > curCapacity) {
+                curCapacity *= 2;
+                timeVec.reserve(curCapacity);
+                matrix.resizeKeep(curCapacity, ncol);
+            }
+
+            timeVec.push_back(time);
+            matrix.updRow(curRow) = row_vector;
+            ++curRow;
+        }
+
+        // Resize the matrix down to the correct number of rows.
+        // This is necessary until Simbody issue #401 is addressed.
+        matrix.resizeKeep(curRow, ncol);
+    }
+
+    // Create the table and update other metadata from above
+    auto table = 
+        std::make_shared<TimeSeriesTable_<T>>(timeVec, matrix, column_labels);
+    table->updTableMetaData() = keyValuePairs;
+
+    OutputTables output_tables{};
+    output_tables.emplace(tableString(), table);
+
+    return output_tables;
+}
+
+template<typename T>
+bool
+DelimFileAdapter<T>::parseRows(const std::string& buffer,
+                               size_t numColumns,
+                               std::vector<double>& time,
+                               SimTK::Matrix_<T>& matrix) const {
+    // As in readRow(), reading stops at the first empty line.
+    const auto lines = splitLines(buffer.data(),
+                                  buffer.data() + buffer.size());
+
+    const int nrow = static_cast<int>(lines.size());
+    time.resize(nrow);
+    matrix.resize(nrow, static_cast<int>(numColumns));
+
+    // Parse blocks of rows concurrently; small files are parsed in a single
+    // block on this thread.
+    const int rowsPerBlock = 10000;
+    const int numBlocks = (nrow + rowsPerBlock - 1) / rowsPerBlock;
+    std::atomic<bool> success{true};
+    executeInParallel(numBlocks, getNumThreadsToUse(0),
+            [&](int iblock, int) {
+                const int first = iblock * rowsPerBlock;
+                const int last = std::min(nrow, first + rowsPerBlock);
+                for (int irow = first; irow < last && success; ++irow) {
+                    if (!parseRow(lines[irow].first, lines[irow].second,
+                                numColumns, time[irow], matrix.updRow(irow))) {
+                        success = false;
+                    }
+                }
+            });
+    return success;
+}
+
+template<typename T>
+bool
+DelimFileAdapter<T>::parseRow(const char* begin,
+                              const char* end,
+                              size_t numColumns,
+                              double& time,
+                              SimTK::RowVectorView_<T> row) const {
+    // As in tokenize(), there is a token before each delimiter, and a last
+    // token if any characters follow the last delimiter. Time is token 0.
+    size_t itok = 0;
+    const char* tokBegin = begin;
+    for (const char* p = begin; p <= end; ++p) {
+        const bool atDelim = p < end &&
+                _delimitersRead.find(*p) != std::string::npos;
+        if (atDelim || (p == end && p > tokBegin)) {
+            if (itok == 0) {
+                if (!parseDouble(tokBegin, p, time)) return false;
+            } else if (itok > numColumns ||
+                    !parseElem(tokBegin, p, row[static_cast<int>(itok - 1)])) {
+                return false;
+            }
+            ++itok;
+            tokBegin = p + 1;
+        }
+    }
+    return itok == numColumns + 1;
+}
+
+template<typename T>
+bool
+DelimFileAdapter<T>::parseElem(const char* begin,
+                               const char* end,
+                               T& elem) const {
+    // Elements consist only of doubles.
+    constexpr int numComps = sizeof(T) / sizeof(double);
+    double comps[numComps];
+    if (std::is_same<T, double>::value) {
+        // Doubles are not split into components.
+        if (!parseDouble(begin, end, comps[0])) return false;
+    } else {
+        int icomp = 0;
+        const char* compBegin = begin;
+        for (const char* p = begin; p <= end; ++p) {
+            const bool atDelim = p < end &&
+                    _compDelimRead.find(*p) != std::string::npos;
+            if (atDelim || (p == end && p > compBegin)) {
+                if (icomp == numComps ||
+                        !parseDouble(compBegin, p, comps[icomp])) {
+                    return false;
+                }
+                ++icomp;
+                compBegin = p + 1;
+            }
+        }
+        if (icomp != numComps) return false;
+    }
+    makeElem(comps, elem);
+    return true;
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::makeElem(const double* comps, double& elem) {
+    elem = comps[0];
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::makeElem(const double* comps, SimTK::UnitVec3& elem) {
+    elem = SimTK::UnitVec3{comps[0], comps[1], comps[2]};
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::makeElem(const double* comps, SimTK::Quaternion& elem) {
+    elem = SimTK::Quaternion{comps[0], comps[1], comps[2], comps[3]};
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::makeElem(const double* comps, SimTK::SpatialVec& elem) {
+    elem = SimTK::SpatialVec{{comps[0], comps[1], comps[2]},
+                             {comps[3], comps[4], comps[5]}};
+}
+
+template<typename T>
+template<int M>
+void
+DelimFileAdapter<T>::makeElem(const double* comps, SimTK::Vec<M>& elem) {
+    for(int j = 0; j < M; ++j)
+        elem[j] = comps[j];
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::readHeader(std::istream& in_stream,
+                                const std::string& fileName,
+                                size_t& line_num,
+                                ValueArrayDictionary& keyValuePairs,
+                                std::vector<std::string>& column_labels) const {
     // All the lines until "endheader" is header.
     std::regex endheader{R"([ \t]*)" + _endHeaderString + R"([ \t]*)"};
     std::regex keyvalue{R"((.*)=(.*))"};
     std::string header{};
     std::string line{};
-    ValueArrayDictionary keyValuePairs;
     while(std::getline(in_stream, line)) {
         ++line_num;
 
@@ -374,19 +631,15 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
     }
     keyValuePairs.setValueForKey("header", header);
 
-    // Callable to get the next line in form of vector of tokens.
-    auto nextLine = [&] {
-        return getNextLine(in_stream, _delimitersRead);
-    };
-
     // Read the line containing column labels and fill up the column labels
     // container.
-    std::vector<std::string> column_labels{};
+    column_labels.clear();
     while (column_labels.size() == 0) { // keep going down rows to find labels
-        column_labels = nextLine();
+        column_labels = getNextLine(in_stream, _delimitersRead);
         // for labels we never expect empty elements, so remove them
         IO::eraseEmptyElements(column_labels);
         ++line_num;
+        if (!in_stream.good()) break;
     }
 
     OPENSIM_THROW_IF(column_labels.size() == 0, Exception,
@@ -400,66 +653,34 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
                      _timeColumnLabel,
                      column_labels[0]);
     column_labels.erase(column_labels.begin());
+}
 
-    // Read the rows one at a time and fill up the time column container and
-    // the data container. Start with a reasonable initial capacity for
-    // tradeoff between a small file and larger files. 100 worked well for
-    // a 50 MB file with ~80000 lines.
-    std::vector<double> timeVec;
-    int initCapacity = 100;
-    int ncol = static_cast<int>(column_labels.size());
-    timeVec.reserve(initCapacity);
-    SimTK::Matrix_<T> matrix(initCapacity, ncol);
-    
-    // Initialize current row and capacity
-    int curCapacity = initCapacity;
-    int curRow = 0;
-
-    // Start looping through each line
-    auto row = nextLine();
-    while (!row.empty()) {
-        ++line_num;
-        
-        // Double capacity if we reach the end of the containers.
-        // This is necessary until Simbody issue #401 is addressed.
-        if (curRow+1 > curCapacity) {
-            curCapacity *= 2;
-            timeVec.reserve(curCapacity);
-            matrix.resizeKeep(curCapacity, ncol);
-        }
-
-        // Time is column 0.
-        timeVec.push_back(std::stod(row.front()));
-        row.erase(row.begin());
-
-        auto row_vector = readElems(row);
-
-        OPENSIM_THROW_IF(row_vector.size() != (int)column_labels.size(),
-            RowLengthMismatch,
-            fileName,
-            line_num,
-            column_labels.size(),
-            static_cast<size_t>(row_vector.size()));
-        
-        matrix.updRow(curRow) = std::move(row_vector);
-
-        row = nextLine();
-        ++curRow;
-    }
-
-    // Resize the matrix down to the correct number of rows.
-    // This is necessary until Simbody issue #401 is addressed.
-    matrix.resizeKeep(curRow, ncol);
-
-    // Create the table and update other metadata from above
-    auto table = 
-        std::make_shared<TimeSeriesTable_<T>>(timeVec, matrix, column_labels);
-    table->updTableMetaData() = keyValuePairs;
-
-    OutputTables output_tables{};
-    output_tables.emplace(tableString(), table);
-
-    return output_tables;
+template<typename T>
+bool
+DelimFileAdapter<T>::readRow(std::istream& in_stream,
+                             const std::string& fileName,
+                             size_t& line_num,
+                             size_t numColumns,
+                             double& time,
+                             SimTK::RowVector_<T>& row_vector) const {
+    auto row = getNextLine(in_stream, _delimitersRead);
+    if (row.empty())
+        return false;
+    ++line_num;
+
+    // Time is column 0.
+    time = std::stod(row.front());
+    row.erase(row.begin());
+
+    row_vector = readElems(row);
+
+    OPENSIM_THROW_IF(row_vector.size() != (int)numColumns,
+        RowLengthMismatch,
+        fileName,
+        line_num,
+        numColumns,
+        static_cast<size_t>(row_vector.size()));
+    return true;
 }
 
 template<typename T>
@@ -581,22 +802,35 @@ DelimFileAdapter<T>::extendWrite(const InputTables& absTables,
 
     std::ofstream out_stream{fileName};
 
+    writeHeader(out_stream, table->getTableMetaData(),
+                table->getColumnLabels());
+
+    // Data rows.
+    for(unsigned row = 0; row < table->getNumRows(); ++row) {
+        writeRow(out_stream, table->getIndependentColumn()[row],
+                 table->getRowAtIndex(row));
+    }
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::writeHeader(std::ostream& out_stream,
+                           const ValueArrayDictionary& metaData,
+                           const std::vector<std::string>& columnLabels) const {
     // First line of the stream is the header.
-    if (table->getTableMetaData().hasKey("header")) {
-        out_stream << table->
-                      getTableMetaData().
-                      getValueForKey("header").
+    if (metaData.hasKey("header")) {
+        out_stream << metaData.getValueForKey("header").
                       template getValue<std::string>() << "\n";
     }
-    // Write rest of the key-value pairs and end the header.
-    for(const auto& key : table->getTableMetaDataKeys()) {
-        try {
-            if(key != "header")
-                out_stream << key << "=" 
-                           << table->
-                              template getTableMetaData<std::string>(key) 
-                           << "\n";
-        } catch(const InvalidTemplateArgument&) {}
+    // Write rest of the key-value pairs and end the header. Only values of
+    // type std::string are written.
+    for(const auto& key : metaData.getKeys()) {
+        if(key == "header")
+            continue;
+        const auto* value = dynamic_cast<const SimTK::Value<std::string>*>(
+                &metaData.getValueForKey(key));
+        if(value)
+            out_stream << key << "=" << value->get() << "\n";
     }
     // Write name of the data-type -- vec3, vec6, etc.
     out_stream << _dataTypeString << "=" << dataTypeName() << "\n";
@@ -607,27 +841,24 @@ DelimFileAdapter<T>::extendWrite(const InputTables& absTables,
 
     // Line containing column labels.
     out_stream << _timeColumnLabel;
-    for(unsigned col = 0; col < table->getNumColumns(); ++col)
-        out_stream << _delimiterWrite
-                   << table->
-                      getDependentsMetaData().
-                      getValueArrayForKey("labels")[col].
-                      template getValue<std::string>();
+    for(const auto& label : columnLabels)
+        out_stream << _delimiterWrite << label;
     out_stream << "\n";
+}
 
-    // Data rows.
-    for(unsigned row = 0; row < table->getNumRows(); ++row) {
-        constexpr auto prec = std::numeric_limits<double>::digits10 + 1;
-        out_stream << std::setprecision(prec)
-                   << table->getIndependentColumn()[row];
-        const auto& row_r = table->getRowAtIndex(row);
-        for(unsigned col = 0; col < table->getNumColumns(); ++col) {
-            const auto& elt = row_r[col];
-            out_stream << _delimiterWrite;
-            writeElem(out_stream, elt, prec);
-        }
-        out_stream << "\n";
+template<typename T>
+template<typename RowType>
+void
+DelimFileAdapter<T>::writeRow(std::ostream& out_stream,
+                              double time,
+                              const RowType& row) const {
+    constexpr auto prec = std::numeric_limits<double>::digits10 + 1;
+    out_stream << std::setprecision(prec) << time;
+    for(int col = 0; col < row.size(); ++col) {
+        out_stream << _delimiterWrite;
+        writeElem(out_stream, row[col], prec);
     }
+    out_stream << "\n";
 }
 
 template<typename T>
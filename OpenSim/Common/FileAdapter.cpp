@@ -2,6 +2,10 @@
 #include <OpenSim/Common/IO.h>
 #include "STOFileAdapter.h"
 
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
 namespace OpenSim {
 
 std::shared_ptr<DataAdapter>
@@ -90,4 +94,57 @@ FileAdapter::createAdapterFromExtension(const std::string& fileName) {
         dataAdapter = createAdapter(extension);
     return dataAdapter;
 }
+std::string
+FileAdapter::readToEnd(std::istream& stream) {
+    std::string buffer;
+    if (stream.good()) {
+        const auto start = stream.tellg();
+        stream.seekg(0, std::ios::end);
+        const auto numBytes = stream.tellg() - start;
+        stream.seekg(start);
+        buffer.resize(static_cast<size_t>(numBytes));
+        stream.read(&buffer[0], numBytes);
+        // Fewer characters may be read than there are bytes in the file if
+        // line endings are translated.
+        buffer.resize(static_cast<size_t>(stream.gcount()));
+    }
+    return buffer;
+}
+
+std::vector<std::pair<const char*, const char*>>
+FileAdapter::splitLines(const char* begin, const char* const bufferEnd) {
+    std::vector<std::pair<const char*, const char*>> lines;
+    while (begin < bufferEnd) {
+        const char* eol = static_cast<const char*>(
+                std::memchr(begin, '\n', bufferEnd - begin));
+        if (!eol) eol = bufferEnd;
+        const char* end = eol;
+        if (end > begin && *(end - 1) == '\r') --end;
+        if (end == begin) break;
+        lines.emplace_back(begin, end);
+        if (eol == bufferEnd) break;
+        begin = eol + 1;
+    }
+    return lines;
+}
+
+bool
+FileAdapter::parseDouble(const char* begin, const char* end, double& value) {
+    // Trim the same characters as IO::TrimWhitespace().
+    auto isWhitespace = [](char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    };
+    while (begin < end && isWhitespace(*begin)) ++begin;
+    while (end > begin && isWhitespace(*(end - 1))) --end;
+    if (begin == end) return false;
+
+    // std::stod() throws if nothing is converted or if the value is out of
+    // range. The number cannot extend past the token since it is followed by
+    // whitespace or a delimiter.
+    errno = 0;
+    char* parsedEnd = nullptr;
+    value = std::strtod(begin, &parsedEnd);
+    return parsedEnd != begin && parsedEnd <= end && errno != ERANGE;
+}
+
 } // namespace OpenSim
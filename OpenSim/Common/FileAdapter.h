@@ -28,6 +28,7 @@
 */
 #include "DataAdapter.h"
 
+#include <utility>
 #include <vector>
 
 namespace OpenSim {
@@ -217,6 +218,20 @@ public:
      This serves as a Factory of FileAdapters so clients don't need to know specific concrete 
      subclasses, as long as the generic base class read interface is used */
     static std::shared_ptr<DataAdapter> createAdapterFromExtension(const std::string& fileName);
+
+protected:
+    /** Read the rest of the stream into a string.                            */
+    static std::string readToEnd(std::istream& stream);
+    /** Split the characters [begin, end) of a file into lines the same way as
+    std::getline() (removing a trailing \r), stopping at the first empty
+    line. Each line is given by pointers to its first character and one past
+    its last.                                                                 */
+    static std::vector<std::pair<const char*, const char*>>
+    splitLines(const char* begin, const char* end);
+    /** Parse the characters [begin, end) the same way as std::stod() parses
+    the token trimmed by IO::TrimWhitespace(), without creating a string.
+    Returns false (instead of throwing) if std::stod() would throw.           */
+    static bool parseDouble(const char* begin, const char* end, double& value);
 };
 
 } // OpenSim namespace
@@ -0,0 +1,302 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  STOFileStream.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_STO_FILE_STREAM_H_
+#define OPENSIM_STO_FILE_STREAM_H_
+
+#include "STOFileAdapter.h"
+
+#include <iterator>
+
+namespace OpenSim {
+
+/** STOFileReader_ reads an STO (or MOT) file in blocks of rows rather than
+all at once, so that files larger than the available memory can be
+processed. The header and the column labels are read on construction; the
+data rows are read on demand, at most `blockSize` rows at a time. Each block is
+a TimeSeriesTable_ with the column labels and metadata of the file.
+\code
+STOFileReader reader("states.sto", 500);
+for (const auto& block : reader) {
+    // block contains (at most) 500 rows.
+}
+\endcode
+The reader can only be traversed once; the reference returned by the iterator
+is invalidated when the iterator is incremented.                             */
+template<typename T>
+class STOFileReader_ : private STOFileAdapter_<T> {
+public:
+    /** Input iterator over the blocks of rows of the file.                  */
+    class Iterator
+        : public std::iterator<std::input_iterator_tag, TimeSeriesTable_<T>> {
+    public:
+        explicit Iterator(STOFileReader_* reader = nullptr) :
+                _reader{reader} {}
+        const TimeSeriesTable_<T>& operator*() const {
+            return _reader->_block;
+        }
+        const TimeSeriesTable_<T>* operator->() const {
+            return &_reader->_block;
+        }
+        Iterator& operator++() {
+            if (!_reader->readNextBlock(_reader->_block)) _reader = nullptr;
+            return *this;
+        }
+        bool operator==(const Iterator& other) const {
+            return _reader == other._reader;
+        }
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+    private:
+        STOFileReader_* _reader;
+    };
+
+    /** Open the file and read its header.
+
+    \throws EmptyFileName If the file name is empty.
+    \throws FileDoesNotExist If the file cannot be opened.
+    \throws FileIsEmpty If the file is empty.                                */
+    STOFileReader_(const std::string& fileName, size_t blockSize = 1000);
+    STOFileReader_(const STOFileReader_&)            = delete;
+    STOFileReader_& operator=(const STOFileReader_&) = delete;
+    ~STOFileReader_()                                = default;
+
+    /** Column labels of the file, excluding the time column.               */
+    const std::vector<std::string>& getColumnLabels() const {
+        return _columnLabels;
+    }
+    /** Metadata read from the header of the file.                          */
+    const ValueArrayDictionary& getTableMetaData() const {
+        return _metaData;
+    }
+    /** Maximum number of rows in each block.                               */
+    size_t getBlockSize() const { return _blockSize; }
+
+    /** Read the next (at most) getBlockSize() rows of the file into `block`,
+    replacing its contents. Returns false, leaving `block` untouched, if there
+    are no more rows in the file.                                            */
+    bool readNextBlock(TimeSeriesTable_<T>& block);
+
+    /** Read the first block and return an iterator to it.                  */
+    Iterator begin() {
+        Iterator it{this};
+        return ++it;
+    }
+    Iterator end() { return Iterator{}; }
+
+private:
+    std::string _fileName;
+    size_t _blockSize;
+    std::ifstream _stream;
+    size_t _lineNum{};
+    ValueArrayDictionary _metaData;
+    std::vector<std::string> _columnLabels;
+    TimeSeriesTable_<T> _block;
+};
+
+/** STOFileWriter_ writes an STO file incrementally, row by row or a block of
+rows at a time, so that the full table never needs to be held in memory. The
+resulting file is identical to the one STOFileAdapter_::write() would produce
+for the concatenation of all the rows.
+
+This can be used to flush the contents of a TableReporter to disk
+periodically during a long simulation:
+\code
+STOFileWriter writer("report.sto");
+for (...) {
+    manager.integrate(time);
+    writer.appendTable(reporter->getTable());
+    reporter->clearTable();
+}
+writer.close();
+\endcode                                                                     */
+template<typename T>
+class STOFileWriter_ : private STOFileAdapter_<T> {
+public:
+    /** Open the file for writing. The header is written by the first call to
+    appendTable(), using the column labels and metadata of that table.
+
+    \throws EmptyFileName If the file name is empty.                         */
+    explicit STOFileWriter_(const std::string& fileName);
+    /** Open the file for writing and write the header immediately.         */
+    STOFileWriter_(const std::string& fileName,
+                   const std::vector<std::string>& columnLabels,
+                   const ValueArrayDictionary& metaData = {});
+    STOFileWriter_(const STOFileWriter_&)            = delete;
+    STOFileWriter_& operator=(const STOFileWriter_&) = delete;
+    /** Flushes and closes the file.                                         */
+    ~STOFileWriter_() { if (_stream.is_open()) _stream.close(); }
+
+    /** Write a single row. The header must already have been written.
+
+    \throws Exception If the header has not been written, if the row has the
+                      wrong number of columns, or if `time` is not greater
+                      than the time of the previous row.                     */
+    void appendRow(double time, const SimTK::RowVector_<T>& row);
+    /** Write all the rows of the table, writing the header first if this is
+    the first call. The column labels of the table must match those of the
+    file.                                                                    */
+    void appendTable(const TimeSeriesTable_<T>& table);
+
+    /** Number of rows written so far.                                       */
+    size_t getNumRowsWritten() const { return _numRowsWritten; }
+
+    /** Flush the rows written so far to disk.                               */
+    void flush() { _stream.flush(); }
+    /** Flush and close the file. No rows can be appended afterwards.        */
+    void close() { _stream.close(); }
+
+private:
+    void writeHeaderOnce(const std::vector<std::string>& columnLabels,
+                         const ValueArrayDictionary& metaData);
+    template<typename RowType>
+    void checkAndWriteRow(double time, const RowType& row);
+
+    std::string _fileName;
+    std::ofstream _stream;
+    std::vector<std::string> _columnLabels;
+    bool _headerWritten{false};
+    size_t _numRowsWritten{};
+    double _lastTime{SimTK::NaN};
+};
+
+template<typename T>
+STOFileReader_<T>::STOFileReader_(const std::string& fileName,
+                                  size_t blockSize) :
+        _fileName{fileName}, _blockSize{blockSize} {
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+    OPENSIM_THROW_IF(blockSize == 0, Exception,
+                     "Expected blockSize to be positive.");
+
+    _stream.open(fileName);
+    OPENSIM_THROW_IF(!_stream.good(),
+                     FileDoesNotExist,
+                     fileName);
+    OPENSIM_THROW_IF(_stream.peek() == std::ifstream::traits_type::eof(),
+                     FileIsEmpty,
+                     fileName);
+
+    this->readHeader(_stream, _fileName, _lineNum, _metaData, _columnLabels);
+}
+
+template<typename T>
+bool STOFileReader_<T>::readNextBlock(TimeSeriesTable_<T>& block) {
+    const int ncol = static_cast<int>(_columnLabels.size());
+    std::vector<double> timeVec;
+    timeVec.reserve(_blockSize);
+    SimTK::Matrix_<T> matrix(static_cast<int>(_blockSize), ncol);
+
+    double time;
+    SimTK::RowVector_<T> row;
+    int curRow = 0;
+    while (timeVec.size() < _blockSize &&
+            this->readRow(_stream, _fileName, _lineNum, _columnLabels.size(),
+                          time, row)) {
+        timeVec.push_back(time);
+        matrix.updRow(curRow) = row;
+        ++curRow;
+    }
+    if (curRow == 0) return false;
+
+    matrix.resizeKeep(curRow, ncol);
+    block = TimeSeriesTable_<T>(timeVec, matrix, _columnLabels);
+    block.updTableMetaData() = _metaData;
+    return true;
+}
+
+template<typename T>
+STOFileWriter_<T>::STOFileWriter_(const std::string& fileName) :
+        _fileName{fileName} {
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+    _stream.open(fileName);
+    OPENSIM_THROW_IF(!_stream.good(), Exception,
+                     "Could not open file '{}' for writing.", fileName);
+}
+
+template<typename T>
+STOFileWriter_<T>::STOFileWriter_(const std::string& fileName,
+                                  const std::vector<std::string>& columnLabels,
+                                  const ValueArrayDictionary& metaData) :
+        STOFileWriter_(fileName) {
+    writeHeaderOnce(columnLabels, metaData);
+}
+
+template<typename T>
+void STOFileWriter_<T>::writeHeaderOnce(
+        const std::vector<std::string>& columnLabels,
+        const ValueArrayDictionary& metaData) {
+    if (_headerWritten) return;
+    this->writeHeader(_stream, metaData, columnLabels);
+    _columnLabels = columnLabels;
+    _headerWritten = true;
+}
+
+template<typename T>
+template<typename RowType>
+void STOFileWriter_<T>::checkAndWriteRow(double time, const RowType& row) {
+    OPENSIM_THROW_IF(!_stream.is_open(), Exception,
+                     "File '{}' has already been closed.", _fileName);
+    OPENSIM_THROW_IF(row.size() != (int)_columnLabels.size(), Exception,
+                     "Expected row to have {} columns, but it has {}.",
+                     _columnLabels.size(), row.size());
+    OPENSIM_THROW_IF(_numRowsWritten > 0 && time <= _lastTime, Exception,
+                     "Expected time {} to be greater than the time of the "
+                     "previous row ({}).", time, _lastTime);
+    this->writeRow(_stream, time, row);
+    _lastTime = time;
+    ++_numRowsWritten;
+}
+
+template<typename T>
+void STOFileWriter_<T>::appendRow(double time,
+                                  const SimTK::RowVector_<T>& row) {
+    OPENSIM_THROW_IF(!_headerWritten, Exception,
+                     "The header of '{}' has not been written; use "
+                     "appendTable() or provide column labels on "
+                     "construction.", _fileName);
+    checkAndWriteRow(time, row);
+}
+
+template<typename T>
+void STOFileWriter_<T>::appendTable(const TimeSeriesTable_<T>& table) {
+    const auto& labels = table.getColumnLabels();
+    if (!_headerWritten) {
+        writeHeaderOnce(labels, table.getTableMetaData());
+    } else {
+        OPENSIM_THROW_IF(labels != _columnLabels, Exception,
+                         "Column labels of the table do not match those "
+                         "written to '{}'.", _fileName);
+    }
+    const auto& times = table.getIndependentColumn();
+    for (size_t irow = 0; irow < table.getNumRows(); ++irow) {
+        checkAndWriteRow(times[irow], table.getRowAtIndex(irow));
+    }
+}
+
+typedef STOFileReader_<double> STOFileReader;
+typedef STOFileWriter_<double> STOFileWriter;
+
+} // namespace OpenSim
+
+#endif // OPENSIM_STO_FILE_STREAM_H_
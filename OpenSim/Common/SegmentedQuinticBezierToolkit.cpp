@@ -755,6 +755,31 @@ double SegmentedQuinticBezierToolkit::calcQuinticBezierCurveDerivU(double u,
 
 }
 
+SimTK::Vec6 SegmentedQuinticBezierToolkit::
+    calcQuinticBezierPowerBasisCoefficients(const SimTK::Vector& pts)
+{
+    SimTK_ERRCHK_ALWAYS( (pts.size()==6) , 
+        "SegmentedQuinticBezierToolkit::"
+        "calcQuinticBezierPowerBasisCoefficients", 
+        "Error: vector argument pts \nmust have a length of 6.");
+
+    double p0 = pts(0);
+    double p1 = pts(1);
+    double p2 = pts(2);
+    double p3 = pts(3);
+    double p4 = pts(4);
+    double p5 = pts(5);
+
+    SimTK::Vec6 c;
+    c[0] = p0;
+    c[1] = -5*p0 + 5*p1;
+    c[2] = 10*p0 - 20*p1 + 10*p2;
+    c[3] = -10*p0 + 30*p1 - 30*p2 + 10*p3;
+    c[4] = 5*p0 - 20*p1 + 30*p2 - 20*p3 + 5*p4;
+    c[5] = -p0 + 5*p1 - 10*p2 + 10*p3 - 5*p4 + p5;
+    return c;
+}
+
 double SegmentedQuinticBezierToolkit::clampU(double u){
     double uC = u;
     if(u<0.0){
@@ -389,6 +389,30 @@ class OSIMCOMMON_API SegmentedQuinticBezierToolkit
         static double calcQuinticBezierCurveDerivU(double u, 
                            const SimTK::Vector& pts,int order);
 
+        /**
+        Calculates the coefficients of the polynomial in u (the power basis
+        form) that is equivalent to a quintic Bezier curve.
+
+        @param pts      The locations of the 6 control points in 1 dimension.
+        @throws OpenSim::Exception if pts is not 6 elements long
+        @return         The coefficients c, such that the Bezier curve is
+                        c(0) + c(1)*u + c(2)*u^2 + ... + c(5)*u^5.
+
+        The coefficients are the product of the coefficient matrix cM (see
+        calcQuinticBezierCurveVal) and the control points. Evaluating the 
+        curve and its derivatives from these coefficients using Horner's rule
+        is cheaper than calcQuinticBezierCurveVal and 
+        calcQuinticBezierCurveDerivU, and involves no branches, which is 
+        useful when evaluating a curve at many points at once.
+
+        <B>Computational Costs</B>
+        \verbatim
+            ~30 flops
+        \endverbatim
+        */
+        static SimTK::Vec6 calcQuinticBezierPowerBasisCoefficients(
+                           const SimTK::Vector& pts);
+
         /**
         Calculates the value of dydx of a quintic Bezier curve derivative at u.
 
@@ -24,6 +24,7 @@
 // INCLUDES
 //=============================================================================
 #include "SmoothSegmentedFunction.h"
+#include <algorithm>
 #include <fstream>
 #include "simmath/internal/SplineFitter.h"
 
@@ -39,6 +40,13 @@ static double UTOL = (double)SimTK::Eps*1e2;
 static double INTTOL = (double)SimTK::Eps*1e2;
 static int MAXITER = 20;
 static int NUM_SAMPLE_PTS = 100;
+//Number of points whose Newton iterations for u are advanced together by
+//the batch evaluation functions
+static const int BATCH_BLOCK_SIZE = 64;
+//Initial and maximum number of intervals per Bezier section of the lookup
+//table
+static const int MIN_TABLE_INTERVALS = 4;
+static const int MAX_TABLE_INTERVALS = 16384;
 //=============================================================================
 // UTILITY FUNCTIONS
 //=============================================================================
@@ -157,10 +165,19 @@ _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
     
     _mXVec.resize(_numBezierSections);
     _mYVec.resize(_numBezierSections);
+    _xCoefficients.resize(_numBezierSections);
+    _yCoefficients.resize(_numBezierSections);
     for(int s=0; s < _numBezierSections; s++){
         _mXVec[s] = mX(s); 
         _mYVec[s] = mY(s); 
+        _xCoefficients[s] = SegmentedQuinticBezierToolkit::
+            calcQuinticBezierPowerBasisCoefficients(_mXVec[s]);
+        _yCoefficients[s] = SegmentedQuinticBezierToolkit::
+            calcQuinticBezierPowerBasisCoefficients(_mYVec[s]);
     }
+
+    _tableTolerance = SimTK::NaN;
+    _tableError = SimTK::Vec3(SimTK::NaN);
 }
 
  SmoothSegmentedFunction::SmoothSegmentedFunction():
@@ -171,8 +188,12 @@ _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
         _arraySplineUX.resize(0);        
         _mXVec.resize(0);
         _mYVec.resize(0);
+        _xCoefficients.resize(0);
+        _yCoefficients.resize(0);
         _splineYintX = SimTK::Spline();
         _numBezierSections = (int)SimTK::NaN;
+        _tableTolerance = SimTK::NaN;
+        _tableError = SimTK::Vec3(SimTK::NaN);
        
  }
 
@@ -200,7 +221,10 @@ ________________________________________________________________________
 double SmoothSegmentedFunction::calcValue(double x) const
 {
     double yVal = 0;
-    if(x >= _x0 && x <= _x1 )
+    if(x >= _x0 && x <= _x1 && isLookupTableBuilt())
+    {
+        yVal = calcLookupTable(x, 0);
+    }else if(x >= _x0 && x <= _x1 )
     {
         int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
         double u = SegmentedQuinticBezierToolkit::
@@ -218,6 +242,401 @@ double SmoothSegmentedFunction::calcValue(double x) const
     return yVal;
 }
 
+//=============================================================================
+// BATCH EVALUATION
+//=============================================================================
+/*
+ The batch functions evaluate the Bezier polynomials in power basis form
+ using Horner's rule. The Newton iterations for u of a block of points are 
+ advanced in lock step: a point that has converged takes a step of 0 rather
+ than leaving the loop, so that the loops over the block contain no 
+ data-dependent branches and can be vectorized by the compiler.
+
+ Approximate cost per point in the curve domain (compare with ~282 flops for
+ calcValue(double)):
+                            Name     Comp.   Div.    Mult.   Add.    Assign.
+        SegmentedQuinticBezierToolkit::
+                        calcIndex     3*m+2                   1*m     3
+               spline initial guess   7               2       3       1
+          Newton iteration (each)     3       1      10      11       3
+                              value                   5       5       1
+*/
+namespace {
+    inline double calcPowerBasisVal(const SimTK::Vec6& c, double u) {
+        return ((((c[5]*u + c[4])*u + c[3])*u + c[2])*u + c[1])*u + c[0];
+    }
+    inline double calcPowerBasisDerivU1(const SimTK::Vec6& c, double u) {
+        return (((5*c[5]*u + 4*c[4])*u + 3*c[3])*u + 2*c[2])*u + c[1];
+    }
+    inline double calcPowerBasisDerivU2(const SimTK::Vec6& c, double u) {
+        return ((20*c[5]*u + 12*c[4])*u + 6*c[3])*u + 2*c[2];
+    }
+}
+
+void SmoothSegmentedFunction::calcBatchU(const SimTK::Vector& x,
+        SimTK::Array_<int>& idx, SimTK::Vector& u) const
+{
+    const int n = x.size();
+    idx.resize(n);
+    u.resize(n);
+
+    // Structure-of-arrays workspace for one block of points.
+    double c[6][BATCH_BLOCK_SIZE];
+    double ub[BATCH_BLOCK_SIZE];
+    double xb[BATCH_BLOCK_SIZE];
+    double fb[BATCH_BLOCK_SIZE];
+    int pos[BATCH_BLOCK_SIZE];
+
+    for(int begin = 0; begin < n; begin += BATCH_BLOCK_SIZE){
+        const int end = std::min(begin + BATCH_BLOCK_SIZE, n);
+
+        // Gather the points in the curve domain, with the initial guess for
+        // u from the spline fit of u(x).
+        int m = 0;
+        for(int i = begin; i < end; ++i){
+            const double xi = x[i];
+            if(xi >= _x0 && xi <= _x1){
+                const int s = SegmentedQuinticBezierToolkit::
+                                calcIndex(xi,_mXVec);
+                idx[i] = s;
+                const SimTK::Vec6& cx = _xCoefficients[s];
+                for(int k = 0; k < 6; ++k) c[k][m] = cx[k];
+                ub[m] = std::min(std::max(
+                            _arraySplineUX[s].calcValue(xi), 0.0), 1.0);
+                xb[m] = xi;
+                pos[m] = i;
+                ++m;
+            }else{
+                idx[i] = -1;
+                u[i] = SimTK::NaN;
+            }
+        }
+
+        // Newton iterate all points of the block to the desired tolerance.
+        for(int iter = 0; ; ++iter){
+            int numActive = 0;
+            for(int j = 0; j < m; ++j){
+                const double uj = ub[j];
+                fb[j] = (((((c[5][j]*uj + c[4][j])*uj + c[3][j])*uj 
+                        + c[2][j])*uj + c[1][j])*uj + c[0][j]) - xb[j];
+                numActive += (std::abs(fb[j]) > UTOL);
+            }
+            if(numActive == 0 || iter == MAXITER) break;
+
+            for(int j = 0; j < m; ++j){
+                const double uj = ub[j];
+                const double df = (((5*c[5][j]*uj + 4*c[4][j])*uj 
+                        + 3*c[3][j])*uj + 2*c[2][j])*uj + c[1][j];
+                const double du = (std::abs(fb[j]) > UTOL) ? -fb[j]/df : 0;
+                ub[j] = std::min(std::max(uj + du, 0.0), 1.0);
+            }
+        }
+
+        // Scatter the solutions back, checking for convergence.
+        for(int j = 0; j < m; ++j){
+            SimTK_ERRCHK2_ALWAYS( (std::abs(fb[j]) <= UTOL), 
+                "SmoothSegmentedFunction::calcBatchU", 
+                "%s: desired tolerance on U not met by the Newton iteration"
+                " at x = %f.", _name.c_str(), xb[j]);
+            u[pos[j]] = ub[j];
+        }
+    }
+}
+
+double SmoothSegmentedFunction::calcDerivativeAtU(int idx, double u,
+                                                  int order) const
+{
+    const SimTK::Vec6& cx = _xCoefficients[idx];
+    const SimTK::Vec6& cy = _yCoefficients[idx];
+    const double dxdu = calcPowerBasisDerivU1(cx, u);
+    const double dydu = calcPowerBasisDerivU1(cy, u);
+    if(order == 1){
+        return dydu/dxdu;
+    }
+    if(order == 2){
+        //See SegmentedQuinticBezierToolkit::calcQuinticBezierCurveDerivDYDX
+        const double d2xdu2 = calcPowerBasisDerivU2(cx, u);
+        const double d2ydu2 = calcPowerBasisDerivU2(cy, u);
+        const double t1 = 1/dxdu;
+        return (d2ydu2*t1 - dydu*t1*t1*d2xdu2)*t1;
+    }
+    return SegmentedQuinticBezierToolkit::
+        calcQuinticBezierCurveDerivDYDX(u, _mXVec[idx], _mYVec[idx], order);
+}
+
+void SmoothSegmentedFunction::calcValues(const SimTK::Vector& x,
+                                         SimTK::Vector& y) const
+{
+    y.resize(x.size());
+    if(isLookupTableBuilt()){
+        for(int i = 0; i < x.size(); ++i) y[i] = calcValue(x[i]);
+        return;
+    }
+
+    SimTK::Array_<int> idx;
+    SimTK::Vector u;
+    calcBatchU(x, idx, u);
+
+    for(int i = 0; i < x.size(); ++i){
+        if(idx[i] >= 0){
+            y[i] = calcPowerBasisVal(_yCoefficients[idx[i]], u[i]);
+        }else if(x[i] < _x0){
+            y[i] = _y0 + _dydx0*(x[i]-_x0);
+        }else{
+            y[i] = _y1 + _dydx1*(x[i]-_x1);
+        }
+    }
+}
+
+void SmoothSegmentedFunction::calcDerivatives(const SimTK::Vector& x,
+        int order, SimTK::Vector& dydx) const
+{
+    SimTK_ERRCHK2_ALWAYS( (order >= 0 && order <= 6),
+        "SmoothSegmentedFunction::calcDerivatives",
+        "%s: order must be between 0 and 6, but %i was entered.",
+        _name.c_str(), order);
+
+    if(order == 0){
+        calcValues(x, dydx);
+        return;
+    }
+
+    dydx.resize(x.size());
+    if(isLookupTableBuilt() && order <= 2){
+        for(int i = 0; i < x.size(); ++i) dydx[i] = calcDerivative(x[i], order);
+        return;
+    }
+
+    SimTK::Array_<int> idx;
+    SimTK::Vector u;
+    calcBatchU(x, idx, u);
+
+    for(int i = 0; i < x.size(); ++i){
+        if(idx[i] >= 0){
+            dydx[i] = calcDerivativeAtU(idx[i], u[i], order);
+        }else if(order == 1){
+            dydx[i] = (x[i] < _x0) ? _dydx0 : _dydx1;
+        }else{
+            dydx[i] = 0;
+        }
+    }
+}
+
+void SmoothSegmentedFunction::calcValuesAndDerivatives(const SimTK::Vector& x,
+        SimTK::Vector& y, SimTK::Vector& dydx) const
+{
+    y.resize(x.size());
+    dydx.resize(x.size());
+    if(isLookupTableBuilt()){
+        for(int i = 0; i < x.size(); ++i){
+            y[i] = calcValue(x[i]);
+            dydx[i] = calcDerivative(x[i], 1);
+        }
+        return;
+    }
+
+    SimTK::Array_<int> idx;
+    SimTK::Vector u;
+    calcBatchU(x, idx, u);
+
+    for(int i = 0; i < x.size(); ++i){
+        if(idx[i] >= 0){
+            y[i] = calcPowerBasisVal(_yCoefficients[idx[i]], u[i]);
+            dydx[i] = calcDerivativeAtU(idx[i], u[i], 1);
+        }else if(x[i] < _x0){
+            y[i] = _y0 + _dydx0*(x[i]-_x0);
+            dydx[i] = _dydx0;
+        }else{
+            y[i] = _y1 + _dydx1*(x[i]-_x1);
+            dydx[i] = _dydx1;
+        }
+    }
+}
+
+//=============================================================================
+// LOOKUP TABLE
+//=============================================================================
+/*
+ On an interval of width h, with t = (x - x_i)/h, the quintic Hermite 
+ polynomial p(t) that matches y, h*dy/dx and h^2*d2y/dx2 at t = 0 and t = 1
+ has the power basis coefficients computed below. Its interpolation error 
+ is proportional to t^3(1-t)^3 to leading order, which is largest at the 
+ midpoint of the interval, and so the midpoint and quarter points are the 
+ points at which the table is checked against the curve.
+
+ Approximate cost of calcLookupTable per point (compare with ~282 flops for
+ the exact value):
+                            Name     Comp.   Div.    Mult.   Add.    Assign.
+        SegmentedQuinticBezierToolkit::
+                        calcIndex     3*m+2                   1*m     3
+                   interval index     2               1       2       3
+                            value                     5       5       1
+*/
+SimTK::Vec3 SmoothSegmentedFunction::
+    calcSectionValueAndDerivatives(int s, double x) const
+{
+    const double u = SegmentedQuinticBezierToolkit::
+                calcU(x,_mXVec[s], _arraySplineUX[s], UTOL, MAXITER);
+    return SimTK::Vec3(calcPowerBasisVal(_yCoefficients[s], u),
+                       calcDerivativeAtU(s, u, 1),
+                       calcDerivativeAtU(s, u, 2));
+}
+
+double SmoothSegmentedFunction::calcLookupTable(double x, int order) const
+{
+    const int s = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
+    const int n = _tableNumIntervals[s];
+    const double intervalsPerX = _tableIntervalsPerX[s];
+    double t = (x - _mXVec[s](0))*intervalsPerX;
+    const int i = std::min(std::max((int)t, 0), n-1);
+    t -= i;
+
+    const SimTK::Vec6& a = _tableCoefficients[_tableOffset[s] + i];
+    if(order == 0){
+        return calcPowerBasisVal(a, t);
+    }else if(order == 1){
+        return calcPowerBasisDerivU1(a, t)*intervalsPerX;
+    }
+    return calcPowerBasisDerivU2(a, t)*intervalsPerX*intervalsPerX;
+}
+
+void SmoothSegmentedFunction::buildLookupTable(double tolerance)
+{
+    SimTK_ERRCHK2_ALWAYS( tolerance > 0,
+        "SmoothSegmentedFunction::buildLookupTable",
+        "%s: tolerance must be greater than 0, but %f was entered.",
+        _name.c_str(), tolerance);
+
+    clearLookupTable();
+
+    SimTK::Array_<SimTK::Vec6> coefficients;
+    SimTK::Array_<int> offset(_numBezierSections);
+    SimTK::Array_<int> numIntervals(_numBezierSections);
+    SimTK::Array_<double> intervalsPerX(_numBezierSections);
+    SimTK::Vec3 error(0);
+
+    const double tCheck[3] = {0.25, 0.5, 0.75};
+
+    for(int s=0; s < _numBezierSections; s++){
+        const double xStart = _mXVec[s](0);
+        const double xEnd   = _mXVec[s](5);
+        const double width  = xEnd - xStart;
+
+        SimTK::Array_<SimTK::Vec6> sectionCoefficients;
+        SimTK::Array_<SimTK::Vec3> knots;
+        SimTK::Vec3 sectionError(0);
+        int n = MIN_TABLE_INTERVALS;
+        while(true){
+            const double h = width/n;
+
+            // Evaluate the curve at the knots.
+            knots.resize(n+1);
+            SimTK::Vec3 scale(1);
+            for(int i = 0; i <= n; ++i){
+                knots[i] = calcSectionValueAndDerivatives(s, 
+                                    (i == n) ? xEnd : xStart + i*h);
+                scale[1] = std::max(scale[1], std::abs(knots[i][1]));
+                scale[2] = std::max(scale[2], std::abs(knots[i][2]));
+            }
+
+            // Fit the quintic Hermite polynomial of each interval.
+            sectionCoefficients.resize(n);
+            for(int i = 0; i < n; ++i){
+                const double dy = knots[i+1][0] - knots[i][0];
+                const double d0 = h*knots[i][1];
+                const double d1 = h*knots[i+1][1];
+                const double s0 = h*h*knots[i][2];
+                const double s1 = h*h*knots[i+1][2];
+                SimTK::Vec6& a = sectionCoefficients[i];
+                a[0] = knots[i][0];
+                a[1] = d0;
+                a[2] = 0.5*s0;
+                a[3] =  10*dy - 6*d0 - 4*d1 - 0.5*(3*s0 -   s1);
+                a[4] = -15*dy + 8*d0 + 7*d1 + 0.5*(3*s0 - 2*s1);
+                a[5] =   6*dy - 3*d0 - 3*d1 - 0.5*(  s0 -   s1);
+            }
+
+            // Check the table against the curve.
+            sectionError = SimTK::Vec3(0);
+            for(int i = 0; i < n; ++i){
+                const SimTK::Vec6& a = sectionCoefficients[i];
+                for(int k = 0; k < 3; ++k){
+                    const double t = tCheck[k];
+                    const SimTK::Vec3 exact = 
+                        calcSectionValueAndDerivatives(s, xStart + (i+t)*h);
+                    sectionError[0] = std::max(sectionError[0], 
+                        std::abs(calcPowerBasisVal(a, t) - exact[0]));
+                    sectionError[1] = std::max(sectionError[1], 
+                        std::abs(calcPowerBasisDerivU1(a, t)/h - exact[1]));
+                    sectionError[2] = std::max(sectionError[2], 
+                        std::abs(calcPowerBasisDerivU2(a, t)/(h*h) 
+                                 - exact[2]));
+                }
+            }
+
+            if(    sectionError[0] <= tolerance 
+                && sectionError[1] <= tolerance*scale[1]
+                && sectionError[2] <= tolerance*scale[2]){
+                break;
+            }
+
+            n *= 2;
+            SimTK_ERRCHK4_ALWAYS( n <= MAX_TABLE_INTERVALS,
+                "SmoothSegmentedFunction::buildLookupTable",
+                "%s: a tolerance of %g could not be met with %i intervals "
+                "in Bezier section %i.", 
+                _name.c_str(), tolerance, MAX_TABLE_INTERVALS, s);
+        }
+
+        offset[s] = (int)coefficients.size();
+        numIntervals[s] = n;
+        intervalsPerX[s] = n/width;
+        for(int i = 0; i < n; ++i){
+            coefficients.push_back(sectionCoefficients[i]);
+        }
+        for(int k = 0; k < 3; ++k){
+            error[k] = std::max(error[k], sectionError[k]);
+        }
+    }
+
+    _tableCoefficients = coefficients;
+    _tableOffset = offset;
+    _tableNumIntervals = numIntervals;
+    _tableIntervalsPerX = intervalsPerX;
+    _tableTolerance = tolerance;
+    _tableError = error;
+}
+
+void SmoothSegmentedFunction::clearLookupTable()
+{
+    _tableCoefficients.clear();
+    _tableOffset.clear();
+    _tableNumIntervals.clear();
+    _tableIntervalsPerX.clear();
+    _tableTolerance = SimTK::NaN;
+    _tableError = SimTK::Vec3(SimTK::NaN);
+}
+
+bool SmoothSegmentedFunction::isLookupTableBuilt() const
+{
+    return !_tableCoefficients.empty();
+}
+
+double SmoothSegmentedFunction::getLookupTableTolerance() const
+{
+    return _tableTolerance;
+}
+
+SimTK::Vec3 SmoothSegmentedFunction::getLookupTableError() const
+{
+    return _tableError;
+}
+
+int SmoothSegmentedFunction::getLookupTableSize() const
+{
+    return (int)_tableCoefficients.size();
+}
+
 double SmoothSegmentedFunction::calcValue(const SimTK::Vector& ax) const
 {
     
@@ -269,7 +688,9 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
     if(order==0){
                 yVal = calcValue(x);
     }else{
-            if(x >= _x0 && x <= _x1){        
+            if(x >= _x0 && x <= _x1 && order <= 2 && isLookupTableBuilt()){
+                yVal = calcLookupTable(x, order);
+            }else if(x >= _x0 && x <= _x1){        
                 int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
                 double u = SegmentedQuinticBezierToolkit::
                                 calcU(x,_mXVec[idx], _arraySplineUX[idx], 
@@ -122,6 +122,109 @@ namespace OpenSim {
        */
        double calcDerivative(double x, int order) const;       
 
+       /**Calculates the value of the curve at every point in x. The result
+       is the same as calling calcValue(double) for each element of x (to 
+       within the tolerance of the Newton iteration for u), but is 
+       considerably cheaper when there are many points: the Newton iterations
+       for the points are advanced together in blocks, using the power basis
+       form of the Bezier curves, in loops that the compiler can vectorize.
+
+       @param x The domain points of interest
+       @param y The values of the curve at x (resized to match x)
+       @throws OpenSim::Exception
+        -If the Newton iteration for u does not converge for any point
+       */
+       void calcValues(const SimTK::Vector& x, SimTK::Vector& y) const;
+
+       /**Calculates the derivative of the curve of the given order at every
+       point in x. See calcValues() and calcDerivative(double, int).
+
+       @param x     The domain points of interest
+       @param order The order of the derivative to compute, between 0 and 6.
+                    Orders 0 to 2 take the fast path of calcValues(); higher
+                    orders share the batched solve for u.
+       @param dydx  The derivative of the curve at x (resized to match x)
+       @throws OpenSim::Exception
+        -If order is not between 0 and 6
+        -If the Newton iteration for u does not converge for any point
+       */
+       void calcDerivatives(const SimTK::Vector& x, int order,
+                            SimTK::Vector& dydx) const;
+
+       /**Calculates the value and first derivative of the curve at every
+       point in x, solving for u only once per point. Muscle models usually
+       need both quantities at the same fiber length or velocity. See
+       calcValues().
+
+       @param x     The domain points of interest
+       @param y     The values of the curve at x (resized to match x)
+       @param dydx  The first derivative of the curve at x (resized to match 
+                    x)
+       */
+       void calcValuesAndDerivatives(const SimTK::Vector& x,
+                            SimTK::Vector& y, SimTK::Vector& dydx) const;
+
+       /**Replaces the exact evaluation of the curve, and of its first two
+       derivatives, within getCurveDomain() by a precomputed lookup table.
+       Each Bezier section is divided into equal intervals, and on each
+       interval the curve is approximated by the quintic Hermite polynomial
+       that matches y, dy/dx and d2y/dx2 at both ends of the interval. The
+       approximation is therefore C2 continuous, like the curve itself.
+       Evaluating the table requires no Newton iteration for u: the interval
+       is found by indexing, and the polynomial is evaluated with Horner's
+       rule, so the cost does not depend on where x lies in the domain.
+
+       The number of intervals of each section is doubled until the error of
+       the table, measured against the exact curve at the midpoint and
+       quarter points of every interval (where the interpolation error of a
+       quintic Hermite polynomial is largest), is below the tolerance:
+       \verbatim
+            |y - y_table|                  <= tolerance
+            |dy/dx - dy/dx_table|          <= tolerance*max(1, max|dy/dx|)
+            |d2y/dx2 - d2y/dx2_table|      <= tolerance*max(1, max|d2y/dx2|)
+       \endverbatim
+       where the maxima are taken over the knots of the Bezier section. The
+       tolerance is therefore only verified at these sample points, not
+       guaranteed everywhere in the domain; the largest errors measured at
+       the sample points are available from getLookupTableError(). Derivatives
+       of order 3 and higher, the integral, and the linear extrapolation
+       outside of the curve domain are not affected by the table.
+
+       @param tolerance The error tolerance of the table (see above).
+       @throws OpenSim::Exception
+        -If tolerance is not positive
+        -If the tolerance cannot be met with 16384 intervals per Bezier
+         section
+
+       <B>Computational Costs</B>
+       \verbatim
+            x in curve domain  : ~30 flops (value), ~35 flops (derivative)
+       \endverbatim
+       */
+       void buildLookupTable(double tolerance);
+
+       /**Discards the lookup table (if any), so that the curve is evaluated
+       exactly again. */
+       void clearLookupTable();
+
+       /**@return true if buildLookupTable() has been called, so that the
+       value and first two derivatives of the curve are evaluated using the
+       lookup table.*/
+       bool isLookupTableBuilt() const;
+
+       /**@return the tolerance that was given to buildLookupTable(), or NaN
+       if there is no lookup table.*/
+       double getLookupTableTolerance() const;
+
+       /**@return the largest measured error of the lookup table in y, dy/dx
+       and d2y/dx2 (in elements 0, 1 and 2), or NaN's if there is no lookup
+       table.*/
+       SimTK::Vec3 getLookupTableError() const;
+
+       /**@return the total number of intervals in the lookup table, or 0 if
+       there is no lookup table.*/
+       int getLookupTableSize() const;
+
 #ifndef SWIG
        /// Allow the more general calcDerivative from the base class to be used.
        // This helps avoid the -Woverloaded-virtual warning with Clang.
@@ -319,6 +422,25 @@ namespace OpenSim {
         /**Bezier Y1,...,Yn control point locations. Control points are 
         stored in 6x1 vectors in the order above*/
         SimTK::Array_<SimTK::Vector> _mYVec; 
+        /**Power basis coefficients of the polynomials X(u) and Y(u) of each
+        Bezier section, used by the batch evaluation functions*/
+        SimTK::Array_<SimTK::Vec6> _xCoefficients;
+        SimTK::Array_<SimTK::Vec6> _yCoefficients;
+
+        /**Coefficients, in the normalized interval coordinate t in [0,1], of
+        the quintic Hermite polynomials of every interval of the lookup table.
+        The intervals of Bezier section s begin at _tableOffset[s]*/
+        SimTK::Array_<SimTK::Vec6> _tableCoefficients;
+        /**Index of the first interval of each Bezier section in the table*/
+        SimTK::Array_<int> _tableOffset;
+        /**Number of intervals of each Bezier section in the table*/
+        SimTK::Array_<int> _tableNumIntervals;
+        /**Number of intervals per unit x of each Bezier section*/
+        SimTK::Array_<double> _tableIntervalsPerX;
+        /**Tolerance the table was built to; NaN if there is no table*/
+        double _tableTolerance;
+        /**Measured error of the table in y, dy/dx and d2y/dx2*/
+        SimTK::Vec3 _tableError;
 
         /**The number of quintic Bezier curves that describe the relation*/
         int _numBezierSections;
@@ -429,6 +551,32 @@ namespace OpenSim {
             SimTK::Array_<std::string>& colnames,
             const std::string& path, const std::string& filename) const;
 
+        /**
+        Solves for the Bezier section index and the parameter u of every
+        point in x that lies within the curve domain. Points outside of the
+        domain are given an index of -1.
+        */
+        void calcBatchU(const SimTK::Vector& x, SimTK::Array_<int>& idx,
+                        SimTK::Vector& u) const;
+
+        /**
+        Calculates the derivative of the given order (1 or 2) at a point for
+        which u has already been solved.
+        */
+        double calcDerivativeAtU(int idx, double u, int order) const;
+
+        /**
+        Evaluates y, dy/dx and d2y/dx2 exactly at a point x of Bezier section
+        s. Used to build and to check the lookup table.
+        */
+        SimTK::Vec3 calcSectionValueAndDerivatives(int s, double x) const;
+
+        /**
+        Evaluates the derivative of the given order (0 to 2) of the lookup
+        table at a point x in the curve domain.
+        */
+        double calcLookupTable(double x, int order) const;
+
        /**
        Refer to the documentation for calcValue(double x) 
        because this function is identical in function to 
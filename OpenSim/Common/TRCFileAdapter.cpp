@@ -1,7 +1,12 @@
 #include "TRCFileAdapter.h"
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/IO.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
+#include <sstream>
 
 namespace OpenSim {
 
@@ -156,67 +161,77 @@ TRCFileAdapter::extendRead(const std::string& fileName) const {
         }
     }
 
-    // Read the rows one at a time and fill up the time column container and
-    // the data container.
-    std::size_t line_num{_dataStartsAtLine};
-    std::vector<std::string> row = nextLine();
-    // skip immediate blank lines between header and data.
-    while(row.empty() || row.at(0).empty()) {
-        row = nextLine();
-        ++line_num;
-    }
-    
-    const size_t expected{ column_labels.size() * 3 + 2 };
-    // Will first store data in a SimTK::Matrix to avoid expensive calls 
-    // to the table's appendRow() which reallocates and copies the whole table.
-    int rowNumber = 0;
-    int last_size = 1024; 
-    SimTK::Matrix_<SimTK::Vec3> markerData{last_size, static_cast<int>(num_markers_expected)};
+    // Read the rest of the file into memory and parse the data rows in place.
+    const std::string buffer = readToEnd(in_stream);
     std::vector<double> times;
-    times.resize(last_size);
-
-    // An empty line during data parsing denotes end of data
-    while (!row.empty()) {
-        OPENSIM_THROW_IF(row.size() != expected,
-                         RowLengthMismatch,
-                         fileName,
-                         line_num,
-                         expected,
-                         row.size());
-
-        // Columns 2 till the end are data.
-        TimeSeriesTableVec3::RowVector 
-            row_vector{static_cast<int>(num_markers_expected), 
-                       SimTK::Vec3(SimTK::NaN)};
-        int ind{0};
-        for (std::size_t c = 2; c < column_labels.size() * 3 + 2; c += 3) {
-            //only if each component is specified read process as a Vec3
-            if ( !(row.at(c).empty() || row.at(c + 1).empty() 
-                                     || row.at(c + 2).empty()) ) {
-                row_vector[ind] = SimTK::Vec3{ std::stod(row.at(c)),
-                                               std::stod(row.at(c + 1)),
-                                               std::stod(row.at(c + 2)) };
-            } // otherwise the value will remain NaN (default)
-            ++ind;
+    SimTK::Matrix_<SimTK::Vec3> markerData;
+    if (!parseRows(buffer, static_cast<int>(num_markers_expected), times,
+                   markerData)) {
+        // Read the rows one at a time and fill up the time column container
+        // and the data container. This provides the line number of any error.
+        std::istringstream data_stream{buffer};
+        auto nextDataLine = [&] {
+            return getNextLine(data_stream, _delimitersRead);
+        };
+        std::size_t line_num{_dataStartsAtLine};
+        std::vector<std::string> row = nextDataLine();
+        // skip immediate blank lines between header and data.
+        while(row.empty() || row.at(0).empty()) {
+            row = nextDataLine();
+            ++line_num;
         }
-        markerData[rowNumber] = row_vector;
-        // Column 1 is time.
-        times[rowNumber] = std::stod(row.at(1));
-        rowNumber++;
-        if (rowNumber== last_size) {
-            // resize all Data/Matrices, double the size  while keeping data
-            int newSize = last_size * 2;
-            times.resize(newSize);
-            // Repeat for Data matrices in use
-            markerData.resizeKeep(newSize, (int)num_markers_expected);
-            last_size = newSize;
+    
+        const size_t expected{ column_labels.size() * 3 + 2 };
+        // Will first store data in a SimTK::Matrix to avoid expensive calls 
+        // to the table's appendRow() which reallocates and copies the whole table.
+        int rowNumber = 0;
+        int last_size = 1024; 
+        markerData.resize(last_size, static_cast<int>(num_markers_expected));
+        times.resize(last_size);
+
+        // An empty line during data parsing denotes end of data
+        while (!row.empty()) {
+            OPENSIM_THROW_IF(row.size() != expected,
+                             RowLengthMismatch,
+                             fileName,
+                             line_num,
+                             expected,
+                             row.size());
+
+            // Columns 2 till the end are data.
+            TimeSeriesTableVec3::RowVector 
+                row_vector{static_cast<int>(num_markers_expected), 
+                           SimTK::Vec3(SimTK::NaN)};
+            int ind{0};
+            for (std::size_t c = 2; c < column_labels.size() * 3 + 2; c += 3) {
+                //only if each component is specified read process as a Vec3
+                if ( !(row.at(c).empty() || row.at(c + 1).empty() 
+                                         || row.at(c + 2).empty()) ) {
+                    row_vector[ind] = SimTK::Vec3{ std::stod(row.at(c)),
+                                                   std::stod(row.at(c + 1)),
+                                                   std::stod(row.at(c + 2)) };
+                } // otherwise the value will remain NaN (default)
+                ++ind;
+            }
+            markerData[rowNumber] = row_vector;
+            // Column 1 is time.
+            times[rowNumber] = std::stod(row.at(1));
+            rowNumber++;
+            if (rowNumber== last_size) {
+                // resize all Data/Matrices, double the size  while keeping data
+                int newSize = last_size * 2;
+                times.resize(newSize);
+                // Repeat for Data matrices in use
+                markerData.resizeKeep(newSize, (int)num_markers_expected);
+                last_size = newSize;
+            }
+            row = nextDataLine();
+            ++line_num;
         }
-        row = nextLine();
-        ++line_num;
+        // Trim Matrices in use to actual data and move into tables
+        times.resize(rowNumber);
+        markerData.resizeKeep(rowNumber, (int)num_markers_expected);
     }
-    // Trim Matrices in use to actual data and move into tables
-    times.resize(rowNumber);
-    markerData.resizeKeep(rowNumber, (int)num_markers_expected);
 
     // Set the column labels of the table.
     std::vector<std::string> labels{};
@@ -232,6 +247,104 @@ TRCFileAdapter::extendRead(const std::string& fileName) const {
     return output_tables;
 }
 
+namespace {
+    // Whether the token [begin, end) is empty once trimmed by
+    // IO::TrimWhitespace().
+    bool isBlank(const char* begin, const char* end) {
+        return std::all_of(begin, end, [](char c) {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        });
+    }
+}
+
+bool
+TRCFileAdapter::parseRows(const std::string& buffer,
+                          int numMarkers,
+                          std::vector<double>& times,
+                          SimTK::Matrix_<SimTK::Vec3>& markerData) {
+    // Skip the blank lines between the header and the data, as extendRead()
+    // does: lines that are empty or whose first token (the frame number) is.
+    const char* begin = buffer.data();
+    const char* const bufferEnd = begin + buffer.size();
+    while (begin < bufferEnd) {
+        const char* eol = static_cast<const char*>(
+                std::memchr(begin, '\n', bufferEnd - begin));
+        if (!eol) eol = bufferEnd;
+        const char* firstTokenEnd = std::find_first_of(begin, eol,
+                _delimitersRead.begin(), _delimitersRead.end());
+        if (!isBlank(begin, firstTokenEnd)) break;
+        begin = eol == bufferEnd ? bufferEnd : eol + 1;
+    }
+    // An empty line denotes the end of the data.
+    const auto lines = splitLines(begin, bufferEnd);
+
+    const int nrow = static_cast<int>(lines.size());
+    times.resize(nrow);
+    markerData.resize(nrow, numMarkers);
+
+    // Parse blocks of rows concurrently; small files are parsed in a single
+    // block on this thread.
+    const int rowsPerBlock = 10000;
+    const int numBlocks = (nrow + rowsPerBlock - 1) / rowsPerBlock;
+    std::atomic<bool> success{true};
+    executeInParallel(numBlocks, getNumThreadsToUse(0),
+            [&](int iblock, int) {
+                const int first = iblock * rowsPerBlock;
+                const int last = std::min(nrow, first + rowsPerBlock);
+                for (int irow = first; irow < last && success; ++irow) {
+                    if (!parseRow(lines[irow].first, lines[irow].second,
+                                numMarkers, times[irow],
+                                markerData.updRow(irow))) {
+                        success = false;
+                    }
+                }
+            });
+    return success;
+}
+
+bool
+TRCFileAdapter::parseRow(const char* begin,
+                         const char* end,
+                         int numMarkers,
+                         double& time,
+                         SimTK::RowVectorView_<SimTK::Vec3> row) {
+    // As in tokenize(), there is a token before each delimiter, and a last
+    // token if any characters follow the last delimiter. Token 0 is the frame
+    // number (which is not used), token 1 is the time, and the rest are the
+    // X, Y and Z coordinates of each marker. A marker with any coordinate
+    // missing is NaN.
+    const int numTokens = 3 * numMarkers + 2;
+    int itok = 0;
+    const char* tokBegin = begin;
+    SimTK::Vec3 location;
+    bool missing = false;
+    for (const char* p = begin; p <= end; ++p) {
+        const bool atDelim = p < end &&
+                _delimitersRead.find(*p) != std::string::npos;
+        if (atDelim || (p == end && p > tokBegin)) {
+            if (itok == numTokens) return false;
+            if (itok == 1) {
+                if (!parseDouble(tokBegin, p, time)) return false;
+            } else if (itok > 1) {
+                const int icomp = (itok - 2) % 3;
+                if (icomp == 0) missing = false;
+                if (isBlank(tokBegin, p)) {
+                    missing = true;
+                } else if (!parseDouble(tokBegin, p, location[icomp])) {
+                    return false;
+                }
+                if (icomp == 2) {
+                    row[(itok - 2) / 3] =
+                            missing ? SimTK::Vec3(SimTK::NaN) : location;
+                }
+            }
+            ++itok;
+            tokBegin = p + 1;
+        }
+    }
+    return itok == numTokens;
+}
+
 void
 TRCFileAdapter::extendWrite(const InputTables& absTables, 
                             const std::string& fileName) const {
@@ -163,6 +163,22 @@ protected:
                      const std::string& filename) const override;
     
 private:
+    /** Parse all the data rows in `buffer`, which holds the contents of the
+    file following the line of X/Y/Z labels, in place (without creating a
+    string for each token). Large files are parsed in blocks of rows on
+    multiple threads. Returns false if any line is not in the expected form;
+    the caller then reads the rows one at a time, which reports the error.  */
+    static bool parseRows(const std::string& buffer,
+                          int numMarkers,
+                          std::vector<double>& times,
+                          SimTK::Matrix_<SimTK::Vec3>& markerData);
+    /** Parse a single row, tokenized the same way as by getNextLine().      */
+    static bool parseRow(const char* begin,
+                         const char* end,
+                         int numMarkers,
+                         double& time,
+                         SimTK::RowVectorView_<SimTK::Vec3> row);
+
     /** Delimiter used for parsing the header of TRC file.                    */
     static const std::string              _headerDelimiters;
     /** Delimiter used for writing.                                           */
@@ -0,0 +1,396 @@
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  TSBFileAdapter.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "TSBFileAdapter.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace OpenSim {
+
+const std::string TSBFileAdapter::_table{"table"};
+
+namespace {
+
+const char magic[8] = {'O', 'S', 'I', 'M', 'T', 'S', 'B', '\0'};
+const std::uint32_t byteOrderMark = 0x01020304;
+const std::uint32_t versionNumber = 1;
+
+/// Read-only memory mapping of an entire file. Pages are loaded by the
+/// operating system only when they are accessed.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& fileName) {
+#ifdef _WIN32
+        m_file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        OPENSIM_THROW_IF(m_file == INVALID_HANDLE_VALUE, FileDoesNotExist,
+                fileName);
+        LARGE_INTEGER size;
+        GetFileSizeEx(m_file, &size);
+        m_size = static_cast<size_t>(size.QuadPart);
+        if (m_size == 0) return;
+        m_mapping = CreateFileMappingA(
+                m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mapping) {
+            m_data = static_cast<const char*>(
+                    MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+#else
+        m_file = open(fileName.c_str(), O_RDONLY);
+        OPENSIM_THROW_IF(m_file < 0, FileDoesNotExist, fileName);
+        struct stat info;
+        fstat(m_file, &info);
+        m_size = static_cast<size_t>(info.st_size);
+        if (m_size == 0) return;
+        void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_file, 0);
+        if (data != MAP_FAILED) m_data = static_cast<const char*>(data);
+#endif
+        OPENSIM_THROW_IF(m_data == nullptr, IOError,
+                "Could not map file '{}' into memory.", fileName);
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() {
+#ifdef _WIN32
+        if (m_data) UnmapViewOfFile(m_data);
+        if (m_mapping) CloseHandle(m_mapping);
+        if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+#else
+        if (m_data) munmap(const_cast<char*>(m_data), m_size);
+        if (m_file >= 0) close(m_file);
+#endif
+    }
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+private:
+#ifdef _WIN32
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#else
+    int m_file = -1;
+#endif
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+/// Sequential reader for the header of a mapped file, with bounds checking.
+class HeaderReader {
+public:
+    HeaderReader(const MappedFile& file, const std::string& fileName) :
+            m_file(file), m_fileName(fileName) {}
+    template <typename T>
+    T read() {
+        T value;
+        std::memcpy(&value, get(sizeof(T)), sizeof(T));
+        return value;
+    }
+    std::string readString() {
+        const auto length = read<std::uint64_t>();
+        const char* chars = get(static_cast<size_t>(length));
+        return std::string(chars, static_cast<size_t>(length));
+    }
+    const char* get(size_t numBytes) {
+        OPENSIM_THROW_IF(m_offset + numBytes > m_file.size(), IOError,
+                "File '{}' is truncated or is not a TSB file.", m_fileName);
+        const char* ptr = m_file.data() + m_offset;
+        m_offset += numBytes;
+        return ptr;
+    }
+private:
+    const MappedFile& m_file;
+    const std::string& m_fileName;
+    size_t m_offset = 0;
+};
+
+struct Header {
+    std::uint32_t numComponents;
+    std::uint64_t numRows;
+    std::uint64_t numColumns;
+    std::uint64_t dataOffset;
+    AbstractDataTable::TableMetaData metaData;
+    std::vector<std::string> columnLabels;
+};
+
+Header readHeader(const MappedFile& file, const std::string& fileName) {
+    HeaderReader reader(file, fileName);
+    OPENSIM_THROW_IF(file.size() < sizeof(magic) ||
+            std::memcmp(reader.get(sizeof(magic)), magic, sizeof(magic)),
+            IOError, "File '{}' is not a TSB file.", fileName);
+    OPENSIM_THROW_IF(reader.read<std::uint32_t>() != byteOrderMark, IOError,
+            "File '{}' was written on a machine with a different byte order.",
+            fileName);
+    const auto version = reader.read<std::uint32_t>();
+    OPENSIM_THROW_IF(version > versionNumber, IOError,
+            "File '{}' has version {}, but only versions up to {} are "
+            "supported.", fileName, version, versionNumber);
+
+    Header header;
+    header.numComponents = reader.read<std::uint32_t>();
+    OPENSIM_THROW_IF(header.numComponents != 1 && header.numComponents != 3,
+            IOError, "File '{}' has elements with {} components; only 1 "
+            "(double) and 3 (Vec3) are supported.",
+            fileName, header.numComponents);
+    reader.read<std::uint32_t>(); // reserved
+    header.numRows = reader.read<std::uint64_t>();
+    header.numColumns = reader.read<std::uint64_t>();
+    header.dataOffset = reader.read<std::uint64_t>();
+
+    const auto numPairs = reader.read<std::uint64_t>();
+    for (std::uint64_t i = 0; i < numPairs; ++i) {
+        const auto key = reader.readString();
+        const auto value = reader.readString();
+        header.metaData.setValueForKey(key, value);
+    }
+    header.columnLabels.reserve(static_cast<size_t>(header.numColumns));
+    for (std::uint64_t i = 0; i < header.numColumns; ++i) {
+        header.columnLabels.push_back(reader.readString());
+    }
+
+    const std::uint64_t dataSize = sizeof(double) * header.numRows *
+            (1 + header.numColumns * header.numComponents);
+    OPENSIM_THROW_IF(header.dataOffset + dataSize > file.size(), IOError,
+            "File '{}' is truncated.", fileName);
+    return header;
+}
+
+/// Create a table containing the given columns (indices into the columns of
+/// the file) without reading the other columns.
+template <typename T>
+std::shared_ptr<AbstractDataTable> readTable(const MappedFile& file,
+        const Header& header, const std::vector<size_t>& columns) {
+    const auto numRows = static_cast<int>(header.numRows);
+    const char* data = file.data() + header.dataOffset;
+
+    std::vector<double> time(header.numRows);
+    if (numRows) std::memcpy(time.data(), data, sizeof(double) * numRows);
+
+    const size_t columnBytes = sizeof(T) * header.numRows;
+    const char* firstColumn = data + sizeof(double) * header.numRows;
+    SimTK::Matrix_<T> matrix(numRows, static_cast<int>(columns.size()));
+    std::vector<std::string> labels;
+    labels.reserve(columns.size());
+    for (int icol = 0; icol < (int)columns.size(); ++icol) {
+        const char* src = firstColumn + columnBytes * columns[icol];
+        auto col = matrix.updCol(icol);
+        for (int irow = 0; irow < numRows; ++irow) {
+            std::memcpy(&col[irow], src + sizeof(T) * irow, sizeof(T));
+        }
+        labels.push_back(header.columnLabels[columns[icol]]);
+    }
+
+    auto table = std::make_shared<TimeSeriesTable_<T>>(time, matrix, labels);
+    table->updTableMetaData() = header.metaData;
+    return table;
+}
+
+std::shared_ptr<AbstractDataTable> readTable(const MappedFile& file,
+        const Header& header, const std::vector<size_t>& columns) {
+    if (header.numComponents == 3) {
+        return readTable<SimTK::Vec3>(file, header, columns);
+    }
+    return readTable<double>(file, header, columns);
+}
+
+template <typename T>
+void write(std::ostream& stream, const T& value) {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeString(std::ostream& stream, const std::string& str) {
+    write(stream, static_cast<std::uint64_t>(str.size()));
+    stream.write(str.data(), str.size());
+}
+
+template <typename T>
+void writeTable(const TimeSeriesTable_<T>& table,
+        const std::string& fileName) {
+    static_assert(sizeof(T) % sizeof(double) == 0,
+            "Expected elements to consist of doubles.");
+    std::ofstream stream(fileName, std::ios::binary);
+    OPENSIM_THROW_IF(!stream.good(), IOError,
+            "Could not open file '{}' for writing.", fileName);
+
+    const auto numRows = static_cast<std::uint64_t>(table.getNumRows());
+    const auto numColumns = static_cast<std::uint64_t>(table.getNumColumns());
+
+    // Only metadata values of type std::string are written.
+    const auto& metaData = table.getTableMetaData();
+    std::vector<std::pair<std::string, std::string>> pairs;
+    for (const auto& key : metaData.getKeys()) {
+        const auto* value = dynamic_cast<const SimTK::Value<std::string>*>(
+                &metaData.getValueForKey(key));
+        if (value) pairs.emplace_back(key, value->get());
+    }
+    const auto labels = numColumns ? table.getColumnLabels()
+                                   : std::vector<std::string>{};
+
+    // Compute the size of the header so the data can be aligned.
+    std::uint64_t headerSize = sizeof(magic) + 4 * sizeof(std::uint32_t) +
+                               4 * sizeof(std::uint64_t);
+    for (const auto& pair : pairs) {
+        headerSize += 2 * sizeof(std::uint64_t) + pair.first.size() +
+                      pair.second.size();
+    }
+    for (const auto& label : labels) {
+        headerSize += sizeof(std::uint64_t) + label.size();
+    }
+    const std::uint64_t dataOffset =
+            (headerSize + sizeof(double) - 1) / sizeof(double) *
+            sizeof(double);
+
+    stream.write(magic, sizeof(magic));
+    write(stream, byteOrderMark);
+    write(stream, versionNumber);
+    write(stream, static_cast<std::uint32_t>(sizeof(T) / sizeof(double)));
+    write(stream, std::uint32_t(0));
+    write(stream, numRows);
+    write(stream, numColumns);
+    write(stream, dataOffset);
+    write(stream, static_cast<std::uint64_t>(pairs.size()));
+    for (const auto& pair : pairs) {
+        writeString(stream, pair.first);
+        writeString(stream, pair.second);
+    }
+    for (const auto& label : labels) writeString(stream, label);
+    for (std::uint64_t i = headerSize; i < dataOffset; ++i) stream.put('\0');
+
+    const auto& time = table.getIndependentColumn();
+    stream.write(reinterpret_cast<const char*>(time.data()),
+            sizeof(double) * numRows);
+    const auto& matrix = table.getMatrix();
+    std::vector<T> column(static_cast<size_t>(numRows));
+    for (int icol = 0; icol < (int)numColumns; ++icol) {
+        const auto& col = matrix.col(icol);
+        for (int irow = 0; irow < (int)numRows; ++irow) column[irow] = col[irow];
+        stream.write(reinterpret_cast<const char*>(column.data()),
+                sizeof(T) * numRows);
+    }
+    OPENSIM_THROW_IF(!stream.good(), IOError,
+            "Error writing file '{}'.", fileName);
+}
+
+} // anonymous namespace
+
+TSBFileAdapter*
+TSBFileAdapter::clone() const {
+    return new TSBFileAdapter{*this};
+}
+
+void
+TSBFileAdapter::write(const TimeSeriesTable& table,
+                      const std::string& fileName) {
+    InputTables tables{};
+    tables.emplace(_table, &table);
+    TSBFileAdapter{}.extendWrite(tables, fileName);
+}
+
+void
+TSBFileAdapter::write(const TimeSeriesTableVec3& table,
+                      const std::string& fileName) {
+    InputTables tables{};
+    tables.emplace(_table, &table);
+    TSBFileAdapter{}.extendWrite(tables, fileName);
+}
+
+std::shared_ptr<AbstractDataTable>
+TSBFileAdapter::readColumns(const std::string& fileName,
+                            const std::vector<std::string>& columnLabels) {
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+    MappedFile file(fileName);
+    OPENSIM_THROW_IF(file.size() == 0,
+                     FileIsEmpty,
+                     fileName);
+    const auto header = readHeader(file, fileName);
+
+    std::vector<size_t> columns;
+    columns.reserve(columnLabels.size());
+    for (const auto& label : columnLabels) {
+        const auto it = std::find(header.columnLabels.begin(),
+                header.columnLabels.end(), label);
+        OPENSIM_THROW_IF(it == header.columnLabels.end(),
+                         KeyNotFound,
+                         label);
+        columns.push_back(it - header.columnLabels.begin());
+    }
+    return readTable(file, header, columns);
+}
+
+TSBFileAdapter::OutputTables
+TSBFileAdapter::extendRead(const std::string& fileName) const {
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+    MappedFile file(fileName);
+    OPENSIM_THROW_IF(file.size() == 0,
+                     FileIsEmpty,
+                     fileName);
+    const auto header = readHeader(file, fileName);
+
+    std::vector<size_t> columns(static_cast<size_t>(header.numColumns));
+    for (size_t i = 0; i < columns.size(); ++i) columns[i] = i;
+
+    OutputTables output_tables{};
+    output_tables.emplace(_table, readTable(file, header, columns));
+    return output_tables;
+}
+
+void
+TSBFileAdapter::extendWrite(const InputTables& absTables,
+                            const std::string& fileName) const {
+    OPENSIM_THROW_IF(absTables.empty(),
+                     NoTableFound);
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+
+    const AbstractDataTable* absTable{};
+    try {
+        absTable = absTables.at(_table);
+    } catch(const std::out_of_range&) {
+        OPENSIM_THROW(KeyMissing,
+                      _table);
+    }
+
+    if (auto table = dynamic_cast<const TimeSeriesTable*>(absTable)) {
+        writeTable(*table, fileName);
+    } else if (auto table =
+            dynamic_cast<const TimeSeriesTableVec3*>(absTable)) {
+        writeTable(*table, fileName);
+    } else {
+        OPENSIM_THROW(IncorrectTableType,
+                      "Expected a TimeSeriesTable or TimeSeriesTableVec3.");
+    }
+}
+
+} // namespace OpenSim
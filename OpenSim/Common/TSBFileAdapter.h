@@ -0,0 +1,104 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  TSBFileAdapter.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_TSB_FILE_ADAPTER_H_
+#define OPENSIM_TSB_FILE_ADAPTER_H_
+
+/** @file
+* TSBFileAdapter is a concrete FileAdapter for reading and writing TSB
+(time-series binary) files. A TSB file stores a TimeSeriesTable (of double) or
+a TimeSeriesTableVec3 without any conversion to text, so values are read back
+exactly and no parsing is needed. The layout of the file is:
+
+   \code
+magic ("OSIMTSB\0")   8 bytes
+byte-order mark       uint32 (0x01020304 in the byte order of the writer)
+version               uint32
+components            uint32 (1 for double, 3 for Vec3)
+reserved              uint32
+number of rows        uint64
+number of columns     uint64
+offset of data        uint64 (bytes from start of file; a multiple of 8)
+metadata              uint64 number of pairs, then (key, value) strings
+column labels         one string per column
+padding               to the offset of data
+time column           number of rows doubles
+column 0              number of rows * components doubles
+column 1              ...
+\endcode
+
+Strings are stored as a uint64 length followed by the characters. Only
+metadata values of type std::string are written (as with STO files). The data
+is stored column by column, and files are read by mapping them into memory,
+so reading a subset of the columns (see readColumns()) only touches the part
+of the file holding those columns.                                           */
+
+#include "FileAdapter.h"
+#include "TimeSeriesTable.h"
+
+namespace OpenSim {
+
+/** TSBFileAdapter is a FileAdapter that reads and writes TSB files. It accepts
+(when writing) and returns (when reading) a table named "table", of type
+TimeSeriesTable or TimeSeriesTableVec3.                                       */
+class OSIMCOMMON_API TSBFileAdapter : public FileAdapter {
+public:
+    TSBFileAdapter()                                 = default;
+    TSBFileAdapter(const TSBFileAdapter&)            = default;
+    TSBFileAdapter(TSBFileAdapter&&)                 = default;
+    TSBFileAdapter& operator=(const TSBFileAdapter&) = default;
+    TSBFileAdapter& operator=(TSBFileAdapter&&)      = default;
+    ~TSBFileAdapter()                                = default;
+
+    TSBFileAdapter* clone() const override;
+
+    /** Write a table to a TSB file.                                          */
+    static
+    void write(const TimeSeriesTable& table, const std::string& fileName);
+    /** Write a table of Vec3 to a TSB file.                                  */
+    static
+    void write(const TimeSeriesTableVec3& table, const std::string& fileName);
+
+    /** Read only the columns with the given labels (in the given order) from
+    a TSB file. The returned table is a TimeSeriesTable or a
+    TimeSeriesTableVec3, depending on the contents of the file, and contains
+    the full time column and the metadata of the file.
+
+    \throws KeyNotFound If a column label is not in the file.                */
+    static std::shared_ptr<AbstractDataTable> readColumns(
+            const std::string& fileName,
+            const std::vector<std::string>& columnLabels);
+
+    /** Key used for table associative array returned/accepted by write/read. */
+    static const std::string _table;
+
+protected:
+    /** Implementation of the read functionality.                             */
+    OutputTables extendRead(const std::string& fileName) const override;
+
+    /** Implementation of the write functionality.                            */
+    void extendWrite(const InputTables& tables,
+                     const std::string& fileName) const override;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_TSB_FILE_ADAPTER_H_
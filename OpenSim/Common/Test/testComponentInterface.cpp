@@ -1205,6 +1205,63 @@ void testTraversePathToComponent() {
     SimTK_TEST(&top.getComponent<Component>("tx/tx") == btx);
 }
 
+void testTraversePathToComponentAfterTopologyChange() {
+    class A : public Component {
+        OpenSim_DECLARE_CONCRETE_OBJECT(A, Component);
+    public:
+        A(const std::string& name) { setName(name); }
+        void clearComponents() {
+            updProperty_components().clear();
+            finalizeFromProperties();
+        }
+    };
+
+    // addComponent() finalizes the owner, so lookups below use the name index
+    // of each component and the cache of absolute paths held by "top".
+    A top("top");
+    A* a1 = new A("a1");
+    top.addComponent(a1);
+    A* a2 = new A("a2");
+    a1->addComponent(a2);
+    top.finalizeFromProperties();
+
+    // Repeated lookups are served from the cache.
+    for (int i = 0; i < 3; ++i) {
+        SimTK_TEST(&top.getComponent("/a1/a2") == a2);
+        SimTK_TEST(&a2->getComponent("/a1") == a1);
+        SimTK_TEST(&top.getComponent("a1/a2/") == a2);
+    }
+
+    // Renaming a component (without finalizing) must not return stale
+    // results from the index or the cache.
+    a1->setName("renamed");
+    SimTK_TEST(!top.hasComponent("/a1/a2"));
+    SimTK_TEST(!top.hasComponent("a1"));
+    SimTK_TEST(&top.getComponent("/renamed/a2") == a2);
+    SimTK_TEST(&top.getComponent("renamed") == a1);
+    a1->setName("a1");
+    SimTK_TEST(&top.getComponent("/a1/a2") == a2);
+
+    // Adding a component.
+    A* a3 = new A("a3");
+    a2->addComponent(a3);
+    SimTK_TEST(&top.getComponent("/a1/a2/a3") == a3);
+    SimTK_TEST(&a3->getComponent("../../a2") == a2);
+
+    // A copy must find its own components, not those of the original.
+    A copy(top);
+    copy.finalizeFromProperties();
+    const Component& copyOfA3 = copy.getComponent("/a1/a2/a3");
+    SimTK_TEST(&copyOfA3 != a3);
+    SimTK_TEST(&copyOfA3.getRoot() == &copy);
+    SimTK_TEST(&top.getComponent("/a1/a2/a3") == a3);
+
+    // Removing a component (by clearing the property that holds it).
+    a2->clearComponents();
+    SimTK_TEST(!top.hasComponent("/a1/a2/a3"));
+    SimTK_TEST(&top.getComponent("/a1/a2") == a2);
+}
+
 void testGetStateVariableValue() {
 
     TheWorld top;
@@ -1238,6 +1295,37 @@ void testGetStateVariableValue() {
     SimTK_TEST_MUST_THROW_EXC(
             top.getStateVariableValue(s, "typo/b/subState"),
             OpenSim::Exception);
+
+    // Handles.
+    const auto handle = b->getStateVariableHandle("../subState");
+    SimTK_TEST(handle.isValid());
+    SimTK_TEST(&handle.getOwner() == a);
+    SimTK_TEST(handle.getName() == "subState");
+    SimTK_TEST(handle.getValue(s) == 20);
+    handle.setValue(s, 25);
+    SimTK_TEST(a->getStateVariableValue(s, "subState") == 25);
+    SimTK_TEST_MUST_THROW_EXC(top.getStateVariableHandle("typo/b/subState"),
+            OpenSim::Exception);
+
+    // Gather and scatter.
+    const auto handles = top.getStateVariableHandles(
+            {"a/b/subState", "internalSub/subState"});
+    SimTK::Vector values;
+    top.getStateVariableValues(s, handles, values);
+    SimTK_TEST(values.size() == 2);
+    SimTK_TEST(values[0] == 30);
+    SimTK_TEST(values[1] == 10);
+    values[0] = 31;
+    values[1] = 11;
+    top.setStateVariableValues(s, handles, values);
+    SimTK_TEST(s.getY()[0] == 11);
+    SimTK_TEST(s.getY()[2] == 31);
+    SimTK_TEST_MUST_THROW_EXC(
+            top.setStateVariableValues(s, handles, SimTK::Vector(3, 0.0)),
+            OpenSim::Exception);
+    std::vector<Component::StateVariableHandle> invalid(1);
+    SimTK_TEST_MUST_THROW_EXC(top.getStateVariableValues(s, invalid, values),
+            OpenSim::Exception);
 }
 
 void testInputOutputConnections()
@@ -2518,6 +2606,7 @@ int main() {
         SimTK_SUBTEST(testComponentPathNames);
         SimTK_SUBTEST(testFindComponent);
         SimTK_SUBTEST(testTraversePathToComponent);
+        SimTK_SUBTEST(testTraversePathToComponentAfterTopologyChange);
         SimTK_SUBTEST(testGetStateVariableValue);
         SimTK_SUBTEST(testInputOutputConnections);
         SimTK_SUBTEST(testInputConnecteePaths);
@@ -175,3 +175,39 @@ TEST_CASE("solveBisection()") {
         REQUIRE_THROWS_AS(solveBisection(parabola, -5, 5), OpenSim::Exception);
     }
 }
+
+TEST_CASE("executeInParallel()") {
+    const int numTasks = 100;
+    SECTION("Each task is run exactly once") {
+        for (int numThreads : {0, 1, 3}) {
+            std::vector<int> counts(numTasks, 0);
+            std::vector<int> threadUsed(numTasks, -1);
+            executeInParallel(numTasks, numThreads,
+                    [&](int itask, int ithread) {
+                        ++counts[itask];
+                        threadUsed[itask] = ithread;
+                    });
+            for (int itask = 0; itask < numTasks; ++itask) {
+                CHECK(counts[itask] == 1);
+                CHECK(threadUsed[itask] >= 0);
+                CHECK(threadUsed[itask] < getNumThreadsToUse(numThreads));
+            }
+        }
+    }
+    SECTION("No tasks") {
+        int count = 0;
+        executeInParallel(0, 4, [&](int, int) { ++count; });
+        CHECK(count == 0);
+    }
+    SECTION("Exceptions are rethrown on the calling thread") {
+        REQUIRE_THROWS_AS(executeInParallel(numTasks, 4,
+                                  [](int itask, int) {
+                                      if (itask == 17) {
+                                          OPENSIM_THROW(Exception, "task 17");
+                                      }
+                                  }),
+                OpenSim::Exception);
+    }
+    CHECK(getNumThreadsToUse(5) == 5);
+    CHECK(getNumThreadsToUse(0) >= 1);
+}
@@ -353,3 +353,111 @@ TEST_CASE("Trimming whitespace in metadata values") {
 
 
 
+TEST_CASE("Streaming STO files in blocks of rows") {
+    const std::string filename = "testSTOFileAdapter_streaming.sto";
+    FileRemover fileRemover(filename);
+
+    TimeSeriesTable table;
+    table.setColumnLabels({"a", "b", "c"});
+    table.addTableMetaData("inDegrees", std::string("no"));
+    for (int i = 0; i < 25; ++i) {
+        SimTK::RowVector row(3);
+        for (int j = 0; j < 3; ++j) row[j] = 0.25 * i - 0.5 * j;
+        table.appendRow(0.125 * i, row);
+    }
+
+    // Write in uneven blocks and compare to reading the file at once.
+    {
+        STOFileWriter writer(filename);
+        TimeSeriesTable block(table);
+        block.trim(0, 1.2);
+        writer.appendTable(block);
+        for (size_t i = 10; i < 24; ++i) {
+            writer.appendRow(table.getIndependentColumn()[i],
+                    table.getRowAtIndex(i));
+        }
+        CHECK_THROWS(writer.appendRow(0.0, table.getRowAtIndex(0)));
+        CHECK_THROWS(writer.appendRow(1.0, SimTK::RowVector(2, 0.0)));
+        writer.appendRow(table.getIndependentColumn()[24],
+                table.getRowAtIndex(24));
+        CHECK(writer.getNumRowsWritten() == 25);
+    }
+    TimeSeriesTable fromFile(filename);
+    CHECK(fromFile.getColumnLabels() == table.getColumnLabels());
+    CHECK(fromFile.getTableMetaDataAsString("inDegrees") == "no");
+    CHECK(fromFile.getIndependentColumn() == table.getIndependentColumn());
+    CHECK(fromFile.getMatrix().nrow() == 25);
+    for (int i = 0; i < 25; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            CHECK(fromFile.getMatrix()(i, j) == table.getMatrix()(i, j));
+        }
+    }
+
+    STOFileReader reader(filename, 10);
+    CHECK(reader.getColumnLabels() == table.getColumnLabels());
+    std::vector<size_t> blockSizes;
+    size_t offset = 0;
+    for (const auto& block : reader) {
+        blockSizes.push_back(block.getNumRows());
+        CHECK(block.getTableMetaDataAsString("inDegrees") == "no");
+        for (size_t i = 0; i < block.getNumRows(); ++i) {
+            CHECK(block.getIndependentColumn()[i] ==
+                    fromFile.getIndependentColumn()[offset + i]);
+            for (int j = 0; j < 3; ++j) {
+                CHECK(block.getRowAtIndex(i)[j] ==
+                        fromFile.getRowAtIndex(offset + i)[j]);
+            }
+        }
+        offset += block.getNumRows();
+    }
+    CHECK((blockSizes == std::vector<size_t>{10, 10, 5}));
+}
+
+TEST_CASE("Parsing STO files in place matches parsing line by line") {
+    // STOFileReader_ parses each line with readRow(), while
+    // TimeSeriesTable_(filename) parses the whole file in place (on multiple
+    // threads, since there are more than 10000 rows).
+    const std::string filename = "testSTOFileAdapter_parsing.sto";
+    FileRemover fileRemover(filename);
+    {
+        TimeSeriesTableVec3 table;
+        table.setColumnLabels({"a", "b"});
+        for (int i = 0; i < 25000; ++i) {
+            const double x = std::sin(0.001 * i) / 3.0;
+            table.appendRow(1e-3 * i, {SimTK::Vec3(x, -x, 1e-7 * x),
+                                       SimTK::Vec3(SimTK::NaN, x, 1e5 * x)});
+        }
+        STOFileAdapterVec3::write(table, filename);
+    }
+    TimeSeriesTableVec3 fromFile(filename);
+    REQUIRE(fromFile.getNumRows() == 25000);
+
+    STOFileReader_<SimTK::Vec3> reader(filename, 25000);
+    TimeSeriesTableVec3 lineByLine;
+    REQUIRE(reader.readNextBlock(lineByLine));
+    CHECK(fromFile.getIndependentColumn() ==
+            lineByLine.getIndependentColumn());
+    int numMismatches = 0;
+    for (int i = 0; i < 25000; ++i) {
+        for (int j = 0; j < 2; ++j) {
+            const auto& a = fromFile.getMatrix()(i, j);
+            const auto& b = lineByLine.getMatrix()(i, j);
+            for (int k = 0; k < 3; ++k) {
+                const bool same = SimTK::isNaN(a[k]) ? SimTK::isNaN(b[k])
+                                                     : a[k] == b[k];
+                if (!same) ++numMismatches;
+            }
+        }
+    }
+    CHECK(numMismatches == 0);
+
+    // Errors are still reported with the line number.
+    const std::string badFilename = "testSTOFileAdapter_badrow.sto";
+    FileRemover badFileRemover(badFilename);
+    {
+        std::ofstream stream(badFilename);
+        stream << "DataType=double\nversion=3\nendheader\n"
+               << "time\ta\tb\n0\t1\t2\n0.1\t3\n";
+    }
+    CHECK_THROWS_AS(TimeSeriesTable(badFilename), RowLengthMismatch);
+}
@@ -1118,6 +1118,122 @@ void testMuscleCurveC2Continuity(SmoothSegmentedFunction mcf,
     cout << endl;
 }
 
+/*
+ The batch evaluation functions must match the scalar ones, both within the
+ curve domain and in the linear extrapolation regions.
+*/
+void testMuscleCurveBatchEvaluation(SmoothSegmentedFunction mcf,
+                                    SimTK::Matrix mcfSample)
+{
+    cout << "   TEST: Batch evaluation " << endl;
+    double tol = 1e-9;
+
+    SimTK::Vector x = mcfSample(0);
+    SimTK::Vector y, dydx, d2ydx2, d3ydx3, yBoth, dydxBoth;
+    mcf.calcValues(x, y);
+    mcf.calcDerivatives(x, 1, dydx);
+    mcf.calcDerivatives(x, 2, d2ydx2);
+    mcf.calcDerivatives(x, 3, d3ydx3);
+    mcf.calcValuesAndDerivatives(x, yBoth, dydxBoth);
+
+    SimTK_TEST(y.size() == x.size());
+    for(int i = 0; i < x.size(); ++i){
+        double scale = std::max(1.0, std::abs(mcf.calcDerivative(x(i),2)));
+        SimTK_TEST_EQ_TOL(y(i),       mcf.calcValue(x(i)),        tol);
+        SimTK_TEST_EQ_TOL(yBoth(i),   mcf.calcValue(x(i)),        tol);
+        SimTK_TEST_EQ_TOL(dydx(i),    mcf.calcDerivative(x(i),1), tol);
+        SimTK_TEST_EQ_TOL(dydxBoth(i),mcf.calcDerivative(x(i),1), tol);
+        SimTK_TEST_EQ_TOL(d2ydx2(i),  mcf.calcDerivative(x(i),2), 
+                          tol*scale);
+        SimTK_TEST_EQ_TOL(d3ydx3(i),  mcf.calcDerivative(x(i),3), 
+                          tol*std::max(1.0, 
+                          std::abs(mcf.calcDerivative(x(i),3))));
+    }
+    SimTK_TEST_MUST_THROW(mcf.calcDerivatives(x, 7, dydx));
+
+    printf("   passed: batch evaluation matches scalar evaluation at %i "
+           "points\n", x.size());
+    cout << endl;
+}
+
+/*
+ The lookup table must reproduce the curve and its first two derivatives to
+ within the requested tolerance, including at points other than the ones it
+ was checked at during construction, and must leave the linear extrapolation
+ and the higher derivatives untouched.
+*/
+void testMuscleCurveLookupTable(SmoothSegmentedFunction mcf,
+                                SimTK::Matrix mcfSample)
+{
+    cout << "   TEST: Lookup table " << endl;
+    double tol = 1e-8;
+    SmoothSegmentedFunction exact = mcf;
+
+    SimTK_TEST(!mcf.isLookupTableBuilt());
+    SimTK_TEST(mcf.getLookupTableSize() == 0);
+    SimTK_TEST_MUST_THROW(mcf.buildLookupTable(0));
+
+    mcf.buildLookupTable(tol);
+    int tableSize = mcf.getLookupTableSize();
+    SimTK_TEST(mcf.isLookupTableBuilt());
+    SimTK_TEST(tableSize > 0);
+    SimTK_TEST_EQ(mcf.getLookupTableTolerance(), tol);
+    SimTK_TEST(mcf.getLookupTableError()[0] <= tol);
+
+    // Sample densely, and offset from the knots of the table.
+    SimTK::Vec2 domain = mcf.getCurveDomain();
+    int n = 1001;
+    SimTK::Vector x(n);
+    for(int i = 0; i < n; ++i){
+        x(i) = domain(0) + (domain(1)-domain(0))*(i + 0.37)/n;
+    }
+    double scale1 = 1, scale2 = 1;
+    for(int i = 0; i < n; ++i){
+        scale1 = std::max(scale1, std::abs(exact.calcDerivative(x(i),1)));
+        scale2 = std::max(scale2, std::abs(exact.calcDerivative(x(i),2)));
+    }
+    // The table is only checked at its midpoints and quarter points, so allow
+    // a small margin on the tolerance elsewhere.
+    double margin = 4;
+    for(int i = 0; i < n; ++i){
+        SimTK_TEST_EQ_TOL(mcf.calcValue(x(i)), exact.calcValue(x(i)),
+                          margin*tol);
+        SimTK_TEST_EQ_TOL(mcf.calcDerivative(x(i),1),
+                          exact.calcDerivative(x(i),1), margin*tol*scale1);
+        SimTK_TEST_EQ_TOL(mcf.calcDerivative(x(i),2),
+                          exact.calcDerivative(x(i),2), margin*tol*scale2);
+        SimTK_TEST_EQ(mcf.calcDerivative(x(i),3),
+                      exact.calcDerivative(x(i),3));
+    }
+
+    // The batch functions use the table too.
+    SimTK::Vector y, dydx;
+    mcf.calcValuesAndDerivatives(x, y, dydx);
+    for(int i = 0; i < n; ++i){
+        SimTK_TEST_EQ(y(i), mcf.calcValue(x(i)));
+        SimTK_TEST_EQ(dydx(i), mcf.calcDerivative(x(i),1));
+    }
+
+    // The linear extrapolation is unchanged.
+    SimTK::Vector xOut = mcfSample(0);
+    for(int i = 0; i < xOut.size(); ++i){
+        if(xOut(i) < domain(0) || xOut(i) > domain(1)){
+            SimTK_TEST_EQ(mcf.calcValue(xOut(i)), exact.calcValue(xOut(i)));
+            SimTK_TEST_EQ(mcf.calcDerivative(xOut(i),1),
+                          exact.calcDerivative(xOut(i),1));
+        }
+    }
+
+    mcf.clearLookupTable();
+    SimTK_TEST(!mcf.isLookupTableBuilt());
+    SimTK_TEST(SimTK::isNaN(mcf.getLookupTableTolerance()));
+    SimTK_TEST_EQ(mcf.calcValue(x(n/2)), exact.calcValue(x(n/2)));
+
+    printf("   passed: lookup table of %i intervals is within %e of the "
+           "curve\n", tableSize, tol);
+    cout << endl;
+}
+
 /*
  4. The MuscleCurveFunctions which are supposed to be monotonic will be
     tested for monotonicity.
@@ -1217,6 +1333,8 @@ int main(int argc, char* argv[])
 
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(tendonCurve,tendonCurveSample);
+            testMuscleCurveBatchEvaluation(tendonCurve,tendonCurveSample);
+            testMuscleCurveLookupTable(tendonCurve,tendonCurveSample);
         //4. Test for monotonicity where appropriate
             testMonotonicity(tendonCurveSample);
 
@@ -1286,6 +1404,8 @@ int main(int argc, char* argv[])
 
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(fiberFLCurve,fiberFLCurveSample);
+            testMuscleCurveBatchEvaluation(fiberFLCurve,fiberFLCurveSample);
+            testMuscleCurveLookupTable(fiberFLCurve,fiberFLCurveSample);
         //4. Test for monotonicity where appropriate
 
             testMonotonicity(fiberFLCurveSample);
@@ -1355,6 +1475,8 @@ int main(int argc, char* argv[])
 
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(fiberCECurve,fiberCECurveSample);
+            testMuscleCurveBatchEvaluation(fiberCECurve,fiberCECurveSample);
+            testMuscleCurveLookupTable(fiberCECurve,fiberCECurveSample);
         //4. Test for monotonicity where appropriate
 
             testMonotonicity(fiberCECurveSample);
@@ -1420,6 +1542,8 @@ int main(int argc, char* argv[])
 
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(fiberCEPhiCurve,fiberCEPhiCurveSample);
+            testMuscleCurveBatchEvaluation(fiberCEPhiCurve,fiberCEPhiCurveSample);
+            testMuscleCurveLookupTable(fiberCEPhiCurve,fiberCEPhiCurveSample);
         //4. Test for monotonicity where appropriate
             testMonotonicity(fiberCEPhiCurveSample);
         //5. Testing Exceptions
@@ -1492,6 +1616,8 @@ int main(int argc, char* argv[])
 
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(fiberCECosPhiCurve,fiberCECosPhiCurveSample);
+            testMuscleCurveBatchEvaluation(fiberCECosPhiCurve,fiberCECosPhiCurveSample);
+            testMuscleCurveLookupTable(fiberCECosPhiCurve,fiberCECosPhiCurveSample);
         //4. Test for monotonicity where appropriate
 
             testMonotonicity(fiberCECosPhiCurveSample);
@@ -1582,6 +1708,8 @@ int main(int argc, char* argv[])
 
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(fiberFVCurve,fiberFVCurveSample);
+            testMuscleCurveBatchEvaluation(fiberFVCurve,fiberFVCurveSample);
+            testMuscleCurveLookupTable(fiberFVCurve,fiberFVCurveSample);
         //4. Test for monotonicity where appropriate
 
             testMonotonicity(fiberFVCurveSample);
@@ -1693,6 +1821,8 @@ int main(int argc, char* argv[])
 
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(fiberFVInvCurve,fiberFVInvCurveSample);
+            testMuscleCurveBatchEvaluation(fiberFVInvCurve,fiberFVInvCurveSample);
+            testMuscleCurveLookupTable(fiberFVInvCurve,fiberFVInvCurveSample);
         //4. Test for monotonicity where appropriate
 
             testMonotonicity(fiberFVInvCurveSample);
@@ -1842,6 +1972,8 @@ int main(int argc, char* argv[])
 
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(fiberfalCurve,fiberfalCurveSample);
+            testMuscleCurveBatchEvaluation(fiberfalCurve,fiberfalCurveSample);
+            testMuscleCurveLookupTable(fiberfalCurve,fiberfalCurveSample);
 
             //fiberfalCurve.MuscleCurveToCSVFile("C:/mjhmilla/Stanford/dev");
        
@@ -23,6 +23,7 @@
 #include "OpenSim/Common/Adapters.h"
 #include <OpenSim/Common/IO.h>
 
+#include <cmath>
 #include <fstream>
 #include <cstdio>
 
@@ -204,6 +205,59 @@ int main() {
     SimTK_TEST_MUST_THROW_EXC(table.trim(.02, 0), OpenSim::EmptyTable);
     
     std::remove(("trimmed_" + tmpfile).c_str());
+
+    // Files with more than 10000 rows are parsed on multiple threads.
+    std::cout << "Testing TRCFileAdapter::read() of a large file" << std::endl;
+    {
+        const int numRows = 25000;
+        TimeSeriesTableVec3 large;
+        large.setColumnLabels({"a", "b"});
+        for (int i = 0; i < numRows; ++i) {
+            const double x = std::sin(0.001 * i) / 3.0;
+            large.appendRow(1e-3 * i, {SimTK::Vec3(x, -x, 1e-7 * x),
+                    i % 7 ? SimTK::Vec3(1e5 * x) : SimTK::Vec3(SimTK::NaN)});
+        }
+        large.updTableMetaData().setValueForKey("DataRate",
+                std::string{"1000"});
+        large.updTableMetaData().setValueForKey("Units", std::string{"m"});
+        TRCFileAdapter::write(large, tmpfile);
+        TimeSeriesTableVec3 fromFile{tmpfile};
+        OPENSIM_THROW_IF(fromFile.getNumRows() != numRows, OpenSim::Exception,
+                "Large table has wrong size");
+        // The file is written with limited precision, so compare the values
+        // with those parsed line by line.
+        std::ifstream stream{tmpfile};
+        for (int i = 0; i < 6; ++i) FileAdapter::getNextLine(stream, "\t");
+        for (int i = 0; i < numRows; ++i) {
+            auto tokens = FileAdapter::getNextLine(stream, "\t\r");
+            SimTK_TEST(fromFile.getIndependentColumn()[i] ==
+                    std::stod(tokens.at(1)));
+            for (int j = 0; j < 2; ++j) {
+                const auto& location = fromFile.getMatrix()(i, j);
+                for (int k = 0; k < 3; ++k) {
+                    const std::string& token = tokens.at(2 + 3 * j + k);
+                    if (token.empty() || SimTK::isNaN(std::stod(token)))
+                        SimTK_TEST(SimTK::isNaN(location[k]));
+                    else
+                        SimTK_TEST(location[k] == std::stod(token));
+                }
+            }
+        }
+    }
+
+    // Errors are still reported with the line number.
+    {
+        std::ifstream original{tmpfile};
+        std::ofstream bad{"bad_" + tmpfile};
+        std::string line;
+        for (int i = 0; i < 20 && std::getline(original, line); ++i)
+            bad << line << "\n";
+        bad << "20\t0.02\t1\t2\n";
+    }
+    SimTK_TEST_MUST_THROW_EXC(TimeSeriesTableVec3("bad_" + tmpfile),
+            OpenSim::RowLengthMismatch);
+    std::remove(("bad_" + tmpfile).c_str());
+
     std::remove(tmpfile.c_str());
     std::cout << "\nAll tests passed!" << std::endl;
 
@@ -0,0 +1,119 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  testTSBFileAdapter.cpp                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "OpenSim/Common/Adapters.h"
+#include "OpenSim/Common/CommonUtilities.h"
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch.hpp>
+
+using namespace OpenSim;
+
+namespace {
+// NaN (e.g., missing markers) compares equal to NaN.
+bool isSame(double a, double b) {
+    return a == b || (SimTK::isNaN(a) && SimTK::isNaN(b));
+}
+bool isSame(const SimTK::Vec3& a, const SimTK::Vec3& b) {
+    return isSame(a[0], b[0]) && isSame(a[1], b[1]) && isSame(a[2], b[2]);
+}
+template <typename T>
+void checkColumnsMatch(const TimeSeriesTable_<T>& expected,
+        const TimeSeriesTable_<T>& actual) {
+    REQUIRE(expected.getNumRows() == actual.getNumRows());
+    CHECK(expected.getIndependentColumn() == actual.getIndependentColumn());
+    for (const auto& label : actual.getColumnLabels()) {
+        const auto& colExp = expected.getDependentColumn(label);
+        const auto& colAct = actual.getDependentColumn(label);
+        for (int i = 0; i < colExp.size(); ++i) {
+            CHECK(isSame(colExp[i], colAct[i]));
+        }
+    }
+}
+}
+
+TEST_CASE("TSBFileAdapter round trip of a TimeSeriesTable") {
+    const std::string filename = "testTSBFileAdapter_double.tsb";
+    FileRemover fileRemover(filename);
+
+    TimeSeriesTable table;
+    table.setColumnLabels({"hip_flexion", "knee_angle", "ankle_angle"});
+    table.addTableMetaData("inDegrees", std::string("yes"));
+    for (int i = 0; i < 11; ++i) {
+        // Values that cannot be represented exactly with 16 digits of text.
+        SimTK::RowVector row(3);
+        for (int j = 0; j < 3; ++j) row[j] = std::sin(0.1 * i + j) / 3.0;
+        table.appendRow(0.01 * i, row);
+    }
+    table.updMatrix()(4, 1) = SimTK::NaN;
+
+    // Use the extension registry, as TimeSeriesTable(filename) does.
+    DataAdapter::InputTables tables{};
+    tables.emplace(TSBFileAdapter::_table, &table);
+    FileAdapter::writeFile(tables, filename);
+
+    TimeSeriesTable fromFile(filename);
+    CHECK(fromFile.getColumnLabels() == table.getColumnLabels());
+    CHECK(fromFile.getTableMetaDataAsString("inDegrees") == "yes");
+    checkColumnsMatch(table, fromFile);
+
+    SECTION("Reading a subset of the columns") {
+        auto absTable = TSBFileAdapter::readColumns(filename,
+                {"ankle_angle", "hip_flexion"});
+        auto* subset = dynamic_cast<TimeSeriesTable*>(absTable.get());
+        REQUIRE(subset != nullptr);
+        CHECK(subset->getColumnLabels() ==
+                std::vector<std::string>({"ankle_angle", "hip_flexion"}));
+        checkColumnsMatch(table, *subset);
+        CHECK_THROWS_AS(TSBFileAdapter::readColumns(filename, {"nonexistent"}),
+                KeyNotFound);
+    }
+
+    SECTION("Reading as the wrong type fails") {
+        CHECK_THROWS_AS(TimeSeriesTableVec3(filename), InvalidArgument);
+    }
+}
+
+TEST_CASE("TSBFileAdapter round trip of a TimeSeriesTableVec3") {
+    const std::string filename = "testTSBFileAdapter_markers.tsb";
+    FileRemover fileRemover(filename);
+
+    TimeSeriesTableVec3 markers("exampleFormat.trc");
+    TSBFileAdapter::write(markers, filename);
+    TimeSeriesTableVec3 fromFile(filename);
+    CHECK(fromFile.getColumnLabels() == markers.getColumnLabels());
+    CHECK(fromFile.getTableMetaDataAsString("Units") ==
+            markers.getTableMetaDataAsString("Units"));
+    checkColumnsMatch(markers, fromFile);
+}
+
+TEST_CASE("TSBFileAdapter rejects files that are not TSB files") {
+    CHECK_THROWS_AS(TimeSeriesTable("nonexistent.tsb"), FileDoesNotExist);
+
+    const std::string filename = "testTSBFileAdapter_invalid.tsb";
+    FileRemover fileRemover(filename);
+    {
+        std::ofstream stream(filename);
+        stream << "time\ta\n0\t1\n";
+    }
+    CHECK_THROWS_AS(TimeSeriesTable(filename), IOError);
+}
@@ -20,6 +20,9 @@
 
 #include "CasOCProblem.h"
 
+#include <limits>
+#include <numeric>
+
 using namespace CasOC;
 
 casadi::Sparsity calcJacobianSparsityWithPerturbation(const VectorDM& x0s,
@@ -73,35 +76,199 @@ casadi::Sparsity calcJacobianSparsityWithPerturbation(const VectorDM& x0s,
     return combinedSparsity;
 }
 
-casadi::Sparsity Function::get_jacobian_sparsity() const {
-    using casadi::DM;
+VectorDM Function::splitInput(const casadi::DM& x) const {
     using casadi::Slice;
+    std::vector<casadi::DM> in(this->n_in());
+    int offset = 0;
+    for (int iin = 0; iin < this->n_in(); ++iin) {
+        OPENSIM_THROW_IF(this->size2_in(iin) != 1, OpenSim::Exception,
+                "Internal error.");
+        const auto size = this->size1_in(iin);
+        in[iin] = x(Slice(offset, offset + size));
+        offset += size;
+    }
+    return in;
+}
+
+void Function::evalConcatenated(const casadi::DM& x, casadi::DM& y) const {
+    std::vector<casadi::DM> out = this->eval(splitInput(x));
+    y = casadi::DM::veccat(out);
+}
+
+casadi::Sparsity Function::get_jacobian_sparsity() const {
+    if (!m_jacobianSparsityIsCached) {
+        auto function = [this](const casadi::DM& x, casadi::DM& y) {
+            evalConcatenated(x, y);
+        };
+        const VectorDM x0s = getSubsetPointsForSparsityDetection();
+        m_jacobianSparsity = calcJacobianSparsityWithPerturbation(
+                x0s, (int)this->nnz_out(), function);
+        m_jacobianSparsityIsCached = true;
+    }
+    return m_jacobianSparsity;
+}
+
+casadi::Sparsity Function::getJacobianSparsity() const {
+    if (has_jacobian_sparsity()) return get_jacobian_sparsity();
+    return casadi::Sparsity::dense(this->nnz_out(), this->nnz_in());
+}
+
+bool Function::has_jacobian() const {
+    return m_casProblem->getJacobianMode() != "casadi";
+}
 
-    auto function = [this](const casadi::DM& x, casadi::DM& y) {
-        // Split input into separate DMs.
-        std::vector<casadi::DM> in(this->n_in());
-        {
-            int offset = 0;
-            for (int iin = 0; iin < this->n_in(); ++iin) {
-                OPENSIM_THROW_IF(this->size2_in(iin) != 1, OpenSim::Exception,
-                        "Internal error.");
-                const auto size = this->size1_in(iin);
-                in[iin] = x(Slice(offset, offset + size));
-                offset += size;
+casadi::Function Function::get_jacobian(const std::string& name,
+        const std::vector<std::string>& inames,
+        const std::vector<std::string>& onames,
+        const casadi::Dict& opts) const {
+    m_jacobianFunctions.push_back(OpenSim::make_unique<FunctionJacobian>());
+    m_jacobianFunctions.back()->constructFunction(
+            this, name, inames, onames, opts);
+    return *m_jacobianFunctions.back();
+}
+
+void Function::calcJacobian(const casadi::DM& x, casadi::DM& jacobian) const {
+    std::vector<casadi_int> columns(jacobian.size2());
+    std::iota(columns.begin(), columns.end(), 0);
+    calcFiniteDifferenceJacobian(x, columns, jacobian);
+}
+
+std::vector<std::vector<casadi_int>> Function::colorColumns(
+        const casadi::Sparsity& sparsity,
+        const std::vector<casadi_int>& columns) {
+    // Greedy coloring: assign each column to the first group with which it
+    // shares no rows.
+    const casadi_int* colind = sparsity.colind();
+    const casadi_int* row = sparsity.row();
+    std::vector<std::vector<casadi_int>> groups;
+    std::vector<std::vector<bool>> rowsInGroup;
+    for (const auto& j : columns) {
+        // Structurally zero columns need not be evaluated.
+        if (colind[j] == colind[j + 1]) continue;
+        int igroup = 0;
+        for (; igroup < (int)groups.size(); ++igroup) {
+            bool conflict = false;
+            for (casadi_int k = colind[j]; k < colind[j + 1]; ++k) {
+                if (rowsInGroup[igroup][row[k]]) {
+                    conflict = true;
+                    break;
+                }
             }
+            if (!conflict) break;
+        }
+        if (igroup == (int)groups.size()) {
+            groups.emplace_back();
+            rowsInGroup.emplace_back(sparsity.size1(), false);
+        }
+        groups[igroup].push_back(j);
+        for (casadi_int k = colind[j]; k < colind[j + 1]; ++k) {
+            rowsInGroup[igroup][row[k]] = true;
         }
+    }
+    return groups;
+}
 
-        // Evaluate the function.
-        std::vector<casadi::DM> out = this->eval(in);
+void Function::calcFiniteDifferenceJacobian(const casadi::DM& x0,
+        const std::vector<casadi_int>& columns, casadi::DM& jacobian) const {
+    const std::string& scheme = m_finite_difference_scheme;
+    // These step sizes balance truncation and roundoff error.
+    const double eps = std::numeric_limits<double>::epsilon();
+    const double relativeStep =
+            scheme == "central" ? std::cbrt(eps) : std::sqrt(eps);
+    const casadi_int* colind = jacobian.sparsity().colind();
+    const casadi_int* row = jacobian.sparsity().row();
+    std::vector<double>& jac = jacobian.nonzeros();
 
-        // Create output.
-        y = casadi::DM::veccat(out);
-    };
+    // Columns in the same group are perturbed simultaneously. Without
+    // coloring, each column is perturbed on its own.
+    std::vector<std::vector<casadi_int>> groups;
+    if (m_casProblem->getJacobianMode() == "colored") {
+        groups = colorColumns(jacobian.sparsity(), columns);
+    } else {
+        for (const auto& j : columns) {
+            if (colind[j] != colind[j + 1]) groups.push_back({j});
+        }
+    }
 
-    const VectorDM x0s = getSubsetPointsForSparsityDetection();
+    casadi::DM x = x0;
+    casadi::DM y0;
+    casadi::DM yPlus;
+    casadi::DM yMinus;
+    if (scheme != "central") evalConcatenated(x0, y0);
+    std::vector<double> steps;
+    for (const auto& group : groups) {
+        steps.resize(group.size());
+        for (int ig = 0; ig < (int)group.size(); ++ig) {
+            steps[ig] = relativeStep *
+                        std::max(1.0, std::abs(x0.ptr()[group[ig]]));
+        }
+        auto perturb = [&](double direction) {
+            for (int ig = 0; ig < (int)group.size(); ++ig) {
+                x.ptr()[group[ig]] =
+                        x0.ptr()[group[ig]] + direction * steps[ig];
+            }
+        };
+        double factor = 1;
+        if (scheme == "central") {
+            perturb(1);
+            evalConcatenated(x, yPlus);
+            perturb(-1);
+            evalConcatenated(x, yMinus);
+            factor = 2;
+        } else if (scheme == "forward") {
+            perturb(1);
+            evalConcatenated(x, yPlus);
+            yMinus = y0;
+        } else {
+            yPlus = y0;
+            perturb(-1);
+            evalConcatenated(x, yMinus);
+        }
+        perturb(0);
+        // The columns in a group share no rows, so each difference belongs
+        // to a single column.
+        for (int ig = 0; ig < (int)group.size(); ++ig) {
+            const casadi_int j = group[ig];
+            const double denom = factor * steps[ig];
+            for (casadi_int k = colind[j]; k < colind[j + 1]; ++k) {
+                jac[k] = (yPlus.ptr()[row[k]] - yMinus.ptr()[row[k]]) / denom;
+            }
+        }
+    }
+}
 
-    return calcJacobianSparsityWithPerturbation(
-            x0s, (int)this->nnz_out(), function);
+void FunctionJacobian::constructFunction(const Function* function,
+        const std::string& name, const std::vector<std::string>& inames,
+        const std::vector<std::string>& onames, const casadi::Dict& opts) {
+    m_function = function;
+    m_inames = inames;
+    m_onames = onames;
+    casadi::Dict jacOpts = opts;
+    // Second derivatives (only needed for an exact Hessian) are computed by
+    // CasADi using finite differences of the Jacobian.
+    jacOpts["enable_fd"] = true;
+    jacOpts["fd_method"] = function->getFiniteDifferenceScheme();
+    this->construct(name, jacOpts);
+}
+
+casadi::Sparsity FunctionJacobian::get_sparsity_in(casadi_int i) {
+    // The inputs are the nominal inputs followed by the nominal outputs.
+    const casadi_int numInputs = m_function->n_in();
+    if (i < numInputs) return m_function->sparsity_in(i);
+    return m_function->sparsity_out(i - numInputs);
+}
+
+casadi::Sparsity FunctionJacobian::get_sparsity_out(casadi_int i) {
+    if (i == 0) return m_function->getJacobianSparsity();
+    return casadi::Sparsity(0, 0);
+}
+
+VectorDM FunctionJacobian::eval(const VectorDM& args) const {
+    // The nominal outputs are not needed.
+    const VectorDM inputs(args.begin(), args.begin() + m_function->n_in());
+    VectorDM out{casadi::DM(sparsity_out(0))};
+    m_function->calcJacobian(casadi::DM::veccat(inputs), out[0]);
+    return out;
 }
 
 void Function::constructFunction(const Problem* casProblem,
@@ -330,5 +497,63 @@ VectorDM MultibodySystemImplicit<CalcKCErrors>::eval(
     return out;
 }
 
+template <bool CalcKCErrors>
+void MultibodySystemImplicit<CalcKCErrors>::calcJacobian(
+        const casadi::DM& x, casadi::DM& jacobian) const {
+    // The accelerations are the first entries of the derivatives input.
+    const casadi_int numAccelerations = m_casProblem->getNumAccelerations();
+    const casadi_int accelOffset = 1 + m_casProblem->getNumStates() +
+                                   m_casProblem->getNumControls() +
+                                   m_casProblem->getNumMultipliers();
+    // Acceleration-level kinematic constraint errors also depend on the
+    // accelerations; we leave those to finite differences.
+    const bool accelerationsAffectConstraintErrors =
+            CalcKCErrors && m_casProblem->getNumMultipliers();
+
+    casadi::DM massMatrix;
+    if (!numAccelerations || accelerationsAffectConstraintErrors) {
+        Function::calcJacobian(x, jacobian);
+        return;
+    }
+    const VectorDM in = splitInput(x);
+    Problem::ContinuousInput input{in.at(0).scalar(), in.at(1), in.at(2),
+            in.at(3), in.at(4), in.at(5)};
+    if (!m_casProblem->calcMassMatrix(input, massMatrix)) {
+        Function::calcJacobian(x, jacobian);
+        return;
+    }
+
+    // The derivatives of the multibody residuals (the first rows) with
+    // respect to the accelerations are the mass matrix. The other outputs
+    // (e.g., auxiliary residuals) may also depend on the accelerations, so
+    // the acceleration columns in which the sparsity pattern has nonzeros
+    // outside of the residual rows are still computed by finite differences.
+    const casadi_int numResiduals =
+            m_casProblem->getNumMultibodyDynamicsEquations();
+    const casadi_int* colind = jacobian.sparsity().colind();
+    const casadi_int* row = jacobian.sparsity().row();
+    std::vector<casadi_int> columns;
+    for (casadi_int j = 0; j < jacobian.size2(); ++j) {
+        bool finiteDifference =
+                j < accelOffset || j >= accelOffset + numAccelerations;
+        for (casadi_int k = colind[j]; k < colind[j + 1] && !finiteDifference;
+                ++k) {
+            finiteDifference = row[k] >= numResiduals;
+        }
+        if (finiteDifference) columns.push_back(j);
+    }
+    calcFiniteDifferenceJacobian(x, columns, jacobian);
+
+    std::vector<double>& jac = jacobian.nonzeros();
+    for (casadi_int j = 0; j < numAccelerations; ++j) {
+        const casadi_int col = accelOffset + j;
+        for (casadi_int k = colind[col]; k < colind[col + 1]; ++k) {
+            if (row[k] < numResiduals) {
+                jac[k] = massMatrix.ptr()[row[k] + j * massMatrix.size1()];
+            }
+        }
+    }
+}
+
 template class CasOC::MultibodySystemImplicit<false>;
 template class CasOC::MultibodySystemImplicit<true>;
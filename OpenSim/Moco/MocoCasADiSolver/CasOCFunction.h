@@ -25,9 +25,33 @@
 namespace CasOC {
 
 class Problem;
+class Function;
 
 using VectorDM = std::vector<casadi::DM>;
 
+/// The Jacobian of a CasOC::Function, which CasADi obtains from
+/// Function::get_jacobian(). The inputs are the inputs and outputs of the
+/// function, and the single output is the Jacobian of all nonzeros of the
+/// function's outputs with respect to all nonzeros of its inputs.
+class FunctionJacobian : public casadi::Callback {
+public:
+    void constructFunction(const Function* function, const std::string& name,
+            const std::vector<std::string>& inames,
+            const std::vector<std::string>& onames, const casadi::Dict& opts);
+    casadi_int get_n_in() override { return (casadi_int)m_inames.size(); }
+    casadi_int get_n_out() override { return 1; }
+    std::string get_name_in(casadi_int i) override { return m_inames.at(i); }
+    std::string get_name_out(casadi_int i) override { return m_onames.at(i); }
+    casadi::Sparsity get_sparsity_in(casadi_int i) override;
+    casadi::Sparsity get_sparsity_out(casadi_int i) override;
+    VectorDM eval(const VectorDM& args) const override;
+
+private:
+    const Function* m_function = nullptr;
+    std::vector<std::string> m_inames;
+    std::vector<std::string> m_onames;
+};
+
 class Function : public casadi::Callback {
 public:
     virtual ~Function() = default;
@@ -36,13 +60,14 @@ public:
             std::shared_ptr<const std::vector<VariablesDM>>
                     pointsForSparsityDetection);
     void setCommonOptions(casadi::Dict& opts) {
-        // Compute the derivatives of this function using finite differences.
-        opts["enable_fd"] = true;
+        // Compute the derivatives of this function using finite differences,
+        // unless we provide the Jacobian ourselves (see get_jacobian()).
+        opts["enable_fd"] = !has_jacobian();
         opts["fd_method"] = getFiniteDifferenceScheme();
         // Using "forward", iterations are 10x faster but problems are less
         // likely to converge.
     }
-    std::string getFiniteDifferenceScheme() {
+    std::string getFiniteDifferenceScheme() const {
         return m_finite_difference_scheme;
     }
     casadi_int get_n_in() override { return 6; }
@@ -63,7 +88,48 @@ public:
     }
     casadi::Sparsity get_jacobian_sparsity() const override;
 
+    /// If the problem's Jacobian mode is not "casadi", we compute the Jacobian
+    /// of this function in a single callback (calcJacobian()) instead of
+    /// letting CasADi perturb the function one direction at a time.
+    bool has_jacobian() const override;
+    casadi::Function get_jacobian(const std::string& name,
+            const std::vector<std::string>& inames,
+            const std::vector<std::string>& onames,
+            const casadi::Dict& opts) const override;
+
+    /// The sparsity of the Jacobian computed by calcJacobian(): the detected
+    /// sparsity if sparsity detection is enabled, and dense otherwise.
+    casadi::Sparsity getJacobianSparsity() const;
+
+    /// Compute the Jacobian of this function at x, the concatenation of all
+    /// inputs. The sparsity of `jacobian` is given by getJacobianSparsity()
+    /// and only its nonzeros are computed. The default implementation uses
+    /// finite differences; derived classes can override this to supply
+    /// analytic blocks of the Jacobian.
+    virtual void calcJacobian(const casadi::DM& x, casadi::DM& jacobian) const;
+
 protected:
+    /// Compute the columns of the Jacobian with the given indices using
+    /// finite differences (see getFiniteDifferenceScheme()). If the Jacobian
+    /// mode is "colored", structurally orthogonal columns (those that share
+    /// no nonzero rows) are perturbed together, so the number of function
+    /// evaluations scales with the number of colors instead of the number of
+    /// columns. Otherwise, one input is perturbed at a time.
+    void calcFiniteDifferenceJacobian(const casadi::DM& x,
+            const std::vector<casadi_int>& columns, casadi::DM& jacobian) const;
+    /// Partition the given columns of the sparsity pattern into groups of
+    /// columns that share no rows, using a greedy coloring. Structurally zero
+    /// columns are omitted.
+    static std::vector<std::vector<casadi_int>> colorColumns(
+            const casadi::Sparsity& sparsity,
+            const std::vector<casadi_int>& columns);
+
+    /// Split x, the concatenation of all inputs, into the separate inputs.
+    VectorDM splitInput(const casadi::DM& x) const;
+    /// Evaluate this function with x, the concatenation of all inputs, and
+    /// store the concatenation of all outputs in y.
+    void evalConcatenated(const casadi::DM& x, casadi::DM& y) const;
+
     const Problem* m_casProblem;
 
 private:
@@ -91,6 +157,14 @@ private:
 
     std::shared_ptr<const std::vector<VariablesDM>>
             m_fullPointsForSparsityDetection;
+
+    // Detecting the sparsity is expensive, so we only do it once.
+    mutable bool m_jacobianSparsityIsCached = false;
+    mutable casadi::Sparsity m_jacobianSparsity;
+
+    // CasADi holds references to the Jacobian functions we create, so these
+    // must live as long as this function.
+    mutable std::vector<std::unique_ptr<FunctionJacobian>> m_jacobianFunctions;
 };
 
 class PathConstraint : public Function {
@@ -311,6 +385,12 @@ class MultibodySystemImplicit : public Function {
     }
     casadi::Sparsity get_sparsity_out(casadi_int i) override final;
     VectorDM eval(const VectorDM& args) const override;
+    /// The multibody residuals are linear in the accelerations, and their
+    /// derivative with respect to the accelerations is the mass matrix, which
+    /// we obtain from the problem (Problem::calcMassMatrix()) instead of
+    /// perturbing each acceleration.
+    void calcJacobian(
+            const casadi::DM& x, casadi::DM& jacobian) const override;
 };
 
 } // namespace CasOC
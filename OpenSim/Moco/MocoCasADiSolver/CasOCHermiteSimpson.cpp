@@ -104,4 +104,26 @@ void HermiteSimpson::calcInterpolatingControlsImpl(
     }
 }
 
+DM HermiteSimpson::calcLocalErrorsImpl(const DM& times, const DM& xdot) const {
+    const int NS = m_problem.getNumStates();
+    // The derivative is estimated from the 5 grid points of 2 consecutive
+    // mesh intervals.
+    if (m_numMeshIntervals < 2) return DM::inf(NS, m_numMeshIntervals);
+
+    // The local error of Simpson integration is (h^5 / 2880) x^(5)(t), and
+    // x^(5) is the fourth derivative of xdot.
+    DM errors = DM::zeros(NS, m_numMeshIntervals);
+    for (int imesh = 0; imesh < m_numMeshIntervals; ++imesh) {
+        const int first = 2 * std::min(imesh, m_numMeshIntervals - 2);
+        const auto xdot4 =
+                calcDerivativeFromDividedDifferences(times, xdot, first, 4);
+        const double h =
+                double(times(2 * imesh + 2)) - double(times(2 * imesh));
+        for (int is = 0; is < NS; ++is) {
+            errors(is, imesh) = std::pow(h, 5) / 2880.0 * std::abs(xdot4[is]);
+        }
+    }
+    return errors;
+}
+
 } // namespace CasOC
@@ -74,6 +74,8 @@ private:
             casadi::MX& defects) const override;
     void calcInterpolatingControlsImpl(const casadi::MX& controls,
             casadi::MX& interpControls) const override;
+    casadi::DM calcLocalErrorsImpl(const casadi::DM& times,
+            const casadi::DM& xdot) const override;
 };
 
 } // namespace CasOC
@@ -19,6 +19,7 @@
  * -------------------------------------------------------------------------- */
 
 #include <casadi/casadi.hpp>
+#include <limits>
 
 namespace CasOC {
 
@@ -74,6 +75,11 @@ struct Solution : public Iterate {
     casadi::Dict stats;
     double objective;
     ObjectiveBreakdown objective_breakdown;
+    /// The estimated local error in each mesh interval (see
+    /// Transcription::calcMeshIntervalErrors()).
+    std::vector<double> mesh_interval_errors;
+    /// Wall-clock time spent in the optimization solver, in seconds.
+    double duration = std::numeric_limits<double>::quiet_NaN();
 };
 
 } // namespace CasOC
@@ -316,6 +316,15 @@ public:
             const casadi::DM& multibody_states, const casadi::DM& slacks,
             const casadi::DM& parameters,
             casadi::DM& velocity_correction) const = 0;
+    /// Compute the mass matrix, which is the derivative of the implicit
+    /// multibody residuals with respect to the accelerations. This is used to
+    /// compute the Jacobian of MultibodySystemImplicit if the Jacobian mode is
+    /// not "casadi". Return false if the problem cannot compute the mass
+    /// matrix, in which case finite differences are used instead.
+    virtual bool calcMassMatrix(const ContinuousInput& /*input*/,
+            casadi::DM& /*massMatrix*/) const {
+        return false;
+    }
 
     virtual void calcCostIntegrand(int /*costIndex*/,
             const ContinuousInput& /*input*/, double& /*integrand*/) const {}
@@ -380,9 +389,11 @@ public:
     }
 
     void initialize(const std::string& finiteDiffScheme,
+            const std::string& jacobianMode,
             std::shared_ptr<const std::vector<VariablesDM>>
                     pointsForSparsityDetection) const {
         auto* mutThis = const_cast<Problem*>(this);
+        mutThis->m_jacobianMode = jacobianMode;
 
         {
             int index = 0;
@@ -473,6 +484,8 @@ public:
     int getNumMultipliers() const { return (int)m_multiplierInfos.size(); }
     std::string getDynamicsMode() const { return m_dynamicsMode; }
     bool isDynamicsModeImplicit() const { return m_isDynamicsModeImplicit; }
+    /// See Solver::setJacobianMode().
+    const std::string& getJacobianMode() const { return m_jacobianMode; }
     int getNumDerivatives() const {
         return getNumAccelerations() + getNumAuxiliaryResidualEquations();
     }
@@ -614,6 +627,7 @@ private:
     int m_numAccelerationConstraintEquations = 0;
     bool m_enforceConstraintDerivatives = false;
     std::string m_dynamicsMode = "explicit";
+    std::string m_jacobianMode = "casadi";
     std::vector<std::string> m_auxiliaryDerivativeNames;
     bool m_isDynamicsModeImplicit = false;
     bool m_prescribedKinematics = false;
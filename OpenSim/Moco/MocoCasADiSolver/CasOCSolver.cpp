@@ -61,6 +61,16 @@ void Solver::setSparsityDetectionRandomCount(int count) {
     m_sparsity_detection_random_count = count;
 }
 
+void Solver::setJacobianMode(const std::string& mode) {
+    OPENSIM_THROW_IF(
+            mode != "casadi" && mode != "callback" && mode != "colored",
+            OpenSim::Exception,
+            "Expected Jacobian mode to be 'casadi', 'callback', or 'colored', "
+            "but got '{}'.",
+            mode);
+    m_jacobian_mode = mode;
+}
+
 void Solver::setParallelism(std::string parallelism, int numThreads) {
     m_parallelism = parallelism;
     OPENSIM_THROW_IF(numThreads < 1, OpenSim::Exception,
@@ -69,10 +79,31 @@ void Solver::setParallelism(std::string parallelism, int numThreads) {
 }
 
 Solution Solver::solve(const Iterate& guess) const {
+    Variation variation = createVariation();
+    variation.guess = guess;
+    return solve(std::vector<Variation>{variation}).at(0);
+}
+
+Variation Solver::createVariation() const {
+    Variation variation;
+    variation.cost_weights.assign(m_problem.getNumCosts(), 1.0);
+    variation.time_initial_bounds = m_problem.getTimeInitialBounds();
+    variation.time_final_bounds = m_problem.getTimeFinalBounds();
+    variation.state_infos = m_problem.getStateInfos();
+    variation.control_infos = m_problem.getControlInfos();
+    variation.parameter_infos = m_problem.getParameterInfos();
+    return variation;
+}
+
+std::vector<Solution> Solver::solve(
+        const std::vector<Variation>& variations) const {
+    OPENSIM_THROW_IF(variations.empty(), Exception,
+            "Expected at least one variation.");
     auto transcription = createTranscription();
     auto pointsForSparsityDetection =
             std::make_shared<std::vector<VariablesDM>>();
-    if (m_sparsity_detection == "initial-guess") {
+    const Iterate& guess = variations[0].guess;
+    if (m_sparsity_detection == "initial-guess" && !guess.variables.empty()) {
         // Interpolate the guess.
         Iterate guessCopy(guess);
         const auto guessTimes =
@@ -91,10 +122,10 @@ Solution Solver::solve(const Iterate& guess) const {
                             .variables);
         }
     }
-    m_problem.initialize(m_finite_difference_scheme,
+    m_problem.initialize(m_finite_difference_scheme, m_jacobian_mode,
             std::const_pointer_cast<const std::vector<VariablesDM>>(
                     pointsForSparsityDetection));
-    return transcription->solve(guess);
+    return transcription->solve(variations);
 }
 
 } // namespace CasOC
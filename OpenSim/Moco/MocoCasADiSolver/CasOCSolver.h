@@ -28,6 +28,22 @@ namespace CasOC {
 
 class Transcription;
 
+/// The parts of a problem that may differ between the solves performed by
+/// Solver::solve(const std::vector<Variation>&). Obtain the values for the
+/// problem itself from Solver::createVariation().
+struct Variation {
+    /// If this is empty, the guess is created from the bounds.
+    Iterate guess;
+    /// A factor multiplying each cost term, in the order of
+    /// Problem::getCostInfos().
+    std::vector<double> cost_weights;
+    Bounds time_initial_bounds;
+    Bounds time_final_bounds;
+    std::vector<StateInfo> state_infos;
+    std::vector<ControlInfo> control_infos;
+    std::vector<ParameterInfo> parameter_infos;
+};
+
 /// Once you have built your CasOC::Problem, create a CasOC::Solver to configure
 /// how you want to solve the problem, then invoke solve() to solve your
 /// problem. This class assumes that the problem is solved using direct
@@ -124,6 +140,20 @@ public:
         return m_finite_difference_scheme;
     }
 
+    /// How the derivatives of each CasOC::Function are computed:
+    /// - "casadi" (default): CasADi computes directional derivatives by
+    ///   perturbing the function.
+    /// - "callback": each function computes its entire Jacobian in a single
+    ///   callback, using analytic derivatives where available (the mass
+    ///   matrix for implicit multibody dynamics) and finite differences with
+    ///   the finite difference scheme otherwise.
+    /// - "colored": like "callback", but columns of the Jacobian that share
+    ///   no nonzero rows in the detected sparsity pattern are perturbed
+    ///   together. This requires sparsity detection to be beneficial.
+    void setJacobianMode(const std::string& mode);
+    /// @copydoc setJacobianMode()
+    std::string getJacobianMode() const { return m_jacobian_mode; }
+
     void setCallbackInterval(int callbackInterval) {
         m_callbackInterval = callbackInterval;
     }
@@ -171,6 +201,15 @@ public:
 
     Solution solve(const Iterate& guess) const;
 
+    /// A variation with the cost weights (all 1) and bounds of the problem,
+    /// and an empty guess.
+    Variation createVariation() const;
+    /// Solve the problem for each of the given variations. The problem is
+    /// transcribed, and the nonlinear program and its derivatives are
+    /// constructed, only once; the solves differ only in the values passed
+    /// to the optimization solver.
+    std::vector<Solution> solve(const std::vector<Variation>& variations) const;
+
 private:
     std::unique_ptr<Transcription> createTranscription() const;
 
@@ -187,6 +226,7 @@ private:
     Bounds m_implicitMultibodyAccelerationBounds;
     Bounds m_implicitAuxiliaryDerivativeBounds;
     std::string m_finite_difference_scheme = "central";
+    std::string m_jacobian_mode = "casadi";
     std::string m_sparsity_detection = "none";
     std::string m_write_sparsity;
     int m_callbackInterval = 0;
@@ -17,6 +17,8 @@
  * -------------------------------------------------------------------------- */
 #include "CasOCTranscription.h"
 
+#include <OpenSim/Common/Stopwatch.h>
+
 using casadi::DM;
 using casadi::MX;
 using casadi::MXVector;
@@ -32,9 +34,10 @@ class NlpsolCallback : public casadi::Callback {
 public:
     NlpsolCallback(const Transcription& transcription, const Problem& problem,
             casadi_int numVariables, casadi_int numConstraints,
-            casadi_int outputInterval)
+            casadi_int numParameters, casadi_int outputInterval)
             : m_transcription(transcription), m_problem(problem),
               m_numVariables(numVariables), m_numConstraints(numConstraints),
+              m_numParameters(numParameters),
               m_callbackInterval(outputInterval) {
         construct("NlpsolCallback", {});
     }
@@ -52,6 +55,8 @@ public:
             return casadi::Sparsity::dense(m_numVariables, 1);
         } else if (n == "g" || n == "lam_g") {
             return casadi::Sparsity::dense(m_numConstraints, 1);
+        } else if (n == "lam_p") {
+            return casadi::Sparsity::dense(m_numParameters, 1);
         } else {
             return casadi::Sparsity(0, 0);
         }
@@ -76,6 +81,7 @@ private:
     const Problem& m_problem;
     casadi_int m_numVariables;
     casadi_int m_numConstraints;
+    casadi_int m_numParameters;
     casadi_int m_callbackInterval;
     mutable int evalCount = 0;
 };
@@ -139,6 +145,7 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
     m_vars[slacks] = MX::sym(
             "slacks", m_problem.getNumSlacks(), m_numMeshInteriorPoints);
     m_vars[parameters] = MX::sym("parameters", m_problem.getNumParameters(), 1);
+    m_costWeights = MX::sym("cost_weights", m_problem.getNumCosts(), 1);
 
     m_paramsTrajGrid = MX::repmat(m_vars[parameters], 1, m_numGridPoints);
     m_paramsTrajMesh = MX::repmat(m_vars[parameters], 1, m_numMeshPoints);
@@ -180,33 +187,8 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
     initializeBounds(m_lowerBounds);
     initializeBounds(m_upperBounds);
 
-    setVariableBounds(initial_time, 0, 0, m_problem.getTimeInitialBounds());
-    setVariableBounds(final_time, 0, 0, m_problem.getTimeFinalBounds());
+    setVariationBounds(m_solver.createVariation());
 
-    {
-        const auto& stateInfos = m_problem.getStateInfos();
-        int is = 0;
-        for (const auto& info : stateInfos) {
-            setVariableBounds(
-                    states, is, Slice(1, m_numGridPoints - 1), info.bounds);
-            // The "0" grabs the first column (first mesh point).
-            setVariableBounds(states, is, 0, info.initialBounds);
-            // The "-1" grabs the last column (last mesh point).
-            setVariableBounds(states, is, -1, info.finalBounds);
-            ++is;
-        }
-    }
-    {
-        const auto& controlInfos = m_problem.getControlInfos();
-        int ic = 0;
-        for (const auto& info : controlInfos) {
-            setVariableBounds(
-                    controls, ic, Slice(1, m_numGridPoints - 1), info.bounds);
-            setVariableBounds(controls, ic, 0, info.initialBounds);
-            setVariableBounds(controls, ic, -1, info.finalBounds);
-            ++ic;
-        }
-    }
     {
         const auto& multiplierInfos = m_problem.getMultiplierInfos();
         int im = 0;
@@ -240,14 +222,6 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
             ++isl;
         }
     }
-    {
-        const auto& paramInfos = m_problem.getParameterInfos();
-        int ip = 0;
-        for (const auto& info : paramInfos) {
-            setVariableBounds(parameters, ip, 0, info.bounds);
-            ++ip;
-        }
-    }
 }
 
 void Transcription::transcribe() {
@@ -507,7 +481,8 @@ void Transcription::setObjectiveAndEndpointConstraints() {
                  m_vars[derivatives](Slice(), -1), m_vars[parameters],
                  integral},
                 costOut);
-        m_objectiveTerms(iterm++) = casadi::MX::sum1(costOut.at(0));
+        m_objectiveTerms(iterm++) =
+                m_costWeights(ic) * casadi::MX::sum1(costOut.at(0));
     }
 
     // Minimize Lagrange multipliers if specified by the solver.
@@ -584,49 +559,13 @@ void Transcription::setObjectiveAndEndpointConstraints() {
     }
 }
 
-Solution Transcription::solve(const Iterate& guessOrig) {
+std::vector<Solution> Transcription::solve(
+        const std::vector<Variation>& variations) {
 
     // Define the NLP.
     // ---------------
     transcribe();
 
-    // Resample the guess.
-    // -------------------
-    const auto guessTimes = createTimes(guessOrig.variables.at(initial_time),
-            guessOrig.variables.at(final_time));
-    auto guess = guessOrig.resample(guessTimes);
-
-    // Adjust guesses for the slack variables to ensure they are the correct
-    // length (i.e. slacks.size2() == m_numPointsIgnoringConstraints).
-    if (guess.variables.find(Var::slacks) != guess.variables.end()) {
-        auto& slacks = guess.variables.at(Var::slacks);
-
-        // If slack variables provided in the guess are equal to the grid
-        // length, remove the elements on the mesh points where the slack
-        // variables are not defined.
-        if (slacks.size2() == m_numGridPoints) {
-            casadi::DM meshIndices = createMeshIndices();
-            std::vector<casadi_int> slackColumnsToRemove;
-            for (int itime = 0; itime < m_numGridPoints; ++itime) {
-                if (meshIndices(itime).__nonzero__()) {
-                    slackColumnsToRemove.push_back(itime);
-                }
-            }
-            // The first argument is an empty vector since we don't want to
-            // remove an entire row.
-            slacks.remove(std::vector<casadi_int>(), slackColumnsToRemove);
-        }
-
-        // Check that either that the slack variables provided in the guess
-        // are the correct length, or that the correct number of columns
-        // were removed.
-        OPENSIM_THROW_IF(slacks.size2() != m_numMeshInteriorPoints,
-                OpenSim::Exception,
-                "Expected slack variables to be length {}, but they are length "
-                "{}.",
-                m_numMeshInteriorPoints, slacks.size2());
-    }
-
     // Create the CasADi NLP function.
     // -------------------------------
     // Option handling is copied from casadi::OptiNode::solver().
@@ -644,12 +583,15 @@ Solution Transcription::solve(const Iterate& guessOrig) {
     casadi_int numConstraints = g.numel();
 
     NlpsolCallback callback(*this, m_problem, numVariables, numConstraints,
-            m_solver.getCallbackInterval());
+            m_costWeights.numel(), m_solver.getCallbackInterval());
     options["iteration_callback"] = callback;
 
     // The inputs to nlpsol() are symbolic (casadi::MX).
     casadi::MXDict nlp;
     nlp.emplace(std::make_pair("x", x));
+    // The cost weights are parameters of the NLP, so that solves with
+    // different weights can share the NLP function.
+    nlp.emplace(std::make_pair("p", m_costWeights));
     // The objective symbolic variable holds an expression graph including
     // all the calculations performed on the variables x.
     casadi::MX objective = MX::sum1(m_objectiveTerms);
@@ -677,47 +619,153 @@ Solution Transcription::solve(const Iterate& guessOrig) {
     }
     const casadi::Function nlpFunc =
             casadi::nlpsol("nlp", m_solver.getOptimSolver(), nlp, options);
+    casadi::Function objectiveFunc(
+            "objective", {x, m_costWeights}, {m_objectiveTerms});
+    casadi::Function xdotFunc("xdot", {x}, {m_xdot});
+    casadi::Function constraintFunc("constraints", {x}, {g});
+
+    std::vector<Solution> solutions;
+    for (const auto& variation : variations) {
+        setVariationBounds(variation);
+
+        // Resample the guess.
+        // -------------------
+        const Iterate& guessOrig = variation.guess.variables.empty()
+                                           ? createInitialGuessFromBounds()
+                                           : variation.guess;
+        const auto guessTimes =
+                createTimes(guessOrig.variables.at(initial_time),
+                        guessOrig.variables.at(final_time));
+        auto guess = guessOrig.resample(guessTimes);
+
+        // Adjust guesses for the slack variables to ensure they are the
+        // correct length (i.e. slacks.size2() ==
+        // m_numPointsIgnoringConstraints).
+        if (guess.variables.find(Var::slacks) != guess.variables.end()) {
+            auto& slacks = guess.variables.at(Var::slacks);
+
+            // If slack variables provided in the guess are equal to the grid
+            // length, remove the elements on the mesh points where the slack
+            // variables are not defined.
+            if (slacks.size2() == m_numGridPoints) {
+                casadi::DM meshIndices = createMeshIndices();
+                std::vector<casadi_int> slackColumnsToRemove;
+                for (int itime = 0; itime < m_numGridPoints; ++itime) {
+                    if (meshIndices(itime).__nonzero__()) {
+                        slackColumnsToRemove.push_back(itime);
+                    }
+                }
+                // The first argument is an empty vector since we don't want
+                // to remove an entire row.
+                slacks.remove(std::vector<casadi_int>(), slackColumnsToRemove);
+            }
 
-    // Run the optimization (evaluate the CasADi NLP function).
-    // --------------------------------------------------------
-    // The inputs and outputs of nlpFunc are numeric (casadi::DM).
-    const casadi::DMDict nlpResult =
-            nlpFunc(casadi::DMDict{{"x0", flattenVariables(guess.variables)},
-                    {"lbx", flattenVariables(m_lowerBounds)},
-                    {"ubx", flattenVariables(m_upperBounds)},
-                    {"lbg", flattenConstraints(m_constraintsLowerBounds)},
-                    {"ubg", flattenConstraints(m_constraintsUpperBounds)}});
-
-    // Create a CasOC::Solution.
-    // -------------------------
-    Solution solution = m_problem.createIterate<Solution>();
-    const auto finalVariables = nlpResult.at("x");
-    solution.variables = expandVariables(finalVariables);
-    solution.objective = nlpResult.at("f").scalar();
-
-    casadi::DMVector finalVarsDMV{finalVariables};
-    casadi::Function objectiveFunc("objective", {x}, {m_objectiveTerms});
-    casadi::DMVector objectiveOut;
-    objectiveFunc.call(finalVarsDMV, objectiveOut);
-    solution.objective_breakdown = expandObjectiveTerms(objectiveOut[0]);
-
-    solution.times = createTimes(
-            solution.variables[initial_time], solution.variables[final_time]);
-    solution.stats = nlpFunc.stats();
-
-    // Print breakdown of objective.
-    printObjectiveBreakdown(solution, objectiveOut[0]);
-
-    if (!solution.stats.at("success")) {
-
-        // For some reason, nlpResult.at("g") is all 0. So we calculate the
-        // constraints ourselves.
-        casadi::Function constraintFunc("constraints", {x}, {g});
-        casadi::DMVector constraintsOut;
-        constraintFunc.call(finalVarsDMV, constraintsOut);
-        printConstraintValues(solution, expandConstraints(constraintsOut[0]));
+            // Check that either that the slack variables provided in the
+            // guess are the correct length, or that the correct number of
+            // columns were removed.
+            OPENSIM_THROW_IF(slacks.size2() != m_numMeshInteriorPoints,
+                    OpenSim::Exception,
+                    "Expected slack variables to be length {}, but they are "
+                    "length {}.",
+                    m_numMeshInteriorPoints, slacks.size2());
+        }
+
+        OPENSIM_THROW_IF(
+                (int)variation.cost_weights.size() != m_costWeights.numel(),
+                OpenSim::Exception, "Expected {} cost weights, but got {}.",
+                m_costWeights.numel(), variation.cost_weights.size());
+        const DM costWeights(variation.cost_weights);
+
+        // Run the optimization (evaluate the CasADi NLP function).
+        // --------------------------------------------------------
+        // The inputs and outputs of nlpFunc are numeric (casadi::DM).
+        const OpenSim::Stopwatch stopwatch;
+        const casadi::DMDict nlpResult = nlpFunc(
+                casadi::DMDict{{"x0", flattenVariables(guess.variables)},
+                        {"p", costWeights},
+                        {"lbx", flattenVariables(m_lowerBounds)},
+                        {"ubx", flattenVariables(m_upperBounds)},
+                        {"lbg", flattenConstraints(m_constraintsLowerBounds)},
+                        {"ubg",
+                                flattenConstraints(m_constraintsUpperBounds)}});
+
+        // Create a CasOC::Solution.
+        // -------------------------
+        Solution solution = m_problem.createIterate<Solution>();
+        solution.duration = SimTK::nsToSec(stopwatch.getElapsedTimeInNs());
+        const auto finalVariables = nlpResult.at("x");
+        solution.variables = expandVariables(finalVariables);
+        solution.objective = nlpResult.at("f").scalar();
+
+        casadi::DMVector finalVarsDMV{finalVariables};
+        casadi::DMVector objectiveOut;
+        objectiveFunc.call({finalVariables, costWeights}, objectiveOut);
+        solution.objective_breakdown = expandObjectiveTerms(objectiveOut[0]);
+
+        solution.times = createTimes(solution.variables[initial_time],
+                solution.variables[final_time]);
+        solution.stats = nlpFunc.stats();
+
+        // Estimate the error in each mesh interval, for mesh refinement.
+        casadi::DMVector xdotOut;
+        xdotFunc.call(finalVarsDMV, xdotOut);
+        solution.mesh_interval_errors = calcMeshIntervalErrors(
+                solution.times, solution.variables.at(states), xdotOut[0]);
+
+        // Print breakdown of objective.
+        printObjectiveBreakdown(solution, objectiveOut[0]);
+
+        if (!solution.stats.at("success")) {
+
+            // For some reason, nlpResult.at("g") is all 0. So we calculate the
+            // constraints ourselves.
+            casadi::DMVector constraintsOut;
+            constraintFunc.call(finalVarsDMV, constraintsOut);
+            printConstraintValues(
+                    solution, expandConstraints(constraintsOut[0]));
+        }
+        solutions.push_back(std::move(solution));
+    }
+    return solutions;
+}
+
+void Transcription::setVariationBounds(const Variation& variation) {
+    OPENSIM_THROW_IF(
+            (int)variation.state_infos.size() != m_problem.getNumStates() ||
+                    (int)variation.control_infos.size() !=
+                            m_problem.getNumControls() ||
+                    (int)variation.parameter_infos.size() !=
+                            m_problem.getNumParameters(),
+            OpenSim::Exception,
+            "Expected the variation to have the same number of states, "
+            "controls, and parameters as the problem.");
+
+    setVariableBounds(initial_time, 0, 0, variation.time_initial_bounds);
+    setVariableBounds(final_time, 0, 0, variation.time_final_bounds);
+
+    int is = 0;
+    for (const auto& info : variation.state_infos) {
+        setVariableBounds(
+                states, is, Slice(1, m_numGridPoints - 1), info.bounds);
+        // The "0" grabs the first column (first mesh point).
+        setVariableBounds(states, is, 0, info.initialBounds);
+        // The "-1" grabs the last column (last mesh point).
+        setVariableBounds(states, is, -1, info.finalBounds);
+        ++is;
+    }
+    int ic = 0;
+    for (const auto& info : variation.control_infos) {
+        setVariableBounds(
+                controls, ic, Slice(1, m_numGridPoints - 1), info.bounds);
+        setVariableBounds(controls, ic, 0, info.initialBounds);
+        setVariableBounds(controls, ic, -1, info.finalBounds);
+        ++ic;
+    }
+    int ip = 0;
+    for (const auto& info : variation.parameter_infos) {
+        setVariableBounds(parameters, ip, 0, info.bounds);
+        ++ip;
     }
-    return solution;
 }
 
 void Transcription::printConstraintValues(const Iterate& it,
@@ -1223,4 +1271,48 @@ casadi::MXVector Transcription::evalOnTrajectory(
     }*/
 }
 
+std::vector<double> Transcription::calcDerivativeFromDividedDifferences(
+        const casadi::DM& times, const casadi::DM& values, int firstColumn,
+        int order) {
+    double factorial = 1;
+    for (int k = 2; k <= order; ++k) { factorial *= k; }
+    std::vector<double> derivative(values.rows());
+    std::vector<double> diffs(order + 1);
+    for (int irow = 0; irow < (int)values.rows(); ++irow) {
+        for (int j = 0; j <= order; ++j) {
+            diffs[j] = double(values(irow, firstColumn + j));
+        }
+        // Newton's divided differences, computed in place.
+        for (int level = 1; level <= order; ++level) {
+            for (int j = order; j >= level; --j) {
+                const double dt = double(times(firstColumn + j)) -
+                                  double(times(firstColumn + j - level));
+                diffs[j] = (diffs[j] - diffs[j - 1]) / dt;
+            }
+        }
+        derivative[irow] = factorial * diffs[order];
+    }
+    return derivative;
+}
+
+std::vector<double> Transcription::calcMeshIntervalErrors(
+        const casadi::DM& times, const casadi::DM& x,
+        const casadi::DM& xdot) const {
+    std::vector<double> errors(m_numMeshIntervals, 0.0);
+    const int NS = m_problem.getNumStates();
+    if (!NS) return errors;
+    const DM localErrors = calcLocalErrorsImpl(times, xdot);
+    for (int is = 0; is < NS; ++is) {
+        double maxAbs = 0;
+        for (int itime = 0; itime < (int)x.columns(); ++itime) {
+            maxAbs = std::max(maxAbs, std::abs(double(x(is, itime))));
+        }
+        for (int imesh = 0; imesh < m_numMeshIntervals; ++imesh) {
+            errors[imesh] = std::max(errors[imesh],
+                    double(localErrors(is, imesh)) / (1.0 + maxAbs));
+        }
+    }
+    return errors;
+}
+
 } // namespace CasOC
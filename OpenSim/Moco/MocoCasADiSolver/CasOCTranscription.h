@@ -62,7 +62,17 @@ public:
         return meshIndices;
     }
 
-    Solution solve(const Iterate& guessOrig);
+    /// Solve the problem once for each variation (see Solver::solve()).
+    std::vector<Solution> solve(const std::vector<Variation>& variations);
+
+    /// Estimate the local error in each mesh interval of a trajectory with
+    /// the given times, states (x), and state derivatives (xdot) on the
+    /// grid. The error of each state is the truncation error of the
+    /// transcription scheme, divided by 1 plus the largest magnitude of the
+    /// state over the trajectory; the error of an interval is the largest
+    /// error among the states.
+    std::vector<double> calcMeshIntervalErrors(const casadi::DM& times,
+            const casadi::DM& x, const casadi::DM& xdot) const;
 
 protected:
     /// This must be called in the constructor of derived classes so that
@@ -81,6 +91,13 @@ protected:
             const std::vector<Var>& inputs,
             const casadi::Matrix<casadi_int>& timeIndices) const;
 
+    /// Estimate the derivative of the given order (of each row of `values`)
+    /// from the divided differences of the values at the order + 1 grid
+    /// points starting with `firstColumn`.
+    static std::vector<double> calcDerivativeFromDividedDifferences(
+            const casadi::DM& times, const casadi::DM& values,
+            int firstColumn, int order);
+
     template <typename TRow, typename TColumn>
     void setVariableBounds(Var var, const TRow& rowIndices,
             const TColumn& columnIndices, const Bounds& bounds) {
@@ -143,6 +160,9 @@ private:
 
     casadi::MX m_xdot; // State derivatives.
 
+    /// Factors multiplying the cost terms; these are parameters of the
+    /// nonlinear program so that they can change between solves.
+    casadi::MX m_costWeights;
     casadi::MX m_objectiveTerms;
     std::vector<std::string> m_objectiveTermNames;
 
@@ -164,6 +184,12 @@ private:
     /// and path constraint errors required for your transcription scheme.
     virtual void calcDefectsImpl(const casadi::MX& x, const casadi::MX& xdot,
             casadi::MX& defects) const = 0;
+    /// Override this function to estimate the local (truncation) error of
+    /// each state in each mesh interval, given the state derivatives on the
+    /// grid. The returned matrix has a row for each state and a column for
+    /// each mesh interval.
+    virtual casadi::DM calcLocalErrorsImpl(
+            const casadi::DM& times, const casadi::DM& xdot) const = 0;
     virtual void calcInterpolatingControlsImpl(const casadi::MX& /*controls*/,
             casadi::MX& /*interpControls*/) const {
         OPENSIM_THROW_IF(m_pointsForInterpControls.numel(), OpenSim::Exception,
@@ -171,6 +197,8 @@ private:
     }
 
     void transcribe();
+    /// Set the bounds on the time, state, control, and parameter variables.
+    void setVariationBounds(const Variation& variation);
     void setObjectiveAndEndpointConstraints();
     void calcDefects() {
         calcDefectsImpl(m_vars.at(states), m_xdot, m_constraints.defects);
@@ -58,4 +58,24 @@ void Trapezoidal::calcDefectsImpl(
     }
 }
 
+DM Trapezoidal::calcLocalErrorsImpl(const DM& times, const DM& xdot) const {
+    const int NS = m_problem.getNumStates();
+    // The derivative is estimated from 3 consecutive mesh points.
+    if (m_numMeshIntervals < 2) return DM::inf(NS, m_numMeshIntervals);
+
+    // The local error of the trapezoidal rule is (h^3 / 12) x'''(t), and
+    // x''' is the second derivative of xdot.
+    DM errors = DM::zeros(NS, m_numMeshIntervals);
+    for (int imesh = 0; imesh < m_numMeshIntervals; ++imesh) {
+        const int first = std::min(imesh, m_numMeshIntervals - 2);
+        const auto xdot2 =
+                calcDerivativeFromDividedDifferences(times, xdot, first, 2);
+        const double h = double(times(imesh + 1)) - double(times(imesh));
+        for (int is = 0; is < NS; ++is) {
+            errors(is, imesh) = std::pow(h, 3) / 12.0 * std::abs(xdot2[is]);
+        }
+    }
+    return errors;
+}
+
 } // namespace CasOC
@@ -44,6 +44,8 @@ private:
 
     void calcDefectsImpl(const casadi::MX& x, const casadi::MX& xdot,
             casadi::MX& defects) const override;
+    casadi::DM calcLocalErrorsImpl(const casadi::DM& times,
+            const casadi::DM& xdot) const override;
 };
 
 } // namespace CasOC
@@ -20,6 +20,8 @@
 
 #include <OpenSim/Moco/MocoUtilities.h>
 
+#include <algorithm>
+
 #ifdef OPENSIM_WITH_CASADI
     #include "CasOCSolver.h"
     #include "MocoCasOCProblem.h"
@@ -44,6 +46,7 @@ void MocoCasADiSolver::constructProperties() {
     constructProperty_optim_sparsity_detection("none");
     constructProperty_optim_write_sparsity("");
     constructProperty_optim_finite_difference_scheme("central");
+    constructProperty_optim_jacobian_mode("casadi");
     constructProperty_parallel();
     constructProperty_output_interval(0);
 
@@ -230,6 +233,15 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
                 "point must be one.");
     }
 
+    checkPropertyValueIsInRangeOrSet(
+            getProperty_mesh_refinement_max_iterations(), 0,
+            std::numeric_limits<int>::max(), {});
+    checkPropertyValueIsInRangeOrSet(getProperty_mesh_refinement_tolerance(),
+            0.0, SimTK::NTraits<double>::getInfinity(), {});
+    checkPropertyValueIsInRangeOrSet(
+            getProperty_mesh_refinement_max_mesh_intervals(), 1,
+            std::numeric_limits<int>::max(), {});
+
     checkPropertyValueIsInRangeOrSet(getProperty_optim_max_iterations(), 0,
             std::numeric_limits<int>::max(), {-1});
     checkPropertyValueIsInRangeOrSet(getProperty_optim_convergence_tolerance(),
@@ -278,6 +290,10 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
             {"central", "forward", "backward"});
     casSolver->setFiniteDifferenceScheme(get_optim_finite_difference_scheme());
 
+    checkPropertyValueIsInSet(getProperty_optim_jacobian_mode(),
+            {"casadi", "callback", "colored"});
+    casSolver->setJacobianMode(get_optim_jacobian_mode());
+
     casSolver->setCallbackInterval(get_output_interval());
 
     Dict pluginOptions;
@@ -359,17 +375,55 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
         casGuess = convertToCasOCIterate(guess);
     }
 
-    // Temporarily disable printing of negative muscle force warnings so the
-    // log isn't flooded while computing finite differences.
-    Logger::Level origLoggerLevel = Logger::getLevel();
-    Logger::setLevel(Logger::Level::Warn);
     CasOC::Solution casSolution;
-    try {
-        casSolution = casSolver->solve(casGuess);
-    } catch (...) {
+    int numIterations = 0;
+    for (int irefine = 0;; ++irefine) {
+        // Temporarily disable printing of negative muscle force warnings so
+        // the log isn't flooded while computing finite differences.
+        Logger::Level origLoggerLevel = Logger::getLevel();
+        Logger::setLevel(Logger::Level::Warn);
+        try {
+            casSolution = casSolver->solve(casGuess);
+        } catch (...) {
+            OpenSim::Logger::setLevel(origLoggerLevel);
+        }
         OpenSim::Logger::setLevel(origLoggerLevel);
+        numIterations += int(casSolution.stats.at("iter_count"));
+
+        // Mesh refinement: solve again on a finer mesh, starting from the
+        // solution on the current mesh.
+        if (irefine == get_mesh_refinement_max_iterations()) break;
+        // The error estimate is meaningless if the solver did not converge.
+        if (!casSolution.stats.at("success")) break;
+        const auto& mesh = casSolver->getMesh();
+        auto newMesh = refineMesh(mesh, casSolution.mesh_interval_errors);
+        if (newMesh.size() == mesh.size()) {
+            if (get_verbosity()) {
+                log_info("Mesh refinement: all mesh interval errors are "
+                         "below the tolerance.");
+            }
+            break;
+        }
+        if ((int)newMesh.size() - 1 >
+                get_mesh_refinement_max_mesh_intervals()) {
+            log_warn("Mesh refinement stopped: the refined mesh would have "
+                     "{} intervals, which exceeds "
+                     "mesh_refinement_max_mesh_intervals ({}).",
+                    newMesh.size() - 1,
+                    get_mesh_refinement_max_mesh_intervals());
+            break;
+        }
+        if (get_verbosity()) {
+            log_info("Mesh refinement iteration {}: largest estimated error "
+                     "is {}; solving again with {} mesh intervals (was {}).",
+                    irefine + 1,
+                    *std::max_element(casSolution.mesh_interval_errors.begin(),
+                            casSolution.mesh_interval_errors.end()),
+                    newMesh.size() - 1, mesh.size() - 1);
+        }
+        casSolver->setMesh(std::move(newMesh));
+        casGuess = casSolution;
     }
-    OpenSim::Logger::setLevel(origLoggerLevel);
 
     MocoSolution mocoSolution =
             convertToMocoTrajectory<MocoSolution>(casSolution);
@@ -422,7 +476,7 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
     const long long elapsed = stopwatch.getElapsedTimeInNs();
     setSolutionStats(mocoSolution, casSolution.stats.at("success"),
             casSolution.objective, casSolution.stats.at("return_status"),
-            casSolution.stats.at("iter_count"), SimTK::nsToSec(elapsed),
+            numIterations, SimTK::nsToSec(elapsed),
             casSolution.objective_breakdown);
 
     if (get_verbosity()) {
@@ -442,3 +496,183 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
     OPENSIM_THROW(MocoCasADiSolverNotAvailable);
 #endif
 }
+
+std::vector<MocoSolution> MocoCasADiSolver::solveSweepImpl(
+        const std::vector<MocoSweepVariation>& variations) const {
+#ifdef OPENSIM_WITH_CASADI
+    OPENSIM_THROW_IF_FRMOBJ(get_mesh_refinement_max_iterations() > 0,
+            Exception, "Mesh refinement is not supported for sweeps.");
+    if (variations.empty()) return {};
+
+    if (get_verbosity()) {
+        log_info(std::string(72, '='));
+        log_info("MocoCasADiSolver starting a sweep of {} solves.",
+                variations.size());
+        log_info(getFormattedDateTime(false, "%c"));
+        log_info(std::string(72, '-'));
+        getProblemRep().printDescription();
+    }
+    auto casProblem = createCasOCProblem();
+    auto casSolver = createCasOCSolver(*casProblem);
+
+    // Convert each variation into the bounds, cost weights, and guess of the
+    // CasOC problem.
+    const auto& rep = getProblemRep();
+    const auto costNames = rep.createCostNames();
+    const MocoTrajectory& solverGuess = getGuess();
+    std::vector<CasOC::Variation> casVariations;
+    for (const auto& variation : variations) {
+        CasOC::Variation casVariation = casSolver->createVariation();
+
+        const MocoTrajectory& guess =
+                variation.guess.empty() ? solverGuess : variation.guess;
+        if (!guess.empty()) {
+            checkGuess(guess);
+            casVariation.guess = convertToCasOCIterate(guess);
+        }
+
+        for (const auto& kv : variation.goal_weights) {
+            const auto it =
+                    std::find(costNames.begin(), costNames.end(), kv.first);
+            OPENSIM_THROW_IF_FRMOBJ(it == costNames.end(), Exception,
+                    "Expected a goal in cost mode named '{}', but there is "
+                    "none.",
+                    kv.first);
+            // The weight from the MocoProblem is applied by the goal itself.
+            const double weight = rep.getCost(kv.first).getWeight();
+            OPENSIM_THROW_IF_FRMOBJ(weight == 0, Exception,
+                    "Cannot change the weight of goal '{}' because its weight "
+                    "in the MocoProblem is 0.",
+                    kv.first);
+            casVariation.cost_weights[it - costNames.begin()] =
+                    kv.second / weight;
+        }
+
+        // Find the CasOC info for a state, control, or parameter, and set
+        // its bounds.
+        auto updateBounds = [&](const std::string& name,
+                                    const CasOC::Bounds& bounds,
+                                    int which) -> bool {
+            // which: 0 for bounds, 1 for initial bounds, 2 for final bounds.
+            // The endpoint bounds in the CasOC infos have already been
+            // clipped to the original bounds (by CasOC::Problem), so new
+            // bounds are applied to the endpoint bounds from the MocoProblem
+            // instead. The bounds of a variation are applied before its
+            // endpoint bounds, which are then clipped to them.
+            auto clip = [](const CasOC::Bounds& all, CasOC::Bounds& endpoint) {
+                endpoint.lower = std::max(all.lower, endpoint.lower);
+                endpoint.upper = std::min(all.upper, endpoint.upper);
+            };
+            auto apply = [&](const MocoVariableInfo& repInfo,
+                                 CasOC::Bounds& all, CasOC::Bounds& initial,
+                                 CasOC::Bounds& final) {
+                if (which == 0) {
+                    all = bounds;
+                    initial = convertBounds(repInfo.getInitialBounds());
+                    final = convertBounds(repInfo.getFinalBounds());
+                    clip(all, initial);
+                    clip(all, final);
+                } else if (which == 1) {
+                    initial = bounds;
+                    clip(all, initial);
+                } else {
+                    final = bounds;
+                    clip(all, final);
+                }
+            };
+            for (auto& info : casVariation.state_infos) {
+                if (info.name == name) {
+                    apply(rep.getStateInfo(name), info.bounds,
+                            info.initialBounds, info.finalBounds);
+                    return true;
+                }
+            }
+            for (auto& info : casVariation.control_infos) {
+                if (info.name == name) {
+                    apply(rep.getControlInfo(name), info.bounds,
+                            info.initialBounds, info.finalBounds);
+                    return true;
+                }
+            }
+            if (which == 0) {
+                for (auto& info : casVariation.parameter_infos) {
+                    if (info.name == name) {
+                        info.bounds = bounds;
+                        return true;
+                    }
+                }
+            }
+            return false;
+        };
+        for (const auto& kv : variation.bounds) {
+            OPENSIM_THROW_IF_FRMOBJ(
+                    !updateBounds(kv.first, convertBounds(kv.second), 0),
+                    Exception,
+                    "Expected a state, control, or parameter named '{}', but "
+                    "there is none.",
+                    kv.first);
+        }
+        for (const auto& kv : variation.initial_bounds) {
+            OPENSIM_THROW_IF_FRMOBJ(
+                    !updateBounds(kv.first, convertBounds(kv.second), 1),
+                    Exception,
+                    "Expected a state or control named '{}', but there is "
+                    "none.",
+                    kv.first);
+        }
+        for (const auto& kv : variation.final_bounds) {
+            OPENSIM_THROW_IF_FRMOBJ(
+                    !updateBounds(kv.first, convertBounds(kv.second), 2),
+                    Exception,
+                    "Expected a state or control named '{}', but there is "
+                    "none.",
+                    kv.first);
+        }
+        if (variation.time_initial_bounds.isSet()) {
+            casVariation.time_initial_bounds =
+                    convertBounds(variation.time_initial_bounds);
+        }
+        if (variation.time_final_bounds.isSet()) {
+            casVariation.time_final_bounds =
+                    convertBounds(variation.time_final_bounds);
+        }
+        casVariations.push_back(std::move(casVariation));
+    }
+
+    // Temporarily disable printing of negative muscle force warnings so the
+    // log isn't flooded while computing finite differences.
+    Logger::Level origLoggerLevel = Logger::getLevel();
+    Logger::setLevel(Logger::Level::Warn);
+    std::vector<CasOC::Solution> casSolutions;
+    try {
+        casSolutions = casSolver->solve(casVariations);
+    } catch (...) {
+        OpenSim::Logger::setLevel(origLoggerLevel);
+        throw;
+    }
+    OpenSim::Logger::setLevel(origLoggerLevel);
+
+    std::vector<MocoSolution> solutions;
+    int numSucceeded = 0;
+    for (const auto& casSolution : casSolutions) {
+        MocoSolution mocoSolution =
+                convertToMocoTrajectory<MocoSolution>(casSolution);
+        setSolutionStats(mocoSolution, casSolution.stats.at("success"),
+                casSolution.objective, casSolution.stats.at("return_status"),
+                casSolution.stats.at("iter_count"), casSolution.duration,
+                casSolution.objective_breakdown);
+        if (mocoSolution) ++numSucceeded;
+        solutions.push_back(std::move(mocoSolution));
+    }
+
+    if (get_verbosity()) {
+        log_info(std::string(72, '-'));
+        log_info("MocoCasADiSolver sweep: {} of {} solves succeeded.",
+                numSucceeded, solutions.size());
+        log_info(std::string(72, '='));
+    }
+    return solutions;
+#else
+    OPENSIM_THROW(MocoCasADiSolverNotAvailable);
+#endif
+}
@@ -137,6 +137,16 @@ public:
     OpenSim_DECLARE_PROPERTY(optim_finite_difference_scheme, std::string,
             "The finite difference scheme CasADi will use to calculate problem "
             "derivatives (default: 'central').");
+    OpenSim_DECLARE_PROPERTY(optim_jacobian_mode, std::string,
+            "How to compute the Jacobians of the model functions: 'casadi' "
+            "(CasADi perturbs the function once per derivative direction; "
+            "default) or 'callback' (Moco computes each Jacobian in a single "
+            "callback, using the mass matrix for the derivatives of implicit "
+            "multibody dynamics with respect to accelerations and finite "
+            "differences otherwise), or 'colored' (like 'callback', but "
+            "inputs that affect disjoint outputs according to the detected "
+            "sparsity pattern are perturbed together; use with "
+            "optim_sparsity_detection).");
 
     OpenSim_DECLARE_OPTIONAL_PROPERTY(parallel, int,
             "Evaluate integral costs and the differential-algebraic "
@@ -218,6 +228,10 @@ public:
 
 protected:
     MocoSolution solveImpl() const override;
+#ifndef SWIG
+    std::vector<MocoSolution> solveSweepImpl(
+            const std::vector<MocoSweepVariation>& variations) const override;
+#endif
 
     std::unique_ptr<MocoCasOCProblem> createCasOCProblem() const;
     std::unique_ptr<CasOC::Solver> createCasOCSolver(
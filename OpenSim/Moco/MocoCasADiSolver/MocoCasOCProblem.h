@@ -296,6 +296,33 @@ private:
 
         m_jar->leave(std::move(mocoProblemRep));
     }
+    bool calcMassMatrix(const ContinuousInput& input,
+            casadi::DM& massMatrix) const override {
+        auto mocoProblemRep = m_jar->take();
+
+        // The mass matrix depends only on the coordinates (and parameters).
+        applyInput(SimTK::Stage::Position, input.time, input.states,
+                input.controls, input.multipliers, input.derivatives,
+                input.parameters, mocoProblemRep);
+        const auto& modelDisabledConstraints =
+                mocoProblemRep->getModelDisabledConstraints();
+        auto& simtkStateDisabledConstraints =
+                mocoProblemRep->updStateDisabledConstraints();
+        modelDisabledConstraints.realizePosition(simtkStateDisabledConstraints);
+
+        SimTK::Matrix M;
+        modelDisabledConstraints.getMatterSubsystem().calcM(
+                simtkStateDisabledConstraints, M);
+        massMatrix = casadi::DM::zeros(M.nrow(), M.ncol());
+        for (int j = 0; j < M.ncol(); ++j) {
+            for (int i = 0; i < M.nrow(); ++i) {
+                massMatrix.ptr()[i + j * M.nrow()] = M(i, j);
+            }
+        }
+
+        m_jar->leave(std::move(mocoProblemRep));
+        return true;
+    }
     void calcVelocityCorrection(const double& time,
             const casadi::DM& multibody_states, const casadi::DM& slacks,
             const casadi::DM& parameters,
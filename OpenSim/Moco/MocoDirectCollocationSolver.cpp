@@ -18,6 +18,9 @@
 
 #include "MocoDirectCollocationSolver.h"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace OpenSim;
 
 void MocoDirectCollocationSolver::constructProperties() {
@@ -40,8 +43,43 @@ void MocoDirectCollocationSolver::constructProperties() {
     constructProperty_implicit_auxiliary_derivative_bounds({-1000, 1000});
     constructProperty_minimize_lagrange_multipliers(false);
     constructProperty_lagrange_multiplier_weight(1.0);
+    constructProperty_mesh_refinement_max_iterations(0);
+    constructProperty_mesh_refinement_tolerance(1e-4);
+    constructProperty_mesh_refinement_max_mesh_intervals(1000);
 }
 
 void MocoDirectCollocationSolver::setMesh(const std::vector<double>& mesh) {
     for (int i = 0; i < (int)mesh.size(); ++i) { set_mesh(i, mesh[i]); }
 }
+
+std::vector<double> MocoDirectCollocationSolver::refineMesh(
+        const std::vector<double>& mesh,
+        const std::vector<double>& meshIntervalErrors) const {
+    OPENSIM_THROW_IF_FRMOBJ(meshIntervalErrors.size() + 1 != mesh.size(),
+            Exception, "Expected {} mesh interval errors, but got {}.",
+            mesh.size() - 1, meshIntervalErrors.size());
+    // The local error is proportional to h^3 for trapezoidal transcription
+    // and to h^5 for Hermite-Simpson transcription, so dividing an interval
+    // into n intervals reduces the error by about n^3 or n^5.
+    const double exponent =
+            get_transcription_scheme() == "trapezoidal" ? 1.0 / 3.0 : 0.2;
+    const double tolerance = get_mesh_refinement_tolerance();
+    std::vector<double> newMesh{mesh[0]};
+    for (int imesh = 0; imesh < (int)meshIntervalErrors.size(); ++imesh) {
+        int numDivisions = 1;
+        if (meshIntervalErrors[imesh] > tolerance) {
+            const double ratio = std::pow(
+                    meshIntervalErrors[imesh] / tolerance, exponent);
+            numDivisions = 2;
+            if (SimTK::isFinite(ratio)) {
+                numDivisions = std::min(5, std::max(2, (int)std::ceil(ratio)));
+            }
+        }
+        const double h = (mesh[imesh + 1] - mesh[imesh]) / numDivisions;
+        for (int k = 1; k < numDivisions; ++k) {
+            newMesh.push_back(mesh[imesh] + k * h);
+        }
+        newMesh.push_back(mesh[imesh + 1]);
+    }
+    return newMesh;
+}
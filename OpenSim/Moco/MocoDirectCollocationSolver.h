@@ -58,6 +58,24 @@ constraints on controls (e.g., MocoControlBoundConstraint). If
 `interpolate_control_midpoints` is false, the values of a control at
 midpoints may differ greatly from the values at mesh interval endpoints.
 
+Mesh refinement
+---------------
+Accurate solutions often require many mesh intervals, but usually only in
+parts of the trajectory (e.g., around heel strike). Setting
+`mesh_refinement_max_iterations` to a positive number enables automatic mesh
+refinement: the problem is first solved on the mesh given by
+`num_mesh_intervals` (or `mesh`), which can then be coarse. The local error of
+the solution in each mesh interval is estimated from the truncation error of
+the transcription scheme, using the state derivatives at neighboring grid
+points, and is taken relative to the largest magnitude of each state. Each
+mesh interval whose error exceeds `mesh_refinement_tolerance` is divided
+into 2 to 5 intervals, depending on how much the error exceeds the
+tolerance, and the problem is solved again on the new mesh, using the
+previous solution as the initial guess. Refinement stops once all errors are
+below the tolerance, after `mesh_refinement_max_iterations` refinements, or
+if the new mesh would have more than `mesh_refinement_max_mesh_intervals`
+intervals. Mesh refinement is supported only by MocoCasADiSolver.
+
 Multibody dynamics mode
 -----------------------
 The `multibody_dynamics_mode` setting allows you to choose between
@@ -152,6 +170,18 @@ public:
             "Bounds on derivative variables for components with auxiliary "
             "dynamics in implicit form. Default: [-1000, 1000]");
 
+    OpenSim_DECLARE_PROPERTY(mesh_refinement_max_iterations, int,
+            "Maximum number of times the mesh is refined and the problem "
+            "solved again (default: 0, no mesh refinement). "
+            "See the class description.");
+    OpenSim_DECLARE_PROPERTY(mesh_refinement_tolerance, double,
+            "The largest acceptable estimated error in a mesh interval, "
+            "relative to the magnitude of the states, when refining the mesh "
+            "(default: 1e-4).");
+    OpenSim_DECLARE_PROPERTY(mesh_refinement_max_mesh_intervals, int,
+            "Mesh refinement stops rather than creating a mesh with more "
+            "intervals than this (default: 1000).");
+
     MocoDirectCollocationSolver() { constructProperties(); }
 
     /** %Set the mesh to a user-defined list of mesh points to sample. This
@@ -167,6 +197,14 @@ protected:
             "Usually non-uniform, user-defined list of mesh points to sample. "
             "Takes precedence over uniform mesh with num_mesh_intervals.");
     void constructProperties();
+
+    /// Divide each interval of the mesh whose estimated error exceeds
+    /// mesh_refinement_tolerance into 2 to 5 equal intervals, depending on
+    /// how much the error exceeds the tolerance and on the order of the
+    /// transcription scheme. The returned mesh equals `mesh` if no
+    /// interval needs to be refined.
+    std::vector<double> refineMesh(const std::vector<double>& mesh,
+            const std::vector<double>& meshIntervalErrors) const;
 };
 
 } // namespace OpenSim
@@ -89,6 +89,18 @@ MocoSolution MocoSolver::solve() const {
     return solveImpl();
 }
 
+std::vector<MocoSolution> MocoSolver::solveSweep(
+        const std::vector<MocoSweepVariation>& variations) const {
+    OPENSIM_THROW_IF(!m_problem, Exception, "Problem not set.");
+    return solveSweepImpl(variations);
+}
+
+std::vector<MocoSolution> MocoSolver::solveSweepImpl(
+        const std::vector<MocoSweepVariation>&) const {
+    OPENSIM_THROW_FRMOBJ(Exception,
+            "{} does not support solving sweeps.", getConcreteClassName());
+}
+
 void MocoSolver::setSolutionStats(MocoSolution& sol, bool success,
         double objective,
         const std::string& status, int numIterations, double duration,
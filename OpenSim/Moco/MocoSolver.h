@@ -25,10 +25,37 @@
 
 #include <OpenSim/Common/Object.h>
 
+#include <map>
+
 namespace OpenSim {
 
 class MocoStudy;
 
+#ifndef SWIG
+/** Changes to a MocoProblem for one of the solves of MocoStudy::solveSweep().
+Everything not changed here is taken from the MocoProblem and the solver. */
+struct OSIMMOCO_API MocoSweepVariation {
+    /// The initial guess. If empty, the solver's guess is used.
+    MocoTrajectory guess;
+    /// Weights of goals in cost mode, by goal name, replacing the weights
+    /// set in the MocoProblem. Goals whose weight in the MocoProblem is 0
+    /// cannot be given a different weight.
+    std::map<std::string, double> goal_weights;
+    /// Bounds on states, controls, and parameters, by name, replacing the
+    /// bounds set in the MocoProblem. The initial and final bounds of states
+    /// and controls are clipped to these bounds.
+    std::map<std::string, MocoBounds> bounds;
+    /// Initial bounds on states and controls, by name.
+    std::map<std::string, MocoInitialBounds> initial_bounds;
+    /// Final bounds on states and controls, by name.
+    std::map<std::string, MocoFinalBounds> final_bounds;
+    /// Bounds on the initial time, if set.
+    MocoInitialBounds time_initial_bounds;
+    /// Bounds on the final time, if set.
+    MocoFinalBounds time_final_bounds;
+};
+#endif
+
 /** Once the solver is created, you should not make any edits to the
 MocoProblem. If you do, you must call resetProblem(const MocoProblem&
 problem). */
@@ -109,6 +136,17 @@ private:
     /// This is the meat of a solver: solve the problem and return the solution.
     virtual MocoSolution solveImpl() const = 0;
 
+#ifndef SWIG
+    /// This is called by MocoStudy::solveSweep().
+    std::vector<MocoSolution> solveSweep(
+            const std::vector<MocoSweepVariation>& variations) const;
+    /// Solve the problem once for each variation. Solvers that can share the
+    /// setup of the problem between the solves should override this; the
+    /// default implementation throws an exception.
+    virtual std::vector<MocoSolution> solveSweepImpl(
+            const std::vector<MocoSweepVariation>& variations) const;
+#endif
+
     mutable SimTK::ReferencePtr<const MocoProblem> m_problem;
     mutable SimTK::ResetOnCopy<MocoProblemRep> m_problemRep;
 
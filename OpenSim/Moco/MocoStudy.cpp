@@ -102,6 +102,12 @@ MocoSolution MocoStudy::solve() const {
     return solution;
 }
 
+std::vector<MocoSolution> MocoStudy::solveSweep(
+        const std::vector<MocoSweepVariation>& variations) const {
+    initSolverInternal();
+    return get_solver().solveSweep(variations);
+}
+
 void MocoStudy::visualize(const MocoTrajectory& it) const {
     // TODO this does not need the Solver at all, so this could be moved to
     // MocoProblem.
@@ -149,6 +149,32 @@ public:
     /// until you acknowledge the failure by invoking MocoSolution::unseal().
     MocoSolution solve() const;
 
+#ifndef SWIG
+    /// Solve the problem once for each of the given variations, which may
+    /// change the weights of goals, the bounds on variables, and the initial
+    /// guess (e.g., for a parameter sweep, or for starting the solver from
+    /// several initial guesses). This is faster than changing the problem
+    /// and calling solve() for each variation, because the problem is set up
+    /// only once: the model is initialized, and the nonlinear program and its
+    /// derivatives are constructed, a single time, and the solves differ
+    /// only in the numbers passed to the optimization solver. The solves are
+    /// performed one after the other; use the solver's settings for parallel
+    /// evaluation (e.g., MocoCasADiSolver's `parallel` property) to use
+    /// multiple threads within each solve. The solutions are not written to
+    /// files.
+    /// Only MocoCasADiSolver supports sweeps, and mesh refinement is not
+    /// supported for sweeps.
+    /// @code{.cpp}
+    /// std::vector<MocoSweepVariation> variations(5);
+    /// for (int i = 0; i < 5; ++i) {
+    ///     variations[i].goal_weights["effort"] = std::pow(10.0, i - 2);
+    /// }
+    /// std::vector<MocoSolution> solutions = study.solveSweep(variations);
+    /// @endcode
+    std::vector<MocoSolution> solveSweep(
+            const std::vector<MocoSweepVariation>& variations) const;
+#endif
+
     /// Interactively visualize a trajectory using the simbody-visualizer. The
     /// trajectory could be an initial guess, a solution, etc.
     /// @precondition
@@ -320,6 +320,11 @@ MocoSolution MocoTropterSolver::solveImpl() const {
     OPENSIM_THROW_IF_FRMOBJ(getProblemRep().isPrescribedKinematics(), Exception,
             "MocoTropterSolver does not support prescribed kinematics. "
             "Try using prescribed motion constraints in the Coordinates.");
+    OPENSIM_THROW_IF_FRMOBJ(get_mesh_refinement_max_iterations() > 0,
+            Exception,
+            "MocoTropterSolver does not support mesh refinement. "
+            "Set 'mesh_refinement_max_iterations' to 0 or use "
+            "MocoCasADiSolver.");
 
     auto ocp = createTropterProblem();
 
@@ -459,3 +459,49 @@ TEST_CASE("Implicit auxiliary dynamics") {
                                 "with implicit auxiliary dynamics."));
     }
 }
+
+TEST_CASE("Jacobians computed in a callback match those from CasADi",
+        "[implicit][casadi]") {
+    auto dynamics_mode = GENERATE(as<std::string>{}, "implicit", "explicit");
+    auto solve = [&](const std::string& jacobian_mode,
+                         const std::string& sparsity_detection) {
+        MocoStudy study;
+        auto& problem = study.updProblem();
+        problem.setModelAsCopy(ModelFactory::createDoublePendulum());
+        problem.setTimeBounds(0, 1);
+        problem.setStateInfo("/jointset/j0/q0/value", {-10, 10}, 0, 0.5);
+        problem.setStateInfo("/jointset/j0/q0/speed", {-50, 50}, 0, 0);
+        problem.setStateInfo("/jointset/j1/q1/value", {-10, 10}, 0, -0.5);
+        problem.setStateInfo("/jointset/j1/q1/speed", {-50, 50}, 0, 0);
+        problem.setControlInfo("/tau0", {-100, 100});
+        problem.setControlInfo("/tau1", {-100, 100});
+        problem.addGoal<MocoControlGoal>();
+
+        auto& solver = study.initCasADiSolver();
+        solver.set_multibody_dynamics_mode(dynamics_mode);
+        solver.set_num_mesh_intervals(20);
+        solver.set_optim_jacobian_mode(jacobian_mode);
+        solver.set_optim_sparsity_detection(sparsity_detection);
+        MocoSolution solution = study.solve();
+        REQUIRE(solution.success());
+        return solution;
+    };
+    MocoSolution solutionCasADi = solve("casadi", "none");
+    MocoSolution solutionCallback = solve("callback", "none");
+    CHECK(solutionCallback.compareContinuousVariablesRMS(
+                  solutionCasADi, {{"states", {}}}) < 1e-4);
+    CHECK(solutionCallback.compareContinuousVariablesRMS(
+                  solutionCasADi, {{"controls", {}}}) < 1e-3);
+    CHECK(solutionCallback.getObjective() ==
+            Approx(solutionCasADi.getObjective()).epsilon(1e-6));
+
+    SECTION("Colored finite differences") {
+        MocoSolution solutionColored = solve("colored", "random");
+        CHECK(solutionColored.compareContinuousVariablesRMS(
+                      solutionCasADi, {{"states", {}}}) < 1e-4);
+        CHECK(solutionColored.compareContinuousVariablesRMS(
+                      solutionCasADi, {{"controls", {}}}) < 1e-3);
+        CHECK(solutionColored.getObjective() ==
+                Approx(solutionCasADi.getObjective()).epsilon(1e-6));
+    }
+}
@@ -1231,6 +1231,126 @@ TEMPLATE_TEST_CASE(
     // after they get the mutable reference.
 }
 
+TEST_CASE("Mesh refinement", "[casadi]") {
+    auto transcriptionScheme =
+            GENERATE(as<std::string>{}, "trapezoidal", "hermite-simpson");
+    // A passive pendulum released from a large angle; the solution is a
+    // forward simulation, so the accuracy depends only on the mesh.
+    MocoStudy study;
+    study.setName("pendulum");
+    study.set_write_solution("false");
+    auto& problem = study.updProblem();
+    problem.setModel(createPendulumModel());
+    problem.setTimeBounds(0, 2);
+    problem.setStateInfo("/jointset/j0/q0/value", {-10, 10}, 0.75 * SimTK::Pi);
+    problem.setStateInfo("/jointset/j0/q0/speed", {-50, 50}, 0);
+    problem.setControlInfo("/forceset/tau0", 0);
+    auto& solver = study.initSolver<MocoCasADiSolver>();
+    solver.set_transcription_scheme(transcriptionScheme);
+    solver.set_num_mesh_intervals(200);
+    const MocoSolution fine = study.solve();
+    REQUIRE(fine.success());
+
+    solver.set_num_mesh_intervals(5);
+    const MocoSolution coarse = study.solve();
+    REQUIRE(coarse.success());
+
+    solver.set_mesh_refinement_max_iterations(10);
+    solver.set_mesh_refinement_tolerance(1e-5);
+    MocoSolution refined = study.solve();
+    REQUIRE(refined.success());
+    // The mesh was refined, but is still much coarser than the fine mesh.
+    CHECK(refined.getNumTimes() > coarse.getNumTimes());
+    CHECK(refined.getNumTimes() < fine.getNumTimes());
+    // The refined solution is closer to the fine solution.
+    CHECK(refined.compareContinuousVariablesRMS(fine, {{"states", {}}}) <
+            coarse.compareContinuousVariablesRMS(fine, {{"states", {}}}));
+    CHECK(refined.compareContinuousVariablesRMS(fine, {{"states", {}}}) <
+            1e-2);
+
+    SECTION("Refinement stops at the maximum number of mesh intervals") {
+        solver.set_mesh_refinement_max_mesh_intervals(8);
+        MocoSolution limited = study.solve();
+        CHECK(limited.getNumTimes() <= refined.getNumTimes());
+        CHECK((transcriptionScheme == "trapezoidal"
+                        ? limited.getNumTimes() - 1
+                        : (limited.getNumTimes() - 1) / 2) <= 8);
+    }
+
+    SECTION("Invalid settings") {
+        solver.set_mesh_refinement_max_iterations(-1);
+        CHECK_THROWS(study.solve());
+    }
+}
+
+TEST_CASE("Mesh refinement is not supported by MocoTropterSolver",
+        "[tropter]") {
+    MocoStudy study = createSlidingMassMocoStudy<MocoTropterSolver>();
+    auto& solver = study.initSolver<MocoTropterSolver>();
+    solver.set_mesh_refinement_max_iterations(1);
+    CHECK_THROWS_WITH(study.solve(),
+            Catch::Contains("does not support mesh refinement"));
+}
+
+TEST_CASE("Sweep", "[casadi]") {
+    MocoStudy study;
+    study.setName("sliding_mass");
+    MocoProblem& problem = study.updProblem();
+    problem.setModel(createSlidingMassModel());
+    problem.setTimeBounds(0, {0, 10});
+    problem.setStateInfo("/slider/position/value", {0, 1}, 0, 1);
+    problem.setStateInfo("/slider/position/speed", {-100, 100}, 0, 0);
+    problem.addGoal<MocoFinalTimeGoal>("time");
+    auto& solver = study.initCasADiSolver();
+    solver.set_num_mesh_intervals(19);
+    solver.set_transcription_scheme("trapezoidal");
+    const MocoSolution solution = study.solve();
+    REQUIRE(solution.success());
+
+    std::vector<MocoSweepVariation> variations(4);
+    // variations[0] does not change the problem.
+    // Quadrupling the maximum force halves the final time.
+    variations[1].bounds["/actuator"] = MocoBounds(-40, 40);
+    // The weight scales the objective but does not change the trajectory.
+    variations[2].goal_weights["time"] = 3.0;
+    // Multi-start: a different initial guess leads to the same solution.
+    variations[3].guess = solver.createGuess("random");
+
+    const std::vector<MocoSolution> solutions = study.solveSweep(variations);
+    REQUIRE(solutions.size() == variations.size());
+    for (const auto& sol : solutions) { REQUIRE(sol.success()); }
+
+    CHECK(solutions[0].getObjective() == Approx(solution.getObjective()));
+    CHECK(solutions[0].compareContinuousVariablesRMS(solution) < 1e-6);
+
+    CHECK(solutions[1].getFinalTime() ==
+            Approx(0.5 * solution.getFinalTime()).epsilon(1e-2));
+    CHECK(solutions[1].getControl("/actuator")[0] == Approx(40).epsilon(1e-3));
+
+    CHECK(solutions[2].getObjective() ==
+            Approx(3.0 * solution.getObjective()).epsilon(1e-6));
+    CHECK(solutions[2].compareContinuousVariablesRMS(solution) < 1e-4);
+
+    CHECK(solutions[3].compareContinuousVariablesRMS(solution) < 1e-3);
+
+    SECTION("Invalid variations") {
+        std::vector<MocoSweepVariation> invalid(1);
+        invalid[0].goal_weights["nonexistent"] = 1.0;
+        CHECK_THROWS_WITH(study.solveSweep(invalid),
+                Catch::Contains("goal in cost mode named 'nonexistent'"));
+        invalid[0] = MocoSweepVariation();
+        invalid[0].bounds["/nonexistent"] = MocoBounds(0, 1);
+        CHECK_THROWS_WITH(study.solveSweep(invalid),
+                Catch::Contains("named '/nonexistent'"));
+    }
+}
+
+TEST_CASE("Sweeps are not supported by MocoTropterSolver", "[tropter]") {
+    MocoStudy study = createSlidingMassMocoStudy<MocoTropterSolver>();
+    CHECK_THROWS_WITH(study.solveSweep({MocoSweepVariation()}),
+            Catch::Contains("does not support solving sweeps"));
+}
+
 TEMPLATE_TEST_CASE("Guess time-stepping", "[tropter]",
         MocoTropterSolver /*, MocoCasADiSolver*/) {
     // This problem is just a simulation (there are no costs), and so the
@@ -23,8 +23,12 @@
 
 #include "InverseDynamicsSolver.h"
 #include "Model/Model.h"
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/FunctionSet.h>
 
+#include <algorithm>
+#include <memory>
+
 using namespace std;
 using namespace SimTK;
 
@@ -195,4 +199,82 @@ void InverseDynamicsSolver::solve(SimTK::State& s, const FunctionSet& Qs,
     }
 }
 
+Matrix InverseDynamicsSolver::solve(const SimTK::State& s,
+        const FunctionSet& Qs,
+        const std::vector<int>& coordinatesToSpeedsIndexMap,
+        const Array_<double>& times, int numThreads) {
+    const int nq = s.getNQ();
+    const int nu = s.getNU();
+    const int nt = (int)times.size();
+
+    OPENSIM_THROW_IF(Qs.getSize() != nq, Exception,
+            "InverseDynamicsSolver::solve invalid number of q functions.");
+    OPENSIM_THROW_IF((int)coordinatesToSpeedsIndexMap.size() != nu,
+            Exception, "InverseDynamicsSolver::solve "
+            "coordinatesToSpeedsIndexMap must be 'nu' long");
+
+    // Evaluate the functions and their derivatives at all times, one
+    // function at a time, reusing the argument vector and derivative
+    // components. This is done on this thread because Functions create their
+    // underlying SimTK::Function on first use.
+    Matrix values(nt, nq), firstDerivs(nt, nq), secondDerivs(nt, nq);
+    Vector arg(1);
+    const std::vector<int> first(1, 0);
+    const std::vector<int> second(2, 0);
+    for (int j = 0; j < nq; ++j) {
+        const Function& func = Qs.get(j);
+        for (int i = 0; i < nt; ++i) {
+            arg[0] = times[i];
+            values(i, j) = func.calcValue(arg);
+            firstDerivs(i, j) = func.calcDerivative(first, arg);
+            secondDerivs(i, j) = func.calcDerivative(second, arg);
+        }
+    }
+
+    numThreads = std::min(getNumThreadsToUse(numThreads), std::max(nt, 1));
+
+    // Realizing a model writes to the caches of its components (e.g., the
+    // transforms of frames and the wrapping of paths), so every thread but the
+    // first solves with its own copy of the model. The state of each
+    // copy takes the time and state variables of `s`, and whether each force
+    // is applied (as tools disable forces in `s`). As in AnalyzeTool, the
+    // copies are made, and their systems initialized, serially.
+    std::vector<std::unique_ptr<Model>> models(numThreads - 1);
+    std::vector<std::unique_ptr<InverseDynamicsSolver>> copies(numThreads - 1);
+    std::vector<InverseDynamicsSolver*> solvers(numThreads, this);
+    std::vector<SimTK::State> states(numThreads, s);
+    for (int thread = 1; thread < numThreads; ++thread) {
+        models[thread - 1].reset(getModel().clone());
+        states[thread] = models[thread - 1]->initSystem();
+        states[thread].updTime() = s.getTime();
+        states[thread].updY() = s.getY();
+        const auto forces = getModel().getComponentList<Force>();
+        auto force = forces.begin();
+        for (const auto& copy : models[thread - 1]->getComponentList<Force>())
+            copy.setAppliesForce(states[thread], (force++)->appliesForce(s));
+        copies[thread - 1] = OpenSim::make_unique<InverseDynamicsSolver>(
+                *models[thread - 1]);
+        solvers[thread] = copies[thread - 1].get();
+    }
+
+    std::vector<Vector> udots(numThreads, Vector(nu));
+    Matrix genForces(nt, nu);
+    executeInParallel(nt, numThreads, [&](int i, int thread) {
+        SimTK::State& state = states[thread];
+        Vector& udot = udots[thread];
+        state.updTime() = times[i];
+        Vector& q = state.updQ();
+        Vector& u = state.updU();
+        for (int j = 0; j < nq; ++j) q[j] = values(i, j);
+        for (int j = 0; j < nu; ++j) {
+            const int iq = coordinatesToSpeedsIndexMap[j];
+            u[j] = firstDerivs(i, iq);
+            udot[j] = secondDerivs(i, iq);
+        }
+        genForces[i] = ~solvers[thread]->solve(state, udot);
+    });
+
+    return genForces;
+}
+
 } // end of namespace OpenSim
\ No newline at end of file
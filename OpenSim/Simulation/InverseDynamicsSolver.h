@@ -121,6 +121,22 @@ public:
             const std::vector<int> coordinatesToSpeedsIndexMap,
             const SimTK::Array_<double>& times,
             SimTK::Array_<SimTK::Vector>& genForceTrajectory);
+
+    /** Solve for the generalized-coordinate forces at all the given times at
+       once, and return them as a matrix with a row for each time and a column
+       for each u. The coordinate functions and their first and second
+       derivatives are evaluated for all the times first; the times are then
+       solved on `numThreads` threads (0 to use as many threads as the hardware
+       supports). Every thread but the first works on its own copy of the
+       model, whose state is set from `s`. The results do not depend on
+       the number of threads. As above, coordinatesToSpeedsIndexMap gives, for
+       each u, the index of the function in Qs from which u and udot are
+       calculated.
+       Unlike the solvers above, this does not step the model's analyses, and
+       does not change `s`. */
+    SimTK::Matrix solve(const SimTK::State& s, const FunctionSet& Qs,
+            const std::vector<int>& coordinatesToSpeedsIndexMap,
+            const SimTK::Array_<double>& times, int numThreads);
 #endif
 //=============================================================================
 };  // END of class InverseDynamicsSolver
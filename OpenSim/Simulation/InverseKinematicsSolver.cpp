@@ -25,6 +25,8 @@
 #include "Model/Model.h"
 #include "Model/MarkerSet.h"
 
+#include <OpenSim/Common/CommonUtilities.h>
+
 #include "simbody/internal/AssemblyCondition_Markers.h"
 #include "simbody/internal/AssemblyCondition_OrientationSensors.h"
 
@@ -122,6 +124,104 @@ InverseKinematicsSolver::InverseKinematicsSolver(const Model& model,
     }
 }
 
+SimTK::Matrix InverseKinematicsSolver::trackInParallel(const SimTK::State& s,
+        const SimTK::Array_<double>& times, int numThreads, int numWindows,
+        int numOverlapFrames) const
+{
+    OPENSIM_THROW_IF(numThreads < 0, Exception,
+            "Expected numThreads to be non-negative, but got {}.", numThreads);
+    OPENSIM_THROW_IF(numWindows < 0, Exception,
+            "Expected numWindows to be non-negative, but got {}.", numWindows);
+    OPENSIM_THROW_IF(numOverlapFrames < 0, Exception,
+            "Expected numOverlapFrames to be non-negative, but got {}.",
+            numOverlapFrames);
+
+    const int numTimes = (int)times.size();
+    const int nq = s.getNQ();
+    SimTK::Matrix q(numTimes, nq);
+    if (numTimes == 0) return q;
+
+    // The default layout must not depend on the number of threads, since
+    // the result depends on the layout.
+    if (numWindows == 0)
+        numWindows = (numTimes + DefaultNumFramesPerWindow - 1) /
+                     DefaultNumFramesPerWindow;
+    numWindows = std::min(numWindows, numTimes);
+    numThreads = std::min(getNumThreadsToUse(numThreads), numWindows);
+
+    // Window iw keeps the solutions for frames
+    // [windowBegin[iw], windowBegin[iw + 1]).
+    std::vector<int> windowBegin(numWindows + 1);
+    for (int iw = 0; iw <= numWindows; ++iw) {
+        windowBegin[iw] = int((long long)iw * numTimes / numWindows);
+    }
+
+    // Each thread gets its own copy of the model. Copying and initializing
+    // the models is done serially, before any of the threads start.
+    std::vector<std::unique_ptr<Model>> models(numThreads);
+    std::vector<SimTK::State> defaultStates(numThreads);
+    for (int ithread = 0; ithread < numThreads; ++ithread) {
+        models[ithread].reset(getModel().clone());
+        defaultStates[ithread] = models[ithread]->initSystem();
+    }
+
+    // The solution from the last overlap frame of each window, to compare
+    // with the solution for the same frame from the preceding window.
+    std::vector<SimTK::Vector> lastOverlapQ(numWindows);
+
+    executeInParallel(numWindows, numThreads, [&](int iw, int ithread) {
+        // The references hold mutable caches, so each window uses its own.
+        std::shared_ptr<MarkersReference> markersReference(
+                _markersReference ? _markersReference->clone() : nullptr);
+        std::shared_ptr<OrientationsReference> orientationsReference(
+                _orientationsReference ? _orientationsReference->clone()
+                                       : nullptr);
+        SimTK::Array_<CoordinateReference> coordinateReferences =
+                getCoordinateReferences();
+        InverseKinematicsSolver solver(*models[ithread], markersReference,
+                orientationsReference, coordinateReferences,
+                getConstraintWeight());
+        solver.setAccuracy(getAccuracy());
+
+        SimTK::State windowState = defaultStates[ithread];
+        windowState.updQ() = s.getQ();
+
+        const int first = std::max(0, windowBegin[iw] - numOverlapFrames);
+        windowState.updTime() = times[first];
+        solver.assemble(windowState);
+        for (int i = first; i < windowBegin[iw + 1]; ++i) {
+            windowState.updTime() = times[i];
+            solver.track(windowState);
+            if (i >= windowBegin[iw]) {
+                q.updRow(i) = ~windowState.getQ();
+            } else if (i == windowBegin[iw] - 1) {
+                lastOverlapQ[iw] = windowState.getQ();
+            }
+        }
+    });
+
+    // Report how well the windows agree where they meet.
+    double maxDiscrepancy = 0;
+    for (int iw = 1; iw < numWindows; ++iw) {
+        if (lastOverlapQ[iw].size() == 0) continue;
+        const SimTK::Vector qPreceding = ~q.row(windowBegin[iw] - 1);
+        maxDiscrepancy = std::max(maxDiscrepancy,
+                (lastOverlapQ[iw] - qPreceding).normInf());
+    }
+    if (maxDiscrepancy > 10 * getAccuracy()) {
+        log_warn("InverseKinematicsSolver::trackInParallel(): solutions from "
+                 "consecutive windows differ by up to {} where they meet; "
+                 "consider increasing numOverlapFrames (currently {}).",
+                maxDiscrepancy, numOverlapFrames);
+    } else {
+        log_debug("InverseKinematicsSolver::trackInParallel(): solutions "
+                  "from consecutive windows differ by up to {} where they "
+                  "meet.", maxDiscrepancy);
+    }
+
+    return q;
+}
+
 int InverseKinematicsSolver::getNumMarkersInUse() const
 {
     return _markerAssemblyCondition->getNumMarkers();
@@ -124,6 +124,49 @@ public:
         to track a desired trajectory of coordinate values. */
     //virtual void track(SimTK::State &s);
 
+    /** The number of times per window that trackInParallel() uses by
+        default. */
+    static constexpr int DefaultNumFramesPerWindow = 100;
+
+    /** Solve for the model coordinates at each of the provided times, using
+        several threads. The times are split into `numWindows` contiguous
+        windows of (nearly) equal length, and each window is solved on its own
+        copy of the model, state and solver. Within a window, the solution is
+        warm-started from the previous frame, just as when calling track()
+        repeatedly. So that the first frame kept from each window is also
+        warm-started, every window except the first starts
+        `numOverlapFrames` frames earlier; the window is assembled at its
+        first frame and then tracks through the overlap, whose solutions
+        are discarded in favor of those from the preceding window. The
+        largest difference between the two solutions where consecutive
+        windows meet is written to the log; a large difference indicates that
+        the windows converged to different local minima, and that more
+        overlap frames are needed.
+
+        The result depends only on the arguments, not on the number of
+        threads or the order in which the windows are solved. The first window
+        is solved exactly as assemble() followed by track() at every time
+        would solve it.
+
+        This solver is not modified; in particular, its current solution (as
+        used by computeCurrentMarkerLocations(), etc.) is unchanged.
+
+        @param s The initial guess for assembling each window; only the
+            generalized coordinates (q) are used.
+        @param times The times at which to solve, in increasing order.
+        @param numThreads The number of threads to use. If 0, use the number
+            of concurrent threads supported by the hardware.
+        @param numWindows The number of windows into which to split the
+            times. If 0, use one window per DefaultNumFramesPerWindow times
+            (rounded up), so that the result does not depend on the machine.
+        @param numOverlapFrames The number of frames each window (except the
+            first) solves before its own first frame.
+        @returns A matrix with a row for each time and a column for each
+            generalized coordinate (in the order of the state's q). */
+    SimTK::Matrix trackInParallel(const SimTK::State& s,
+            const SimTK::Array_<double>& times, int numThreads = 0,
+            int numWindows = 0, int numOverlapFrames = 10) const;
+
     /** Return the number of markers used to solve for model coordinates.
         It is a count of the number of markers in the intersection of 
         the reference markers and model markers.
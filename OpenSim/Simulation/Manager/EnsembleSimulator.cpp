@@ -0,0 +1,137 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  EnsembleSimulator.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "EnsembleSimulator.h"
+
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/Reporter.h>
+#include <OpenSim/Common/Stopwatch.h>
+
+#include <simbody/internal/Integrator.h>
+
+using namespace OpenSim;
+
+EnsembleSimulator::EnsembleSimulator(const Model& model)
+        : _model(model.clone()) {}
+
+std::vector<EnsembleRunResult> EnsembleSimulator::run(int numRuns) const {
+    OPENSIM_THROW_IF(numRuns < 0, Exception,
+            "Expected numRuns to be non-negative, but got {}.", numRuns);
+    OPENSIM_THROW_IF(_numThreads < 0, Exception,
+            "Expected numThreads to be non-negative, but got {}.",
+            _numThreads);
+    OPENSIM_THROW_IF(!(_finalTime >= _initialTime), Exception,
+            "Expected the final time ({}) to be at least the initial time "
+            "({}).", _finalTime, _initialTime);
+
+    std::vector<EnsembleRunResult> results(numRuns);
+    if (numRuns == 0) return results;
+
+    const int numWorkers = std::min(getNumThreadsToUse(_numThreads), numRuns);
+    log_info("Simulating an ensemble of {} run(s) of model '{}' using {} "
+             "thread(s).", numRuns, _model->getName(), numWorkers);
+
+    // Each worker gets its own copy of the model, whose system is initialized
+    // once (serially, before any of the workers start) and then reused for
+    // all the runs the worker performs.
+    std::vector<std::unique_ptr<Model>> models(numWorkers);
+    std::vector<SimTK::State> initialStates(numWorkers);
+    for (int iw = 0; iw < numWorkers; ++iw) {
+        models[iw].reset(_model->clone());
+        models[iw]->setUseVisualizer(false);
+        initialStates[iw] = models[iw]->initSystem();
+    }
+
+    Stopwatch watch;
+    executeInParallel(numRuns, numWorkers, [&](int irun, int iworker) {
+        Model& model = *models[iworker];
+        EnsembleRunResult& result = results[irun];
+        result.runIndex = irun;
+        Stopwatch runWatch;
+        try {
+            if (_propertyPerturbation) {
+                _propertyPerturbation(irun, model);
+                initialStates[iworker] = model.initSystem();
+            }
+            simulate(model, initialStates[iworker], result);
+        } catch (const std::exception& ex) {
+            result.success = false;
+            result.errorMessage = ex.what();
+        }
+        result.wallTime = runWatch.getElapsedTime();
+    });
+
+    int numFailed = 0;
+    for (const auto& result : results) {
+        if (!result.success) {
+            ++numFailed;
+            log_warn("Run {} failed: {}", result.runIndex,
+                    result.errorMessage);
+        }
+    }
+    log_info("Ensemble of {} run(s) completed in {} ({} failed).", numRuns,
+            watch.getElapsedTimeFormatted(), numFailed);
+    return results;
+}
+
+void EnsembleSimulator::simulate(Model& model,
+        const SimTK::State& initialState, EnsembleRunResult& result) const {
+    SimTK::State state = initialState;
+    state.setTime(_initialTime);
+    if (_statePerturbation) _statePerturbation(result.runIndex, model, state);
+
+    for (auto& reporter : model.updComponentList<TableReporter>()) {
+        reporter.clearTable();
+    }
+
+    Manager manager(model);
+    manager.setWriteToStorage(_recordStates);
+    manager.setPerformAnalyses(false);
+    manager.setIntegratorMethod(_integratorMethod);
+    if (!SimTK::isNaN(_integratorAccuracy)) {
+        manager.setIntegratorAccuracy(_integratorAccuracy);
+    }
+    manager.initialize(state);
+    result.finalState = manager.integrate(_finalTime);
+
+    // Manager::integrate() returns early if the integrator fails.
+    const SimTK::Integrator& integ = manager.getIntegrator();
+    if (integ.isSimulationOver() && integ.getTerminationReason() !=
+            SimTK::Integrator::ReachedFinalTime) {
+        result.success = false;
+        result.errorMessage = "Integration failed: " +
+                integ.getTerminationReasonString(
+                        integ.getTerminationReason());
+        return;
+    }
+
+    if (_summaryFunction) {
+        result.summary = _summaryFunction(result.runIndex, model,
+                result.finalState);
+    }
+    for (const auto& reporter : model.getComponentList<TableReporter>()) {
+        result.reporterTables[reporter.getAbsolutePathString()] =
+                reporter.getTable();
+    }
+    if (_recordStates) result.states = manager.getStatesTable();
+    result.success = true;
+}
@@ -0,0 +1,165 @@
+#ifndef OPENSIM_ENSEMBLE_SIMULATOR_H_
+#define OPENSIM_ENSEMBLE_SIMULATOR_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  EnsembleSimulator.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Manager.h"
+#include <OpenSim/Common/TimeSeriesTable.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <functional>
+#include <map>
+
+namespace OpenSim {
+
+#ifndef SWIG
+/** The outcome of one run of an EnsembleSimulator. */
+struct OSIMSIMULATION_API EnsembleRunResult {
+    /** Index of the run (0 to the number of runs - 1). */
+    int runIndex = -1;
+    /** False if the run threw an exception or the integration failed. */
+    bool success = false;
+    /** The reason the run failed, if it did. */
+    std::string errorMessage;
+    /** The state at the end of the simulation. */
+    SimTK::State finalState;
+    /** The output of the summary function (see
+    EnsembleSimulator::setSummaryFunction()), if any. */
+    SimTK::Vector summary;
+    /** The table of each TableReporter in the model, keyed by the absolute
+    path of the reporter. */
+    std::map<std::string, TimeSeriesTable> reporterTables;
+    /** The states at every integration step, if requested (see
+    EnsembleSimulator::setRecordStates()). */
+    TimeSeriesTable states;
+    /** Wall-clock time spent on this run, in seconds. */
+    double wallTime = SimTK::NaN;
+};
+
+/** Simulate a model many times (an ensemble of forward simulations), e.g.,
+for Monte Carlo or sensitivity studies in which the properties or the initial
+state of the model are perturbed in each run. Runs are distributed among a
+number of threads. Each thread simulates its own copy of the model; the copies
+are made, and their systems initialized, once, and then reused for all the
+runs performed by that thread. Each run starts from the initial state of its
+copy of the model (at the initial time).
+
+The perturbations are provided as functions of the index of the run, so that
+the results do not depend on the thread that performs a run, or on the number
+of threads:
+@code
+EnsembleSimulator ensemble(model);
+ensemble.setFinalTime(1.0);
+ensemble.setStatePerturbation(
+        [](int run, const Model& model, SimTK::State& state) {
+    model.getCoordinateSet().get("q0").setValue(state, 0.01 * run);
+});
+ensemble.setSummaryFunction(
+        [](int run, const Model& model, const SimTK::State& state) {
+    model.realizeVelocity(state);
+    return SimTK::Vector(1, model.calcKineticEnergy(state));
+});
+const auto results = ensemble.run(1000);
+@endcode
+
+The tables of TableReporters in the model are collected for each run (and the
+reporters are cleared between runs), so reporters offer a way to record time
+series of any outputs. By default, the states are not recorded.
+
+Errors in a run (exceptions thrown by a perturbation or during integration)
+do not stop the other runs; they are reported in the EnsembleRunResult. */
+class OSIMSIMULATION_API EnsembleSimulator {
+public:
+    /** Change the properties of a copy of the model for a run. The copy is
+    reused for later runs on the same thread, so the function should set
+    (rather than, e.g., increment) all the properties it perturbs. Since
+    changes to properties take effect only once the system is initialized,
+    the system of the copy is initialized again for each run if this
+    function is provided. */
+    typedef std::function<void(int runIndex, Model& model)>
+            PropertyPerturbation;
+    /** Change the initial state for a run. */
+    typedef std::function<void(int runIndex, const Model& model,
+            SimTK::State& state)> StatePerturbation;
+    /** Compute a summary of a run from its final state. */
+    typedef std::function<SimTK::Vector(int runIndex, const Model& model,
+            const SimTK::State& finalState)> SummaryFunction;
+
+    /** The model is copied; later changes to `model` do not affect the
+    simulations. */
+    explicit EnsembleSimulator(const Model& model);
+
+    /** The number of threads to use. The default, 0, uses as many threads
+    as the hardware supports (see getNumThreadsToUse()). */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+
+    /** The time at which each run starts (default: 0). */
+    void setInitialTime(double time) { _initialTime = time; }
+    double getInitialTime() const { return _initialTime; }
+    /** The time at which each run ends (default: 1). */
+    void setFinalTime(double time) { _finalTime = time; }
+    double getFinalTime() const { return _finalTime; }
+
+    /** Integrator settings, applied to the Manager of each run. */
+    void setIntegratorMethod(Manager::IntegratorMethod method)
+    {   _integratorMethod = method; }
+    void setIntegratorAccuracy(double accuracy)
+    {   _integratorAccuracy = accuracy; }
+
+    /** Keep the states at every integration step of each run in
+    EnsembleRunResult::states (default: false). */
+    void setRecordStates(bool recordStates) { _recordStates = recordStates; }
+    bool getRecordStates() const { return _recordStates; }
+
+    void setPropertyPerturbation(PropertyPerturbation perturbation)
+    {   _propertyPerturbation = std::move(perturbation); }
+    void setStatePerturbation(StatePerturbation perturbation)
+    {   _statePerturbation = std::move(perturbation); }
+    void setSummaryFunction(SummaryFunction summary)
+    {   _summaryFunction = std::move(summary); }
+
+    /** Perform `numRuns` simulations and return their results, in the order
+    of the runs. */
+    std::vector<EnsembleRunResult> run(int numRuns) const;
+
+private:
+    void simulate(Model& model, const SimTK::State& initialState,
+            EnsembleRunResult& result) const;
+
+    std::unique_ptr<Model> _model;
+    int _numThreads = 0;
+    double _initialTime = 0;
+    double _finalTime = 1;
+    Manager::IntegratorMethod _integratorMethod =
+            Manager::IntegratorMethod::RungeKuttaMerson;
+    double _integratorAccuracy = SimTK::NaN;
+    bool _recordStates = false;
+    PropertyPerturbation _propertyPerturbation;
+    StatePerturbation _statePerturbation;
+    SummaryFunction _summaryFunction;
+};
+#endif // SWIG
+
+} // namespace OpenSim
+
+#endif // OPENSIM_ENSEMBLE_SIMULATOR_H_
@@ -30,7 +30,9 @@
 #include <OpenSim/Simulation/Model/AnalysisSet.h>
 #include <OpenSim/Simulation/Model/ControllerSet.h>
 #include <OpenSim/Common/Array.h>
+#include <OpenSim/Common/STOFileStream.h>
 
+#include <regex>
 
 using namespace OpenSim;
 using namespace std;
@@ -40,9 +42,22 @@ using namespace std;
 // STATICS
 //=============================================================================
 std::string Manager::_displayName = "Simulator";
+
+struct Manager::StatesRecorder {
+    /** Handles of the recorded state variables, if not all are recorded. */
+    std::vector<Component::StateVariableHandle> handles;
+    bool allStates{true};
+    SimTK::Vector values;
+    /** Writer for the file given to setRecordStatesToFile(). */
+    std::unique_ptr<STOFileWriter> writer;
+    int numStepsSinceRecorded{0};
+    double lastRecordedTime{-SimTK::Infinity};
+    double lastWrittenTime{-SimTK::Infinity};
+};
 //=============================================================================
 // DESTRUCTOR
 //=============================================================================
+Manager::~Manager() = default;
 
 
 //=============================================================================
@@ -97,6 +112,10 @@ setNull()
     _dt = 1.0e-4;
     _performAnalyses=true;
     _writeToStorage=true;
+    _recordEveryNSteps = 1;
+    _recordInterval = 0;
+    _recordStatesPattern = "";
+    _recordStatesFileName = "";
     _tArray.setSize(0);
     _dtArray.setSize(0);
 }
@@ -629,6 +648,126 @@ TimeSeriesTable Manager::getStatesTable() const {
     return getStateStorage().exportToTable();
 }
 
+//-----------------------------------------------------------------------------
+// STATE RECORDING
+//-----------------------------------------------------------------------------
+void Manager::setRecordEveryNSteps(int n)
+{
+    OPENSIM_THROW_IF(_statesRecorder != nullptr, Exception,
+        "Cannot change how states are recorded after integration started.");
+    OPENSIM_THROW_IF(n < 1, Exception,
+        "Expected the number of steps to be at least 1, but got {}.", n);
+    _recordEveryNSteps = n;
+}
+
+void Manager::setRecordInterval(double interval)
+{
+    OPENSIM_THROW_IF(_statesRecorder != nullptr, Exception,
+        "Cannot change how states are recorded after integration started.");
+    OPENSIM_THROW_IF(!(interval >= 0), Exception,
+        "Expected the interval to be non-negative, but got {}.", interval);
+    _recordInterval = interval;
+}
+
+void Manager::setRecordStatesMatching(const std::string& pattern)
+{
+    OPENSIM_THROW_IF(_statesRecorder != nullptr, Exception,
+        "Cannot change how states are recorded after integration started.");
+    _recordStatesPattern = pattern;
+}
+
+void Manager::setRecordStatesToFile(const std::string& fileName)
+{
+    OPENSIM_THROW_IF(_statesRecorder != nullptr, Exception,
+        "Cannot change how states are recorded after integration started.");
+    _recordStatesFileName = fileName;
+}
+
+void Manager::initializeStatesRecorder()
+{
+    _statesRecorder.reset(new StatesRecorder());
+    auto& recorder = *_statesRecorder;
+
+    const Array<std::string> allNames = _model->getStateVariableNames();
+    std::vector<std::string> names;
+    if (_recordStatesPattern.empty()) {
+        for (int i = 0; i < allNames.getSize(); ++i)
+            names.push_back(allNames[i]);
+    } else {
+        std::regex regex;
+        try {
+            regex = std::regex(_recordStatesPattern);
+        } catch (const std::regex_error& e) {
+            OPENSIM_THROW(Exception,
+                "Invalid pattern '{}' for the states to record: {}",
+                _recordStatesPattern, e.what());
+        }
+        for (int i = 0; i < allNames.getSize(); ++i) {
+            if (std::regex_match(allNames[i], regex))
+                names.push_back(allNames[i]);
+        }
+        recorder.handles = _model->getStateVariableHandles(names);
+        recorder.allStates = false;
+
+        if (hasStateStorage()) {
+            Array<string> columnLabels;
+            columnLabels.append("time");
+            for (const auto& name : names) columnLabels.append(name);
+            getStateStorage().setColumnLabels(columnLabels);
+        }
+    }
+
+    if (!_recordStatesFileName.empty()) {
+        ValueArrayDictionary metaData;
+        metaData.setValueForKey("inDegrees", std::string("no"));
+        recorder.writer.reset(
+                new STOFileWriter(_recordStatesFileName, names, metaData));
+    }
+}
+
+bool Manager::isRecordedStep(const SimTK::State& s, int step)
+{
+    auto& recorder = *_statesRecorder;
+    // The initial and final states are always recorded.
+    if (step > 0) {
+        if (++recorder.numStepsSinceRecorded < _recordEveryNSteps)
+            return false;
+        // Allow for roundoff in the times of fixed steps.
+        if (_recordInterval > 0 && s.getTime() - recorder.lastRecordedTime <
+                _recordInterval * (1 - SimTK::SqrtEps))
+            return false;
+    }
+    recorder.numStepsSinceRecorded = 0;
+    recorder.lastRecordedTime = s.getTime();
+    return true;
+}
+
+void Manager::recordStates(const SimTK::State& s)
+{
+    auto& recorder = *_statesRecorder;
+    if (recorder.allStates) {
+        recorder.values = _model->getStateVariableValues(s);
+    } else {
+        _model->getStateVariableValues(s, recorder.handles, recorder.values);
+    }
+
+    if (recorder.writer) {
+        // The final state of one call to integrate() is the initial state of
+        // the next; the Storage replaces such duplicates, but rows that were
+        // already written to the file cannot be replaced.
+        if (recorder.writer->getNumRowsWritten() == 0 ||
+                s.getTime() > recorder.lastWrittenTime) {
+            recorder.writer->appendRow(s.getTime(),
+                    recorder.values.transpose());
+            recorder.lastWrittenTime = s.getTime();
+        }
+    } else {
+        StateVector vec;
+        vec.setStates(s.getTime(), recorder.values);
+        getStateStorage().append(vec);
+    }
+}
+
 //_____________________________________________________________________________
 /**
  * Get whether there is a storage buffer for the integration states.
@@ -752,6 +891,9 @@ const SimTK::State& Manager::integrate(double finalTime)
 
     record(_integ->getState(), -1);
 
+    if (_statesRecorder && _statesRecorder->writer)
+        _statesRecorder->writer->flush();
+
     return getState();
 }
 
@@ -791,9 +933,12 @@ void Manager::initializeStorageAndAnalyses(const SimTK::State& s)
             _controllerSet->connectToModel(*_model);
         }
 
-        OPENSIM_THROW_IF(!hasStateStorage(), Exception,
+        OPENSIM_THROW_IF(
+            !hasStateStorage() && _recordStatesFileName.empty(), Exception,
             "Manager::initializeStorageAndAnalyses(): "
             "Expected a Storage to write states into, but none provided.");
+
+        if (!_statesRecorder) initializeStatesRecorder();
     }
 
     record(s, 0);
@@ -843,14 +988,12 @@ void Manager::record(const SimTK::State& s, const int& step)
         else
             analysisSet.step(s, step);
     }
-    if (_writeToStorage) {
-        SimTK::Vector stateValues = _model->getStateVariableValues(s);
-        StateVector vec;
-        vec.setStates(s.getTime(), stateValues);
-        getStateStorage().append(vec);
+    if (_writeToStorage && isRecordedStep(s, step)) {
+        recordStates(s);
         if (_model->isControlled())
             _controllerSet->storeControls(s,
-                (step < 0) ? getStateStorage().getSize() : step);
+                (step < 0 && hasStateStorage()) ?
+                    getStateStorage().getSize() : step);
     }
 }
 
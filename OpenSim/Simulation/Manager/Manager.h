@@ -115,6 +115,22 @@ private:
     /** flag indicating if manager should write to storage  each step */
     bool _writeToStorage;
 
+    /** Record the states at every this many integration steps. */
+    int _recordEveryNSteps;
+    /** Minimum interval of time between recorded states (0 for none). */
+    double _recordInterval;
+    /** Regular expression for the paths of the state variables to record
+    (empty for all state variables). */
+    std::string _recordStatesPattern;
+    /** File to which the states are written instead of the Storage (empty
+    for none). */
+    std::string _recordStatesFileName;
+
+    /** State variables recorded, file writer, and counters; created when
+    integration starts. */
+    struct StatesRecorder;
+    std::unique_ptr<StatesRecorder> _statesRecorder;
+
     /** controllerSet used for the integration */
     SimTK::ReferencePtr<ControllerSet> _controllerSet;
 
@@ -146,6 +162,8 @@ public:
     Manager(const Manager&) = delete;
     void operator=(const Manager&) = delete;
 
+    ~Manager();
+
 private:
     void setNull();
     bool constructStorage();
@@ -163,6 +181,52 @@ public:
     void setWriteToStorage(bool writeToStorage)
     { _writeToStorage =  writeToStorage; }
 
+    /** @name Configure recording of states
+      * By default, the values of all state variables are recorded in the
+      * Storage returned by getStateStorage() at every integration step. For
+      * long simulations, recording fewer steps, fewer state variables, or
+      * writing the states to a file as the simulation proceeds reduces the
+      * memory and time spent recording. To not record states at all, use
+      * setWriteToStorage(false). The initial and final states of each call to
+      * integrate() are always recorded. Controls (for controlled models) are
+      * recorded whenever the states are. Analyses are not affected by these
+      * settings.
+      * @note Call these functions before calling `Manager::integrate()`.
+      * @{ */
+
+    /** Record the states only at every n-th integration step. The default,
+      * 1, records every step. */
+    void setRecordEveryNSteps(int n);
+    int getRecordEveryNSteps() const { return _recordEveryNSteps; }
+
+    /** Record the states at integration steps that are at least `interval`
+      * (in simulated time) after the previously recorded step. The states
+      * are recorded at the times of the integration steps, not interpolated;
+      * use a constant step size (setUseConstantDT()) for states at exact
+      * intervals. The default, 0, does not limit the recorded steps. */
+    void setRecordInterval(double interval);
+    double getRecordInterval() const { return _recordInterval; }
+
+    /** Record only the state variables whose paths (as returned by
+      * Component::getStateVariableNames()) match the given regular
+      * expression, e.g., `.*(value|speed)` for the coordinates. The columns
+      * of the state Storage are changed accordingly. The default, an empty
+      * pattern, records all state variables. */
+    void setRecordStatesMatching(const std::string& pattern);
+    const std::string& getRecordStatesMatching() const
+    {   return _recordStatesPattern; }
+
+    /** Write the recorded states to the given STO file as the simulation
+      * proceeds, instead of keeping them in the state Storage (which then
+      * remains empty). The file is written by the first call to integrate()
+      * and flushed at the end of each call. The default, an empty file name,
+      * keeps the states in memory. */
+    void setRecordStatesToFile(const std::string& fileName);
+    const std::string& getRecordStatesToFile() const
+    {   return _recordStatesFileName; }
+
+    /** @} */
+
     /** @name Configure the Integrator
       * @note Call these functions before calling `Manager::initialize()`.
       * @{ */
@@ -363,6 +427,11 @@ private:
     // step = 0 is the beginning, step = -1 used to denote the end/final step
     void record(const SimTK::State& s, const int& step);
 
+    // Helpers for recording states according to the settings above.
+    void initializeStatesRecorder();
+    bool isRecordedStep(const SimTK::State& s, int step);
+    void recordStates(const SimTK::State& s);
+
 //=============================================================================
 };  // END of class Manager
 
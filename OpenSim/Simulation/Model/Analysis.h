@@ -209,6 +209,17 @@ public:
     int getStorageInterval() const;
 #endif
     virtual ArrayPtrs<Storage>& getStorageList();
+    /**
+     * Whether the results of this analysis at a given time depend only on
+     * the state at that time. If so, a tool that already has all the states
+     * (e.g., AnalyzeTool) may process ranges of the states concurrently,
+     * each with its own copy of this analysis, and then append the rows
+     * recorded by the copies to the storages in getStorageList(), in time
+     * order. Analyses that accumulate results over the steps, or that do
+     * not list all of their results in getStorageList(), must return false,
+     * which is the default.
+     */
+    virtual bool getSupportsParallelFrames() const { return false; }
     void setPrintResultFiles(bool aToWrite) { _printResultFiles = aToWrite; }
     bool getPrintResultFiles() const { return _printResultFiles; }
 
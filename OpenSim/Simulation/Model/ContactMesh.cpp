@@ -79,6 +79,7 @@ void ContactMesh::constructProperties()
 void ContactMesh::extendFinalizeFromProperties() {
     _geometry.reset();
     _decorativeGeometry.reset();
+    _bvh.reset();
 }
 
 const std::string& ContactMesh::getFilename() const
@@ -91,6 +92,7 @@ void ContactMesh::setFilename(const std::string& filename)
     set_filename(filename);
     _geometry.reset();
     _decorativeGeometry.reset();
+    _bvh.reset();
 }
 
 SimTK::ContactGeometry::TriangleMesh* ContactMesh::
@@ -125,6 +127,21 @@ SimTK::ContactGeometry ContactMesh::createSimTKContactGeometry() const
     return *_geometry;
 }
 
+const ContactMeshBVH& ContactMesh::getBVH() const
+{
+    if (!_bvh) {
+        createSimTKContactGeometry();
+        // B: base Frame (Body or Ground)
+        // F: PhysicalFrame that this ContactGeometry is connected to
+        // P: the frame defined (relative to F) by the location and
+        //    orientation properties.
+        const auto& X_BF = getFrame().findTransformInBaseFrame();
+        const auto& X_FP = getTransform();
+        _bvh.reset(new ContactMeshBVH(*_geometry, X_BF * X_FP));
+    }
+    return *_bvh;
+}
+
 //=============================================================================
 // VISUALIZER GEOMETRY
 //=============================================================================
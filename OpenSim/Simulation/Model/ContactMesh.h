@@ -24,6 +24,7 @@
  * -------------------------------------------------------------------------- */
 // INCLUDE
 #include "ContactGeometry.h"
+#include "ContactMeshBVH.h"
 
 namespace OpenSim {
 
@@ -93,6 +94,17 @@ public:
      * %Set the name of the file to load the mesh from.
      */
     void setFilename(const std::string& filename);
+#ifndef SWIG
+    /**
+     * Get the bounding volume hierarchy of the triangles of this mesh,
+     * expressed in the base frame (Body or Ground) of the PhysicalFrame this
+     * mesh is attached to. The hierarchy is built the first time it is
+     * requested and is then cached until the properties of this mesh change.
+     * It is built by ElasticFoundationForce when it is added to the System,
+     * so that it is not built concurrently.
+     */
+    const ContactMeshBVH& getBVH() const;
+#endif
 
     // VISUALIZATION
     void generateDecorations(bool fixed, const ModelDisplayHints& hints,
@@ -115,6 +127,7 @@ private:
         _geometry;
     mutable SimTK::ResetOnCopy<std::unique_ptr<SimTK::DecorativeMesh>>
         _decorativeGeometry;
+    mutable SimTK::ResetOnCopy<std::unique_ptr<ContactMeshBVH>> _bvh;
 
 //=============================================================================
 };  // END of class ContactMesh
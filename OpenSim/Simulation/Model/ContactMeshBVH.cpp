@@ -0,0 +1,247 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  ContactMeshBVH.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ContactMeshBVH.h"
+#include <OpenSim/Common/Exception.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace OpenSim;
+using SimTK::Vec3;
+
+namespace {
+    // Faces are not split further once a node has this many.
+    const int MaxFacesPerLeaf = 4;
+    // The median split keeps the depth of the hierarchy below
+    // log2(numFaces) + 2, so this bounds the traversal stacks.
+    const int MaxStackSize = 128;
+
+    double calcDistanceSquaredToBox(const Vec3& point,
+            const Vec3& lower, const Vec3& upper) {
+        double distanceSquared = 0;
+        for (int i = 0; i < 3; ++i) {
+            const double d = std::max(std::max(lower[i] - point[i], 0.0),
+                    point[i] - upper[i]);
+            distanceSquared += d * d;
+        }
+        return distanceSquared;
+    }
+
+    // Real-Time Collision Detection (Ericson, 2005), section 5.1.5.
+    Vec3 findNearestPointOnTriangle(const Vec3& p,
+            const Vec3& a, const Vec3& b, const Vec3& c) {
+        const Vec3 ab = b - a;
+        const Vec3 ac = c - a;
+        const Vec3 ap = p - a;
+        const double d1 = ~ab * ap;
+        const double d2 = ~ac * ap;
+        if (d1 <= 0 && d2 <= 0) return a;
+
+        const Vec3 bp = p - b;
+        const double d3 = ~ab * bp;
+        const double d4 = ~ac * bp;
+        if (d3 >= 0 && d4 <= d3) return b;
+
+        const double vc = d1 * d4 - d3 * d2;
+        if (vc <= 0 && d1 >= 0 && d3 <= 0) return a + (d1 / (d1 - d3)) * ab;
+
+        const Vec3 cp = p - c;
+        const double d5 = ~ab * cp;
+        const double d6 = ~ac * cp;
+        if (d6 >= 0 && d5 <= d6) return c;
+
+        const double vb = d5 * d2 - d1 * d6;
+        if (vb <= 0 && d2 >= 0 && d6 <= 0) return a + (d2 / (d2 - d6)) * ac;
+
+        const double va = d3 * d6 - d5 * d4;
+        if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) {
+            const double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+            return b + w * (c - b);
+        }
+
+        const double denom = 1.0 / (va + vb + vc);
+        return a + (vb * denom) * ab + (vc * denom) * ac;
+    }
+}
+
+ContactMeshBVH::ContactMeshBVH(
+        const SimTK::ContactGeometry::TriangleMesh& mesh,
+        const SimTK::Transform& X_BP) {
+    const int numFaces = mesh.getNumFaces();
+    OPENSIM_THROW_IF(numFaces == 0, Exception,
+            "Cannot build a bounding volume hierarchy for a mesh without "
+            "faces.");
+
+    _faces.resize(numFaces);
+    _faceOrder.resize(numFaces);
+    for (int i = 0; i < numFaces; ++i) {
+        Face& face = _faces[i];
+        for (int j = 0; j < 3; ++j) {
+            face.vertices[j] =
+                    X_BP * mesh.getVertexPosition(mesh.getFaceVertex(i, j));
+        }
+        face.centroid = X_BP * mesh.getFaceCentroid(i);
+        face.normal = X_BP.R() * mesh.getFaceNormal(i);
+        face.area = mesh.getFaceArea(i);
+        _faceOrder[i] = i;
+    }
+
+    _nodes.reserve(2 * numFaces);
+    _nodes.emplace_back();
+    _depth = buildNode(0, 0, numFaces);
+    assert(_depth < MaxStackSize);
+
+    _sphereCenter = 0.5 * (getLowerBound() + getUpperBound());
+    _sphereRadius = 0;
+    for (const auto& face : _faces) {
+        for (int j = 0; j < 3; ++j) {
+            _sphereRadius = std::max(_sphereRadius,
+                    (face.vertices[j] - _sphereCenter).norm());
+        }
+    }
+}
+
+int ContactMeshBVH::buildNode(int node, int begin, int end) {
+    Vec3 lower(SimTK::Infinity);
+    Vec3 upper(-SimTK::Infinity);
+    Vec3 centroidLower(SimTK::Infinity);
+    Vec3 centroidUpper(-SimTK::Infinity);
+    for (int i = begin; i < end; ++i) {
+        const Face& face = _faces[_faceOrder[i]];
+        for (int k = 0; k < 3; ++k) {
+            for (int j = 0; j < 3; ++j) {
+                lower[k] = std::min(lower[k], face.vertices[j][k]);
+                upper[k] = std::max(upper[k], face.vertices[j][k]);
+            }
+            centroidLower[k] = std::min(centroidLower[k], face.centroid[k]);
+            centroidUpper[k] = std::max(centroidUpper[k], face.centroid[k]);
+        }
+    }
+    _nodes[node].lower = lower;
+    _nodes[node].upper = upper;
+    _nodes[node].begin = begin;
+    _nodes[node].end = end;
+    _nodes[node].left = -1;
+
+    if (end - begin <= MaxFacesPerLeaf) return 1;
+
+    // Split at the median centroid along the axis in which the centroids are
+    // most spread out.
+    const Vec3 extent = centroidUpper - centroidLower;
+    int axis = 0;
+    if (extent[1] > extent[axis]) axis = 1;
+    if (extent[2] > extent[axis]) axis = 2;
+    if (extent[axis] == 0) return 1;
+
+    const int middle = begin + (end - begin) / 2;
+    std::nth_element(_faceOrder.begin() + begin, _faceOrder.begin() + middle,
+            _faceOrder.begin() + end, [&](int a, int b) {
+                return _faces[a].centroid[axis] < _faces[b].centroid[axis];
+            });
+
+    const int left = (int)_nodes.size();
+    _nodes.emplace_back();
+    _nodes.emplace_back();
+    _nodes[node].left = left;
+    const int leftDepth = buildNode(left, begin, middle);
+    const int rightDepth = buildNode(left + 1, middle, end);
+    return 1 + std::max(leftDepth, rightDepth);
+}
+
+void ContactMeshBVH::findFacesInBox(const Vec3& lower, const Vec3& upper,
+        std::vector<int>& faces) const {
+    int stack[MaxStackSize];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        const Node& node = _nodes[stack[--stackSize]];
+        if (node.lower[0] > upper[0] || node.upper[0] < lower[0] ||
+                node.lower[1] > upper[1] || node.upper[1] < lower[1] ||
+                node.lower[2] > upper[2] || node.upper[2] < lower[2]) {
+            continue;
+        }
+        if (node.left < 0) {
+            faces.insert(faces.end(), _faceOrder.begin() + node.begin,
+                    _faceOrder.begin() + node.end);
+        } else {
+            stack[stackSize++] = node.left;
+            stack[stackSize++] = node.left + 1;
+        }
+    }
+}
+
+Vec3 ContactMeshBVH::findNearestPoint(const Vec3& point, bool& inside,
+        SimTK::UnitVec3& normal) const {
+    // Descend into the nearer child first, and skip any node that is farther
+    // away than the nearest point found so far.
+    int stack[MaxStackSize];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    int nearestFace = -1;
+    Vec3 nearestPoint(0);
+    double nearestDistanceSquared = SimTK::Infinity;
+    double nearestAlignment = 0;
+    while (stackSize > 0) {
+        const Node& node = _nodes[stack[--stackSize]];
+        if (calcDistanceSquaredToBox(point, node.lower, node.upper) >
+                nearestDistanceSquared) {
+            continue;
+        }
+        if (node.left < 0) {
+            for (int i = node.begin; i < node.end; ++i) {
+                const Face& face = _faces[_faceOrder[i]];
+                const Vec3 candidate = findNearestPointOnTriangle(point,
+                        face.vertices[0], face.vertices[1], face.vertices[2]);
+                const Vec3 offset = point - candidate;
+                const double distanceSquared = offset.normSqr();
+                // When the nearest point is on an edge or a vertex, several
+                // faces are equally near. The face whose normal is most
+                // nearly parallel to the offset decides whether the point is
+                // inside.
+                const double alignment = std::abs(~offset * face.normal);
+                const double tie = 1e-10 * nearestDistanceSquared;
+                if (nearestFace < 0 ||
+                        distanceSquared < nearestDistanceSquared - tie ||
+                        (distanceSquared <= nearestDistanceSquared + tie &&
+                                alignment > nearestAlignment)) {
+                    nearestFace = _faceOrder[i];
+                    nearestPoint = candidate;
+                    nearestDistanceSquared = distanceSquared;
+                    nearestAlignment = alignment;
+                }
+            }
+        } else {
+            const Node& left = _nodes[node.left];
+            const Node& right = _nodes[node.left + 1];
+            const bool leftIsNearer =
+                    calcDistanceSquaredToBox(point, left.lower, left.upper) <
+                    calcDistanceSquaredToBox(point, right.lower, right.upper);
+            stack[stackSize++] = leftIsNearer ? node.left + 1 : node.left;
+            stack[stackSize++] = leftIsNearer ? node.left : node.left + 1;
+        }
+    }
+    normal = _faces[nearestFace].normal;
+    inside = ~(point - nearestPoint) * normal < 0;
+    return nearestPoint;
+}
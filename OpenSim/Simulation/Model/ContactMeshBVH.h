@@ -0,0 +1,127 @@
+#ifndef OPENSIM_CONTACT_MESH_BVH_H_
+#define OPENSIM_CONTACT_MESH_BVH_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  ContactMeshBVH.h                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "OpenSim/Simulation/osimSimulationDLL.h"
+
+#include <SimTKsimbody.h>
+
+#include <vector>
+
+namespace OpenSim {
+
+//=============================================================================
+//=============================================================================
+/**
+ * A bounding volume hierarchy of axis-aligned bounding boxes over the
+ * triangles of a ContactMesh, expressed in the base frame (Body or Ground)
+ * of the mesh. Since the mesh does not move relative to its base frame, the
+ * hierarchy is built once and reused for every contact query; see
+ * ContactMesh::getBVH().
+ *
+ * The hierarchy is built by splitting the triangles at the median of their
+ * centroids along the longest axis of each box, so its depth is logarithmic
+ * in the number of triangles. All queries are const and may be made
+ * concurrently from multiple threads.
+ */
+class OSIMSIMULATION_API ContactMeshBVH {
+public:
+    /** Build the hierarchy for the given mesh. X_BP is the transform from
+    the frame in which the mesh is defined (P) to the base frame (B) in
+    which the hierarchy is expressed. */
+    ContactMeshBVH(const SimTK::ContactGeometry::TriangleMesh& mesh,
+            const SimTK::Transform& X_BP);
+
+    // ACCESSORS
+    int getNumFaces() const { return (int)_faces.size(); }
+    /** The ith vertex (0, 1, or 2) of a face, expressed in B. */
+    const SimTK::Vec3& getFaceVertex(int face, int i) const
+    {   return _faces[face].vertices[i]; }
+    /** The centroid of a face, expressed in B. */
+    const SimTK::Vec3& getFaceCentroid(int face) const
+    {   return _faces[face].centroid; }
+    /** The outward unit normal of a face, expressed in B. */
+    const SimTK::UnitVec3& getFaceNormal(int face) const
+    {   return _faces[face].normal; }
+    double getFaceArea(int face) const { return _faces[face].area; }
+
+    /** The bounding box of the whole mesh, expressed in B. */
+    const SimTK::Vec3& getLowerBound() const { return _nodes[0].lower; }
+    const SimTK::Vec3& getUpperBound() const { return _nodes[0].upper; }
+    /** A sphere, expressed in B, that contains the whole mesh. */
+    const SimTK::Vec3& getBoundingSphereCenter() const
+    {   return _sphereCenter; }
+    double getBoundingSphereRadius() const { return _sphereRadius; }
+
+    int getNumNodes() const { return (int)_nodes.size(); }
+    /** The number of levels in the hierarchy. */
+    int getDepth() const { return _depth; }
+
+    // QUERIES
+    /** Append to `faces` the index of each face whose bounding box overlaps
+    the box [lower, upper] (expressed in B). This is the broad phase of a
+    contact query; the faces are not tested individually. */
+    void findFacesInBox(const SimTK::Vec3& lower, const SimTK::Vec3& upper,
+            std::vector<int>& faces) const;
+
+    /** Find the point on the surface of the mesh nearest to `point`; all
+    quantities are expressed in B. This has the same meaning as
+    SimTK::ContactGeometry::findNearestPoint(): `inside` is set to whether
+    `point` lies inside the mesh, and `normal` to the outward normal of the
+    face on which the nearest point lies. */
+    SimTK::Vec3 findNearestPoint(const SimTK::Vec3& point, bool& inside,
+            SimTK::UnitVec3& normal) const;
+
+private:
+    struct Face {
+        SimTK::Vec3 vertices[3];
+        SimTK::Vec3 centroid;
+        SimTK::UnitVec3 normal;
+        double area;
+    };
+    // The faces of a node are _faceOrder[begin] to _faceOrder[end-1]. A
+    // node is a leaf if it has no children (left == -1); otherwise, its
+    // children are nodes left and left+1.
+    struct Node {
+        SimTK::Vec3 lower;
+        SimTK::Vec3 upper;
+        int begin;
+        int end;
+        int left;
+    };
+
+    // Build the subtree for _faceOrder[begin, end) into node; return the
+    // depth of the subtree.
+    int buildNode(int node, int begin, int end);
+
+    std::vector<Face> _faces;
+    std::vector<int> _faceOrder;
+    std::vector<Node> _nodes;
+    int _depth = 0;
+    SimTK::Vec3 _sphereCenter;
+    double _sphereRadius = 0;
+};
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_CONTACT_MESH_BVH_H_
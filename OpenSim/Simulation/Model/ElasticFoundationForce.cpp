@@ -25,11 +25,402 @@
 #include "ContactGeometry.h"
 #include "ContactMesh.h"
 #include "Model.h"
+#include <OpenSim/Common/CommonUtilities.h>
 
 #include "simbody/internal/ElasticFoundationForce.h"
 
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <mutex>
+
 namespace OpenSim {
 
+namespace {
+
+// TODO: Dependency of ElasticFoundationForce on ContactGeometry should be
+// handled by Sockets.
+const ContactGeometry& findContactGeometry(const Model& model,
+        const std::string& name)
+{
+    if (model.hasComponent<ContactGeometry>(name))
+        return model.getComponent<ContactGeometry>(name);
+    return model.getComponent<ContactGeometry>("./contactgeometryset/" + name);
+}
+
+//==============================================================================
+//                 BOUNDING VOLUME HIERARCHY CONTACT PIPELINE
+//==============================================================================
+// Computes the same springs as SimTK::ElasticFoundationForce, using the
+// bounding volume hierarchy of each ContactMesh (see the documentation of
+// ElasticFoundationForce for the phases of the computation). The springs are
+// divided into chunks, and each chunk applies its forces to its own body
+// force buffer; the buffers are then summed into the array provided by
+// Simbody, as in ParallelForceAdapter.
+class BVHElasticFoundationForceImpl
+        : public SimTK::Force::Custom::Implementation {
+public:
+    struct Surface {
+        Surface(SimTK::MobilizedBodyIndex mobod,
+                const SimTK::ContactGeometry& geometry,
+                const SimTK::Transform& X_BP) :
+            mobod(mobod), geometry(geometry), X_BP(X_BP)
+        {
+            geometry.getBoundingSphere(sphereCenter, sphereRadius);
+            sphereCenter = X_BP * sphereCenter;
+        }
+        // Meshes have a spring at the centroid of each face.
+        void setSprings(const ContactMeshBVH& meshBVH,
+                const ElasticFoundationForce::ContactParameters& params)
+        {
+            bvh = &meshBVH;
+            stiffness = params.getStiffness();
+            dissipation = params.getDissipation();
+            staticFriction = params.getStaticFriction();
+            dynamicFriction = params.getDynamicFriction();
+            viscousFriction = params.getViscousFriction();
+            sphereCenter = bvh->getBoundingSphereCenter();
+            sphereRadius = bvh->getBoundingSphereRadius();
+        }
+
+        SimTK::MobilizedBodyIndex mobod;
+        SimTK::ContactGeometry geometry;
+        // B: base Frame (Body or Ground); P: frame of the geometry.
+        SimTK::Transform X_BP;
+        // Expressed in B.
+        SimTK::Vec3 sphereCenter;
+        SimTK::Real sphereRadius;
+        // Null if this surface is not a mesh.
+        const ContactMeshBVH* bvh = nullptr;
+        double stiffness = 0;
+        double dissipation = 0;
+        double staticFriction = 0;
+        double dynamicFriction = 0;
+        double viscousFriction = 0;
+    };
+
+    BVHElasticFoundationForceImpl(
+            const SimTK::SimbodyMatterSubsystem& matter,
+            const std::vector<Surface>& surfaces, double transitionVelocity,
+            int numThreads) :
+        _matter(matter), _surfaces(surfaces),
+        _transitionVelocity(transitionVelocity)
+    {
+        numThreads = getNumThreadsToUse(numThreads);
+        if (numThreads > 1) {
+            _executor = std::make_shared<SimTK::ParallelExecutor>(numThreads);
+        }
+        // Use a few more chunks than threads so that the threads stay busy
+        // when only some of the springs are in contact.
+        _maxNumChunks = 4 * numThreads;
+    }
+
+    void calcForce(const SimTK::State& state,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector_<SimTK::Vec3>& particleForces,
+            SimTK::Vector& mobilityForces) const override
+    {
+        Workspace workspace;
+        const int numChunks = calcSprings(state, true, workspace);
+        for (int c = 0; c < numChunks; ++c)
+            bodyForces += workspace.bodyForces[c];
+    }
+
+    SimTK::Real calcPotentialEnergy(const SimTK::State& state) const override
+    {
+        Workspace workspace;
+        const int numChunks = calcSprings(state, false, workspace);
+        SimTK::Real energy = 0;
+        for (int c = 0; c < numChunks; ++c) energy += workspace.energies[c];
+        return energy;
+    }
+
+private:
+    // The springs of one surface that may touch another surface. S is the
+    // base frame of the surface with the springs; O is the frame in which
+    // the nearest points on the other surface are found (its base frame if
+    // it is a mesh, and the frame of its geometry otherwise).
+    struct Contact {
+        int springSurface;
+        int otherSurface;
+        SimTK::Transform X_GS;
+        SimTK::Transform X_GO;
+        SimTK::Transform X_OS;
+        // Half of the area of each face is used when both surfaces are
+        // meshes, since the springs of both surfaces are computed.
+        double areaScale;
+    };
+    struct Spring {
+        int contact;
+        int face;
+    };
+    // The data computed for one evaluation. It is not kept in this object,
+    // since forces may be computed for several States at once.
+    struct Workspace {
+        // Results of the broad phase.
+        std::vector<Contact> contacts;
+        std::vector<Spring> springs;
+        std::vector<int> faces;
+        // One set of buffers per chunk.
+        std::vector<SimTK::Vector_<SimTK::SpatialVec>> bodyForces;
+        std::vector<SimTK::Real> energies;
+    };
+
+    class CalcSpringsTask;
+
+    // Broad phase: find the springs that may be in contact.
+    void findSprings(const SimTK::State& state, Workspace& workspace) const
+    {
+        const int numSurfaces = (int)_surfaces.size();
+        for (int i = 0; i < numSurfaces; ++i) {
+            for (int j = 0; j < i; ++j) {
+                const Surface& s1 = _surfaces[i];
+                const Surface& s2 = _surfaces[j];
+                if ((!s1.bvh && !s2.bvh) || s1.mobod == s2.mobod) continue;
+                const SimTK::Transform& X_GB1 =
+                        _matter.getMobilizedBody(s1.mobod).getBodyTransform(
+                                state);
+                const SimTK::Transform& X_GB2 =
+                        _matter.getMobilizedBody(s2.mobod).getBodyTransform(
+                                state);
+                const SimTK::Real distance =
+                        (X_GB1 * s1.sphereCenter - X_GB2 * s2.sphereCenter)
+                                .norm();
+                if (distance > s1.sphereRadius + s2.sphereRadius) continue;
+
+                const double areaScale = (s1.bvh && s2.bvh) ? 0.5 : 1.0;
+                if (s1.bvh) {
+                    findSpringsOfSurface(
+                            i, j, X_GB1, X_GB2, areaScale, workspace);
+                }
+                if (s2.bvh) {
+                    findSpringsOfSurface(
+                            j, i, X_GB2, X_GB1, areaScale, workspace);
+                }
+            }
+        }
+    }
+
+    // Find the faces of surface s whose bounding boxes overlap the bounding
+    // box of surface o.
+    void findSpringsOfSurface(int s, int o, const SimTK::Transform& X_GS,
+            const SimTK::Transform& X_GB, double areaScale,
+            Workspace& workspace) const
+    {
+        const Surface& other = _surfaces[o];
+        Contact contact;
+        contact.springSurface = s;
+        contact.otherSurface = o;
+        contact.X_GS = X_GS;
+        contact.X_GO = other.bvh ? X_GB : X_GB * other.X_BP;
+        contact.X_OS = ~contact.X_GO * X_GS;
+        contact.areaScale = areaScale;
+
+        // The bounding box of the other surface, expressed in S.
+        const SimTK::Transform X_SB = ~X_GS * X_GB;
+        SimTK::Vec3 lower(SimTK::Infinity);
+        SimTK::Vec3 upper(-SimTK::Infinity);
+        if (other.bvh) {
+            const SimTK::Vec3& otherLower = other.bvh->getLowerBound();
+            const SimTK::Vec3& otherUpper = other.bvh->getUpperBound();
+            for (int k = 0; k < 8; ++k) {
+                const SimTK::Vec3 corner = X_SB * SimTK::Vec3(
+                        (k & 1) ? otherUpper[0] : otherLower[0],
+                        (k & 2) ? otherUpper[1] : otherLower[1],
+                        (k & 4) ? otherUpper[2] : otherLower[2]);
+                for (int i = 0; i < 3; ++i) {
+                    lower[i] = std::min(lower[i], corner[i]);
+                    upper[i] = std::max(upper[i], corner[i]);
+                }
+            }
+        } else if (SimTK::isFinite(other.sphereRadius)) {
+            const SimTK::Vec3 center = X_SB * other.sphereCenter;
+            lower = center - SimTK::Vec3(other.sphereRadius);
+            upper = center + SimTK::Vec3(other.sphereRadius);
+        } else {
+            // For example, a half space.
+            lower = SimTK::Vec3(-SimTK::Infinity);
+            upper = SimTK::Vec3(SimTK::Infinity);
+        }
+
+        std::vector<int>& faces = workspace.faces;
+        faces.clear();
+        _surfaces[s].bvh->findFacesInBox(lower, upper, faces);
+        if (faces.empty()) return;
+        const int icontact = (int)workspace.contacts.size();
+        workspace.contacts.push_back(contact);
+        for (int face : faces) workspace.springs.push_back({icontact, face});
+    }
+
+    // Narrow phase: compute the springs and return the number of chunks
+    // whose buffers in the workspace hold the results.
+    int calcSprings(const SimTK::State& state, bool calcForces,
+            Workspace& workspace) const;
+
+    // Compute the springs of one chunk into the buffers of that chunk.
+    void calcChunk(const SimTK::State& state, Workspace& workspace, int chunk,
+            int numChunks, bool calcForces) const
+    {
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces =
+                workspace.bodyForces[chunk];
+        SimTK::Real& energy = workspace.energies[chunk];
+        bodyForces.resize(_matter.getNumBodies());
+        bodyForces.setToZero();
+        energy = 0;
+        const int numSprings = (int)workspace.springs.size();
+        const int begin = (int)((long long)chunk * numSprings / numChunks);
+        const int end = (int)((long long)(chunk + 1) * numSprings / numChunks);
+        for (int i = begin; i < end; ++i) {
+            calcSpring(state, workspace.contacts, workspace.springs[i],
+                    calcForces, bodyForces, energy);
+        }
+    }
+
+    // This follows SimTK::ElasticFoundationForce.
+    void calcSpring(const SimTK::State& state,
+            const std::vector<Contact>& contacts, const Spring& spring,
+            bool calcForces, SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Real& energy) const
+    {
+        const Contact& contact = contacts[spring.contact];
+        const Surface& surface = _surfaces[contact.springSurface];
+        const Surface& other = _surfaces[contact.otherSurface];
+        const SimTK::Vec3& springPosition =
+                surface.bvh->getFaceCentroid(spring.face);
+
+        bool inside;
+        SimTK::UnitVec3 normal;
+        const SimTK::Vec3 position_O = contact.X_OS * springPosition;
+        const SimTK::Vec3 nearestPoint_O = other.bvh
+                ? other.bvh->findNearestPoint(position_O, inside, normal)
+                : other.geometry.findNearestPoint(position_O, inside, normal);
+        if (!inside) return;
+
+        // Find how much the spring is displaced.
+        const SimTK::Vec3 nearestPoint = contact.X_GO * nearestPoint_O;
+        const SimTK::Vec3 springPosInGround = contact.X_GS * springPosition;
+        const SimTK::Vec3 displacement = nearestPoint - springPosInGround;
+        const SimTK::Real distance = displacement.norm();
+        if (distance == 0.0) return;
+
+        const SimTK::Real area =
+                contact.areaScale * surface.bvh->getFaceArea(spring.face);
+        energy += 0.5 * surface.stiffness * area * distance * distance;
+        if (!calcForces) return;
+
+        // Calculate the relative velocity of the two bodies at the contact
+        // point.
+        const SimTK::Vec3 forceDir = displacement / distance;
+        const SimTK::MobilizedBody& body1 =
+                _matter.getMobilizedBody(surface.mobod);
+        const SimTK::MobilizedBody& body2 =
+                _matter.getMobilizedBody(other.mobod);
+        const SimTK::Vec3 station1 =
+                body1.findStationAtGroundPoint(state, nearestPoint);
+        const SimTK::Vec3 station2 =
+                body2.findStationAtGroundPoint(state, nearestPoint);
+        const SimTK::Vec3 v1 =
+                body1.findStationVelocityInGround(state, station1);
+        const SimTK::Vec3 v2 =
+                body2.findStationVelocityInGround(state, station2);
+        const SimTK::Vec3 v = v2 - v1;
+        const SimTK::Real vnormal = ~v * forceDir;
+        const SimTK::Vec3 vtangent = v - vnormal * forceDir;
+
+        // Calculate the damping force.
+        const SimTK::Real f = surface.stiffness * area * distance *
+                (1 + surface.dissipation * vnormal);
+        SimTK::Vec3 force = (f > 0 ? f * forceDir : SimTK::Vec3(0));
+
+        // Calculate the friction force.
+        const SimTK::Real vslip = vtangent.norm();
+        if (f > 0 && vslip != 0) {
+            const SimTK::Real vrel = vslip / _transitionVelocity;
+            const SimTK::Real ffriction = f * (std::min(vrel, SimTK::Real(1)) *
+                    (surface.dynamicFriction + 2 * (surface.staticFriction -
+                            surface.dynamicFriction) / (1 + vrel * vrel)) +
+                    surface.viscousFriction * vslip);
+            force += ffriction * vtangent / vslip;
+        }
+
+        body1.applyForceToBodyPoint(state, station1, force, bodyForces);
+        body2.applyForceToBodyPoint(state, station2, -force, bodyForces);
+    }
+
+    const SimTK::SimbodyMatterSubsystem& _matter;
+    std::vector<Surface> _surfaces;
+    double _transitionVelocity;
+    std::shared_ptr<SimTK::ParallelExecutor> _executor;
+    // Held while the executor is in use; if forces are computed for several
+    // States at once, only one of them uses the executor.
+    mutable std::mutex _executorMutex;
+    int _maxNumChunks = 1;
+};
+
+// Computes the springs of one chunk per call to execute(). The first
+// exception is kept and rethrown on the calling thread, since the
+// ParallelExecutor cannot propagate it.
+class BVHElasticFoundationForceImpl::CalcSpringsTask
+        : public SimTK::ParallelExecutor::Task {
+public:
+    CalcSpringsTask(const BVHElasticFoundationForceImpl& impl,
+            const SimTK::State& state, Workspace& workspace, int numChunks,
+            bool calcForces) :
+        _impl(impl), _state(state), _workspace(workspace),
+        _numChunks(numChunks), _calcForces(calcForces) {}
+
+    void execute(int chunk) override {
+        try {
+            _impl.calcChunk(_state, _workspace, chunk, _numChunks,
+                    _calcForces);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_exception) _exception = std::current_exception();
+        }
+    }
+
+    void rethrowIfFailed() const {
+        if (_exception) std::rethrow_exception(_exception);
+    }
+
+private:
+    const BVHElasticFoundationForceImpl& _impl;
+    const SimTK::State& _state;
+    Workspace& _workspace;
+    int _numChunks;
+    bool _calcForces;
+    std::mutex _mutex;
+    std::exception_ptr _exception;
+};
+
+int BVHElasticFoundationForceImpl::calcSprings(const SimTK::State& state,
+        bool calcForces, Workspace& workspace) const
+{
+    findSprings(state, workspace);
+
+    // Starting a chunk on another thread is only worthwhile if the chunk has
+    // enough springs.
+    const int minSpringsPerChunk = 256;
+    const int numSprings = (int)workspace.springs.size();
+    int numChunks = 1;
+    std::unique_lock<std::mutex> lock(_executorMutex, std::defer_lock);
+    if (_executor && numSprings >= 2 * minSpringsPerChunk && lock.try_lock()) {
+        numChunks = std::min(_maxNumChunks, numSprings / minSpringsPerChunk);
+    }
+    workspace.bodyForces.resize(numChunks);
+    workspace.energies.resize(numChunks);
+    if (numChunks == 1) {
+        calcChunk(state, workspace, 0, 1, calcForces);
+    } else {
+        CalcSpringsTask task(*this, state, workspace, numChunks, calcForces);
+        _executor->execute(task, numChunks);
+        task.rethrowIfFailed();
+    }
+    return numChunks;
+}
+
+} // anonymous namespace
+
 //==============================================================================
 //                         ELASTIC FOUNDATION FORCE
 //==============================================================================
@@ -54,6 +445,30 @@ void ElasticFoundationForce::extendAddToSystem(SimTK::MultibodySystem& system) c
     const ContactParametersSet& contactParametersSet = 
         get_contact_parameters();
     const double& transitionVelocity = get_transition_velocity();
+    // Beyond the const Component get the index so we can access the SimTK::Force later
+    ElasticFoundationForce* mutableThis = const_cast<ElasticFoundationForce *>(this);
+
+    if (get_use_bounding_volume_hierarchy()) {
+        std::vector<BVHElasticFoundationForceImpl::Surface> surfaces;
+        for (int i = 0; i < contactParametersSet.getSize(); ++i) {
+            const ContactParameters& params = contactParametersSet.get(i);
+            for (int j = 0; j < params.getGeometry().size(); ++j) {
+                const ContactGeometry& geom = findContactGeometry(
+                        getModel(), params.getGeometry()[j]);
+                const auto& X_BF = geom.getFrame().findTransformInBaseFrame();
+                const auto& X_FP = geom.getTransform();
+                surfaces.emplace_back(geom.getFrame().getMobilizedBodyIndex(),
+                        geom.createSimTKContactGeometry(), X_BF * X_FP);
+                if (const auto* mesh = dynamic_cast<const ContactMesh*>(&geom))
+                    surfaces.back().setSprings(mesh->getBVH(), params);
+            }
+        }
+        SimTK::Force::Custom force(_model->updForceSubsystem(),
+                new BVHElasticFoundationForceImpl(system.getMatterSubsystem(),
+                        surfaces, transitionVelocity, get_num_threads()));
+        mutableThis->_index = force.getForceIndex();
+        return;
+    }
 
     SimTK::GeneralContactSubsystem& contacts = system.updContactSubsystem();
     SimTK::ContactSetIndex set = contacts.createContactSet();
@@ -63,17 +478,8 @@ void ElasticFoundationForce::extendAddToSystem(SimTK::MultibodySystem& system) c
     {
         ContactParameters& params = contactParametersSet.get(i);
         for (int j = 0; j < params.getGeometry().size(); ++j) {
-            // TODO: Dependency of ElasticFoundationForce on ContactGeometry
-            // should be handled by Sockets.
-            const ContactGeometry* contactGeom = nullptr;
-            if (getModel().hasComponent<ContactGeometry>(params.getGeometry()[j]))
-                contactGeom = &getModel().getComponent<ContactGeometry>(
-                    params.getGeometry()[j]);
-            else
-                contactGeom = &getModel().getComponent<ContactGeometry>(
-                    "./contactgeometryset/" + params.getGeometry()[j]);
-
-            const ContactGeometry& geom = *contactGeom;
+            const ContactGeometry& geom =
+                    findContactGeometry(getModel(), params.getGeometry()[j]);
             // B: base Frame (Body or Ground)
             // F: PhysicalFrame that this ContactGeometry is connected to
             // P: the frame defined (relative to F) by the location and
@@ -94,8 +500,6 @@ void ElasticFoundationForce::extendAddToSystem(SimTK::MultibodySystem& system) c
         }
     }
 
-    // Beyond the const Component get the index so we can access the SimTK::Force later
-    ElasticFoundationForce* mutableThis = const_cast<ElasticFoundationForce *>(this);
     mutableThis->_index = force.getForceIndex();
 }
 
@@ -103,6 +507,8 @@ void ElasticFoundationForce::constructProperties()
 {
     constructProperty_contact_parameters(ContactParametersSet());
     constructProperty_transition_velocity(0.01);
+    constructProperty_use_bounding_volume_hierarchy(false);
+    constructProperty_num_threads(1);
 }
 
 
@@ -131,6 +537,26 @@ void ElasticFoundationForce::setTransitionVelocity(double velocity)
     set_transition_velocity(velocity);
 }
 
+bool ElasticFoundationForce::getUseBoundingVolumeHierarchy() const
+{
+    return get_use_bounding_volume_hierarchy();
+}
+
+void ElasticFoundationForce::setUseBoundingVolumeHierarchy(bool useBVH)
+{
+    set_use_bounding_volume_hierarchy(useBVH);
+}
+
+int ElasticFoundationForce::getNumThreads() const
+{
+    return get_num_threads();
+}
+
+void ElasticFoundationForce::setNumThreads(int numThreads)
+{
+    set_num_threads(numThreads);
+}
+
  /* The following set of functions are introduced for convenience to get/set values in ElasticFoundationForce::ContactParameters
  * and for access in Matlab without exposing ElasticFoundationForce::ContactParameters. pending refactoring contact forces
  */
@@ -363,8 +789,10 @@ OpenSim::Array<double> ElasticFoundationForce::getRecordValues(const SimTK::Stat
     const ContactParametersSet& contactParametersSet = 
         get_contact_parameters();
 
-    const SimTK::ElasticFoundationForce& simtkForce = 
-        (SimTK::ElasticFoundationForce &)(_model->getForceSubsystem().getForce(_index));
+    // This is a SimTK::ElasticFoundationForce, or a SimTK::Force::Custom if
+    // use_bounding_volume_hierarchy is true.
+    const SimTK::Force& simtkForce =
+        _model->getForceSubsystem().getForce(_index);
 
     SimTK::Vector_<SimTK::SpatialVec> bodyForces(0);
     SimTK::Vector_<SimTK::Vec3> particleForces(0);
@@ -36,6 +36,21 @@ places a spring at the center of each face of each ContactMesh it acts on.
 Those springs interact with all objects (both meshes and other objects) the 
 mesh comes in contact with.
 
+By default, contact is detected and the springs are computed by Simbody. If
+the use_bounding_volume_hierarchy property is true, they are computed by
+OpenSim instead, which can be much faster for meshes with many faces:
+ - each ContactMesh builds a bounding volume hierarchy of its faces once, in
+   the frame of its Body (see ContactMesh::getBVH());
+ - in the broad phase, pairs of surfaces whose bounding spheres do not
+   overlap are skipped, and the faces of each mesh that can touch the other
+   surface are found from the bounding box of that surface;
+ - in the narrow phase, the spring of each of those faces is computed using
+   the hierarchy of the other surface (if it is a mesh), with the faces
+   divided among num_threads threads.
+The two pipelines apply the same spring and friction forces, but they may
+differ slightly where the nearest point to a spring lies on an edge or
+vertex of a mesh.
+
 @author Peter Eastman **/
 class OSIMSIMULATION_API ElasticFoundationForce : public Force {
 OpenSim_DECLARE_CONCRETE_OBJECT(ElasticFoundationForce, Force);
@@ -50,7 +65,14 @@ public:
         "Material properties.");
     OpenSim_DECLARE_PROPERTY(transition_velocity, double,
         "Slip velocity (creep) at which peak static friction occurs.");
-
+    OpenSim_DECLARE_PROPERTY(use_bounding_volume_hierarchy, bool,
+        "Compute contact using bounding volume hierarchies of the meshes, "
+        "computed by OpenSim, instead of Simbody's contact subsystem "
+        "(default: false).");
+    OpenSim_DECLARE_PROPERTY(num_threads, int,
+        "Number of threads used to compute the springs when "
+        "use_bounding_volume_hierarchy is true. A value less than 1 uses "
+        "all the threads supported by the hardware (default: 1).");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -75,6 +97,18 @@ public:
      * %Set the transition velocity for switching between static and dynamic friction.
      */
     void setTransitionVelocity(double velocity);
+    /**
+     * Whether contact is computed by OpenSim using bounding volume
+     * hierarchies of the meshes, instead of by Simbody.
+     */
+    bool getUseBoundingVolumeHierarchy() const;
+    void setUseBoundingVolumeHierarchy(bool useBVH);
+    /**
+     * The number of threads used to compute the springs when
+     * use_bounding_volume_hierarchy is true (see getNumThreadsToUse()).
+     */
+    int getNumThreads() const;
+    void setNumThreads(int numThreads);
 
     /**
      * Access to ContactParameters. Methods assume size 1 of ContactParametersSet and add one ContactParameter if needed
@@ -28,6 +28,8 @@
 
 #include "ExpressionBasedBushingForce.h"
 
+#include <algorithm>
+
 using namespace std;
 using namespace SimTK;
 using namespace OpenSim;
@@ -221,7 +223,7 @@ void ExpressionBasedBushingForce::setMxExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mx_expression(expression);
-    MxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileExpression(0, expression);
 }
 
 /** Set the expression for the My function and create it's lepton program */
@@ -231,7 +233,7 @@ void ExpressionBasedBushingForce::setMyExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_My_expression(expression);
-    MyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileExpression(1, expression);
 }
 
 /** Set the expression for the Mz function and create it's lepton program */
@@ -240,7 +242,7 @@ void ExpressionBasedBushingForce::setMzExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mz_expression(expression);
-    MzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileExpression(2, expression);
 }
 
 /** Set the expression for the Fx function and create it's lepton program */
@@ -249,7 +251,7 @@ void ExpressionBasedBushingForce::setFxExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fx_expression(expression);
-    FxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileExpression(3, expression);
 }
 
 /** Set the expression for the Fy function and create it's lepton program */
@@ -258,7 +260,7 @@ void ExpressionBasedBushingForce::setFyExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fy_expression(expression);
-    FyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileExpression(4, expression);
 }
 
 /** Set the expression for the Fz function and create it's lepton program */
@@ -267,7 +269,28 @@ void ExpressionBasedBushingForce::setFzExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fz_expression(expression);
-    FzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileExpression(5, expression);
+}
+
+void ExpressionBasedBushingForce::compileExpression(int component,
+        const std::string& expression)
+{
+    static const std::vector<std::string> variables{
+        "theta_x", "theta_y", "theta_z", "delta_x", "delta_y", "delta_z"};
+
+    Lepton::CompiledExpression& compiled = _expressions[component];
+    compiled = Lepton::Parser::parse(expression).createCompiledExpression();
+    for (const auto& name : compiled.getVariables()) {
+        OPENSIM_THROW_IF_FRMOBJ(
+                std::find(variables.begin(), variables.end(), name) ==
+                        variables.end(),
+                Exception,
+                "Expression '{}' contains unknown variable '{}'.", expression,
+                name);
+    }
+    _variableIndices[component].clear();
+    for (const auto& name : variables)
+        _variableIndices[component].push_back(compiled.getVariableIndex(name));
 }
 //=============================================================================
 // COMPUTATION
@@ -282,21 +305,9 @@ SimTK::Vec6 ExpressionBasedBushingForce::
 
     Vec6 fk = Vec6(0.0);
 
-    std::map<std::string, double> deflectionVars;
-    deflectionVars["theta_x"] = dq[0];
-    deflectionVars["theta_y"] = dq[1];
-    deflectionVars["theta_z"] = dq[2];
-    deflectionVars["delta_x"] = dq[3];
-    deflectionVars["delta_y"] = dq[4];
-    deflectionVars["delta_z"] = dq[5];
-
-
-    fk[0] = MxProg.evaluate(deflectionVars);
-    fk[1] = MyProg.evaluate(deflectionVars);
-    fk[2] = MzProg.evaluate(deflectionVars);
-    fk[3] = FxProg.evaluate(deflectionVars);
-    fk[4] = FyProg.evaluate(deflectionVars);
-    fk[5] = FzProg.evaluate(deflectionVars);
+    // The variables of the expressions are the components of dq, in order.
+    for (int i = 0; i < 6; ++i)
+        fk[i] = _expressions[i].evaluate(&dq[0], _variableIndices[i]);
 
     return -fk;
 }
@@ -27,6 +27,7 @@
 // INCLUDE
 #include "Force.h"
 #include <OpenSim/Simulation/Model/TwoFrameLinker.h>
+#include <lepton/CompiledExpression.h>
 
 namespace OpenSim {
 
@@ -272,8 +273,15 @@ private:
 
     SimTK::Mat66 _dampingMatrix{ 0.0 };
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram MxProg, MyProg, MzProg, FxProg, FyProg, FzProg;
+    /** Compile the expression of the component (0-5 for Mx, My, Mz, Fx, Fy,
+    Fz) of the stiffness force, and look up the indices of its variables. */
+    void compileExpression(int component, const std::string& expression);
+
+    // compiled expressions for efficiently evaluating Mx, My, Mz, Fx, Fy and
+    // Fz, and the indices of their variables (theta_x, theta_y, theta_z,
+    // delta_x, delta_y, delta_z), which are looked up once
+    Lepton::CompiledExpression _expressions[6];
+    std::vector<int> _variableIndices[6];
 
 //==============================================================================
 };  // END of class ExpressionBasedBushingForce
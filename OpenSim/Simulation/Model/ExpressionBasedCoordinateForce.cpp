@@ -97,7 +97,15 @@ void ExpressionBasedCoordinateForce::extendConnectToModel(Model& aModel)
             remove_if(expression.begin(), expression.end(), ::isspace), 
                       expression.end() );
     
-    _forceProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _forceExpression =
+            Lepton::Parser::parse(expression).createCompiledExpression();
+    for (const auto& name : _forceExpression.getVariables()) {
+        OPENSIM_THROW_IF_FRMOBJ(name != "q" && name != "qdot", Exception,
+                "Expression '{}' contains unknown variable '{}'; only 'q' and "
+                "'qdot' are allowed.", expression, name);
+    }
+    _forceVariableIndices = {_forceExpression.getVariableIndex("q"),
+                             _forceExpression.getVariableIndex("qdot")};
 
     // Look up the coordinate
     if (!_model->updCoordinateSet().contains(coordName)) {
@@ -135,12 +143,9 @@ void ExpressionBasedCoordinateForce::computeForce(const SimTK::State& s,
 double ExpressionBasedCoordinateForce::calcExpressionForce(const SimTK::State& s ) const
 {
     using namespace SimTK;
-    double q = _coord->getValue(s);
-    double qdot = _coord->getSpeedValue(s);
-    std::map<std::string, double> forceVars;
-    forceVars["q"] = q;
-    forceVars["qdot"] = qdot;
-    double forceMag = _forceProg.evaluate(forceVars);
+    const double forceVars[] = {_coord->getValue(s), _coord->getSpeedValue(s)};
+    double forceMag = _forceExpression.evaluate(forceVars,
+            _forceVariableIndices);
     setCacheVariableValue(s, _forceMagnitudeCV, forceMag);
     return forceMag;
 }
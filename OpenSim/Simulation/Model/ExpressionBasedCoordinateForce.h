@@ -24,7 +24,7 @@
  * -------------------------------------------------------------------------- */
 // INCLUDE
 #include "Force.h"
-#include <lepton/ExpressionProgram.h>
+#include <lepton/CompiledExpression.h>
 
 namespace OpenSim {
 
@@ -126,8 +126,10 @@ private:
     void setNull();
     void constructProperties();
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram _forceProg;
+    // compiled expression for efficiently evaluating the force, and the
+    // indices of its variables (q and qdot), which are looked up once
+    Lepton::CompiledExpression _forceExpression;
+    std::vector<int> _forceVariableIndices;
 
     // Corresponding generalized coordinate to which the force
     // is applied.
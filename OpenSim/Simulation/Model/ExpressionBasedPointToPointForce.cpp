@@ -137,7 +137,15 @@ void ExpressionBasedPointToPointForce::extendConnectToModel(Model& model)
             remove_if(expression.begin(), expression.end(), ::isspace), 
                       expression.end() );
     
-    _forceProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _forceExpression =
+            Lepton::Parser::parse(expression).createCompiledExpression();
+    for (const auto& name : _forceExpression.getVariables()) {
+        OPENSIM_THROW_IF_FRMOBJ(name != "d" && name != "ddot", Exception,
+                "Expression '{}' contains unknown variable '{}'; only 'd' and "
+                "'ddot' are allowed.", expression, name);
+    }
+    _forceVariableIndices = {_forceExpression.getVariableIndex("d"),
+                             _forceExpression.getVariableIndex("ddot")};
 }
 
 //=============================================================================
@@ -187,11 +195,9 @@ void ExpressionBasedPointToPointForce::computeForce(const SimTK::State& s,
     //speed along the line connecting the two bodies
     const double ddot = dot(vRel, r_G)/d;
 
-    std::map<std::string, double> forceVars;
-    forceVars["d"] = d;
-    forceVars["ddot"] = ddot;
-
-    double forceMag = _forceProg.evaluate(forceVars);
+    const double forceVars[] = {d, ddot};
+    double forceMag = _forceExpression.evaluate(forceVars,
+            _forceVariableIndices);
     setCacheVariableValue(s, _forceMagnitudeCV, forceMag);
 
     const Vec3 f1_G = (forceMag/d) * r_G;
@@ -89,7 +89,11 @@ void Force::extendAddToSystem(SimTK::MultibodySystem& system) const
 {
     Super::extendAddToSystem(system);
 
-    ForceAdapter* adapter = new ForceAdapter(*this);
+    // A Force that the Model computes in parallel with others still gets its
+    // own SimTK::Force so that it can be disabled and provide its potential
+    // energy (see Model::setNumForceThreads()).
+    ForceAdapter* adapter = new ForceAdapter(*this,
+            !_model->isForceComputedInParallel(*this));
     SimTK::Force::Custom force(_model->updForceSubsystem(), adapter);
 
      // Beyond the const Component get the index so we can access the SimTK::Force later
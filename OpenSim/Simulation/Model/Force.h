@@ -229,6 +229,7 @@ private:
     void constructProperties();
 
     friend class ForceAdapter;
+    friend class ParallelForceAdapter;
 
 //=============================================================================
 };  // END of class Force
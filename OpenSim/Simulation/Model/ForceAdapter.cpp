@@ -25,6 +25,13 @@
 // INCLUDES
 //=============================================================================
 #include "ForceAdapter.h"
+#include "GeometryPath.h"
+#include "Model.h"
+#include <OpenSim/Common/CommonUtilities.h>
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
 
 //=============================================================================
 // STATICS
@@ -35,7 +42,8 @@ using SimTK::Vec3;
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
-ForceAdapter::ForceAdapter(const Force& force) : _force(&force)
+ForceAdapter::ForceAdapter(const Force& force, bool computesForce) :
+    _force(&force), _computesForce(computesForce)
 {
 }
 
@@ -46,7 +54,8 @@ void ForceAdapter::calcForce(const SimTK::State& state,
     SimTK::Vector_<SimTK::SpatialVec>& bodyForces,SimTK::Vector_<SimTK::Vec3>& particleForces,
     SimTK::Vector& mobilityForces) const
 {
-    _force->computeForce(state, bodyForces, mobilityForces);
+    if (_computesForce)
+        _force->computeForce(state, bodyForces, mobilityForces);
 }
 
 SimTK::Real ForceAdapter::calcPotentialEnergy(const SimTK::State& state) const
@@ -56,4 +65,121 @@ SimTK::Real ForceAdapter::calcPotentialEnergy(const SimTK::State& state) const
 
 bool ForceAdapter::shouldBeParallelized() const {
     return _force->shouldBeParallelized(); 
-}
\ No newline at end of file
+}
+
+
+//=============================================================================
+// PARALLEL FORCE ADAPTER
+//=============================================================================
+// Computes the forces of one group per call to execute(), into the buffers of
+// that group. The first exception thrown by a Force is kept and rethrown on
+// the calling thread, since the ParallelExecutor cannot propagate it.
+class ParallelForceAdapter::CalcForceTask : public SimTK::ParallelExecutor::Task
+{
+public:
+    CalcForceTask(const ParallelForceAdapter& adapter,
+            const SimTK::State& state, int numGroups) :
+        _adapter(adapter), _state(state),
+        bodyForces(numGroups), mobilityForces(numGroups) {}
+
+    void execute(int group) override {
+        try {
+            _adapter.calcGroupForces(_state, group, bodyForces[group],
+                    mobilityForces[group]);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_exception) _exception = std::current_exception();
+        }
+    }
+
+    void rethrowIfFailed() const {
+        if (_exception) std::rethrow_exception(_exception);
+    }
+
+    std::vector<SimTK::Vector_<SimTK::SpatialVec>> bodyForces;
+    std::vector<SimTK::Vector> mobilityForces;
+
+private:
+    const ParallelForceAdapter& _adapter;
+    const SimTK::State& _state;
+    std::mutex _mutex;
+    std::exception_ptr _exception;
+};
+
+ParallelForceAdapter::ParallelForceAdapter(const Model& model,
+        const std::vector<const Force*>& forces, int numThreads) :
+    _model(&model), _forces(forces)
+{
+    for (const Force* force : _forces) {
+        for (const GeometryPath& path :
+                force->getComponentList<GeometryPath>())
+            _paths.push_back(&path);
+    }
+    for (const Frame& frame : model.getComponentList<Frame>())
+        _frames.push_back(&frame);
+
+    numThreads = getNumThreadsToUse(numThreads);
+    _executor = std::make_shared<SimTK::ParallelExecutor>(numThreads);
+
+    // Use a few more groups than threads so that the threads stay busy when
+    // the forces are not equally expensive (e.g., some paths wrap).
+    const int numForces = (int)_forces.size();
+    const int numGroups = std::max(1, std::min(4 * numThreads, numForces));
+    _groupBegin.resize(numGroups + 1);
+    for (int g = 0; g <= numGroups; ++g)
+        _groupBegin[g] = (int)((long long)g * numForces / numGroups);
+}
+
+void ParallelForceAdapter::prepareForces(const SimTK::State& state) const
+{
+    // The controls are computed on demand by the first Actuator that needs
+    // them, and cached for all Actuators.
+    _model->getControls(state);
+    // Frames cache their transform and velocity on demand, and many Forces
+    // use the same Frames.
+    for (const Frame* frame : _frames) {
+        frame->getTransformInGround(state);
+        frame->getVelocityInGround(state);
+    }
+    // Computing a path wraps it over WrapObjects that other paths may also
+    // use, and updates the previous wrap of each of its PathWraps. Once the
+    // paths are cached, computing the forces does not recompute them.
+    for (const GeometryPath* path : _paths) {
+        path->getLength(state);
+        path->getLengtheningSpeed(state);
+    }
+}
+
+void ParallelForceAdapter::calcGroupForces(const SimTK::State& state,
+        int group, SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector& mobilityForces) const
+{
+    bodyForces.resize(_model->getMatterSubsystem().getNumBodies());
+    mobilityForces.resize(state.getNU());
+    bodyForces.setToZero();
+    mobilityForces.setToZero();
+    for (int i = _groupBegin[group]; i < _groupBegin[group + 1]; ++i) {
+        const Force& force = *_forces[i];
+        if (force.appliesForce(state))
+            force.computeForce(state, bodyForces, mobilityForces);
+    }
+}
+
+void ParallelForceAdapter::calcForce(const SimTK::State& state,
+    SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+    SimTK::Vector_<SimTK::Vec3>& particleForces,
+    SimTK::Vector& mobilityForces) const
+{
+    // Anything that the Forces share must not be computed concurrently.
+    prepareForces(state);
+
+    const int numGroups = (int)_groupBegin.size() - 1;
+    CalcForceTask task(*this, state, numGroups);
+    _executor->execute(task, numGroups);
+    task.rethrowIfFailed();
+
+    for (int g = 0; g < numGroups; ++g) {
+        bodyForces += task.bodyForces[g];
+        mobilityForces += task.mobilityForces[g];
+    }
+}
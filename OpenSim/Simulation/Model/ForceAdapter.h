@@ -30,8 +30,15 @@
 
 #include <SimTKsimbody.h>
 
+#include <memory>
+#include <vector>
+
 namespace OpenSim {
 
+class Frame;
+class GeometryPath;
+class Model;
+
 //=============================================================================
 //=============================================================================
 /**
@@ -46,13 +53,17 @@ class OSIMSIMULATION_API ForceAdapter : public SimTK::Force::Custom::Implementat
 //=============================================================================
 private:
     const Force* _force;
+    bool _computesForce;
 
 //=============================================================================
 // METHODS
 //=============================================================================
 public:
     // CONSTRUCTION AND DESTRUCTION
-    ForceAdapter(const Force& force);
+    /** If computesForce is false, the force is computed by a
+    ParallelForceAdapter instead, and this adapter only provides the
+    potential energy of the force and the means to disable it. */
+    ForceAdapter(const Force& force, bool computesForce = true);
 
     // CALC FORCES (Called by Simbody)
     void calcForce(const SimTK::State& state,
@@ -69,6 +80,68 @@ public:
     // to OpenSim Force elements.
 };
 
+//=============================================================================
+//=============================================================================
+/**
+ * This adapter computes a group of Forces as a single SimTK::Force, with the
+ * Forces divided among a pool of threads. Each group of Forces applies its
+ * forces to its own body force and mobility force buffers, and the buffers
+ * are then summed into the arrays provided by Simbody. Used by Model when
+ * Model::setNumForceThreads() requests it.
+ *
+ * The Forces in the group must not modify anything but their own cache
+ * variables in computeForce(). Everything they share is computed serially
+ * before the Forces are divided among the threads: the Model's controls, the
+ * transforms and velocities of all of the Model's Frames (cached lazily by
+ * each Frame), and the paths of the Forces (whose wrapping may involve
+ * WrapObjects shared with other paths). The buffers are allocated for each
+ * call, so that several States may be evaluated at once.
+ */
+class OSIMSIMULATION_API ParallelForceAdapter
+        : public SimTK::Force::Custom::Implementation
+{
+//=============================================================================
+// DATA
+//=============================================================================
+private:
+    const Model* _model;
+    std::vector<const Force*> _forces;
+    // The paths of the Forces, and all of the Model's Frames.
+    std::vector<const GeometryPath*> _paths;
+    std::vector<const Frame*> _frames;
+    // Index of the first Force of each group, and one past the last Force.
+    std::vector<int> _groupBegin;
+    std::shared_ptr<SimTK::ParallelExecutor> _executor;
+
+    class CalcForceTask;
+    // Compute the cached quantities that the Forces share.
+    void prepareForces(const SimTK::State& state) const;
+    // Compute the forces of one group into the given buffers.
+    void calcGroupForces(const SimTK::State& state, int group,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& mobilityForces) const;
+
+//=============================================================================
+// METHODS
+//=============================================================================
+public:
+    // CONSTRUCTION AND DESTRUCTION
+    /** numThreads follows the convention of getNumThreadsToUse(). */
+    ParallelForceAdapter(const Model& model,
+            const std::vector<const Force*>& forces, int numThreads);
+
+    // CALC FORCES (Called by Simbody)
+    void calcForce(const SimTK::State& state,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces,SimTK::Vector_<SimTK::Vec3>& particleForces,
+        SimTK::Vector& mobilityForces) const override;
+
+    // The potential energy of each Force is provided by its ForceAdapter.
+    SimTK::Real calcPotentialEnergy(const SimTK::State& state) const override
+    {   return 0; }
+
+    int getNumThreads() const { return _executor->getMaxThreads(); }
+};
+
 } // end of namespace OpenSim
 
 #endif // OPENSIM_FORCE_ADAPTER_H_
@@ -39,6 +39,65 @@ using namespace OpenSim;
 using namespace SimTK;
 using SimTK::Vec3;
 
+namespace {
+    // Exponents of the terms of a MultivariatePolynomialFunction of the given
+    // dimension and order, in the order of its coefficients.
+    std::vector<std::array<int, 4>> calcPolynomialExponents(
+            int dimension, int order) {
+        std::vector<std::array<int, 4>> exponents;
+        std::array<int, 4> e{{0, 0, 0, 0}};
+        for (e[0] = 0; e[0] <= order; ++e[0]) {
+            const int max1 = dimension < 2 ? 0 : order - e[0];
+            for (e[1] = 0; e[1] <= max1; ++e[1]) {
+                const int max2 = dimension < 3 ? 0 : order - e[0] - e[1];
+                for (e[2] = 0; e[2] <= max2; ++e[2]) {
+                    const int max3 =
+                            dimension < 4 ? 0 : order - e[0] - e[1] - e[2];
+                    for (e[3] = 0; e[3] <= max3; ++e[3]) {
+                        exponents.push_back(e);
+                    }
+                }
+            }
+        }
+        return exponents;
+    }
+
+    // Powers 0 through order of the first n entries of x, stored such that
+    // powers[i * (order + 1) + k] is x[i]^k.
+    void calcPowers(const SimTK::Vec4& x, int n, int order,
+            std::vector<double>& powers) {
+        powers.resize(n * (order + 1));
+        for (int i = 0; i < n; ++i) {
+            double* xi = &powers[i * (order + 1)];
+            xi[0] = 1.0;
+            for (int k = 1; k <= order; ++k) xi[k] = xi[k - 1] * x[i];
+        }
+    }
+
+    // Value of the monomial with exponents e, given the powers computed by
+    // calcPowers(). If partials is not null, it is filled with the partial
+    // derivatives of the monomial with respect to the n variables.
+    double calcMonomial(const std::array<int, 4>& e,
+            const std::vector<double>& powers, int n, int order,
+            SimTK::Vec4* partials) {
+        const int stride = order + 1;
+        double value = 1.0;
+        for (int i = 0; i < n; ++i) value *= powers[i * stride + e[i]];
+        if (partials) {
+            *partials = 0;
+            for (int j = 0; j < n; ++j) {
+                if (e[j] == 0) continue;
+                double partial = e[j] * powers[j * stride + e[j] - 1];
+                for (int i = 0; i < n; ++i) {
+                    if (i != j) partial *= powers[i * stride + e[i]];
+                }
+                (*partials)[j] = partial;
+            }
+        }
+        return value;
+    }
+}
+
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -85,6 +144,37 @@ void GeometryPath::extendConnectToModel(Model& aModel)
     // (i.e., the set of currently active points is numbered
     // 1, 2, 3, ...).
     namePathPoints(0);
+
+    _polynomialCoordinates.clear();
+    _polynomialExponents.clear();
+    if (!getProperty_length_polynomial().empty()) {
+        const MultivariatePolynomialFunction& polynomial =
+                get_length_polynomial();
+        const int numCoords = getProperty_polynomial_coordinates().size();
+        OPENSIM_THROW_IF_FRMOBJ(numCoords < 1 || numCoords > 4 ||
+                        numCoords != polynomial.getDimension(),
+                InvalidPropertyValue,
+                getProperty_polynomial_coordinates().getName(),
+                fmt::format("Expected between 1 and 4 coordinates, matching "
+                            "the dimension of the length_polynomial ({}), but "
+                            "got {}.",
+                        polynomial.getDimension(), numCoords));
+        std::vector<std::array<int, 4>> exponents =
+                calcPolynomialExponents(numCoords, polynomial.getOrder());
+        OPENSIM_THROW_IF_FRMOBJ(polynomial.getCoefficients().size() !=
+                                        (int)exponents.size(),
+                InvalidPropertyValue,
+                getProperty_length_polynomial().getName(),
+                fmt::format("Expected {} coefficients for a polynomial of "
+                            "dimension {} and order {}, but got {}.",
+                        exponents.size(), numCoords, polynomial.getOrder(),
+                        polynomial.getCoefficients().size()));
+        for (int i = 0; i < numCoords; ++i) {
+            _polynomialCoordinates.push_back(&aModel.getComponent<Coordinate>(
+                    get_polynomial_coordinates(i)));
+        }
+        _polynomialExponents = std::move(exponents);
+    }
 }
 
 //_____________________________________________________________________________
@@ -198,6 +288,9 @@ void GeometryPath::constructProperties()
     Appearance appearance;
     appearance.set_color(SimTK::Gray);
     constructProperty_Appearance(appearance);
+
+    constructProperty_polynomial_coordinates();
+    constructProperty_length_polynomial();
 }
 
 //_____________________________________________________________________________
@@ -305,6 +398,27 @@ void GeometryPath::addInEquivalentForces(const SimTK::State& s,
     SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
     SimTK::Vector& mobilityForces) const
 {
+    if (isUsingPolynomialApproximation()) {
+        // The generalized forces are -tension * dL/du, where
+        // dL/du = ~N * dL/dq since qdot = N u.
+        const SimTK::SimbodyMatterSubsystem& matter =
+                getModel().getMatterSubsystem();
+        SimTK::Vec4 dLdq;
+        calcPolynomialLength(s, &dLdq);
+        SimTK::Vector lengthPartials(s.getNQ(), 0.0);
+        for (int i = 0; i < (int)_polynomialCoordinates.size(); ++i) {
+            const Coordinate& coord = *_polynomialCoordinates[i];
+            const int qIndex = matter.getMobilizedBody(coord.getBodyIndex())
+                                       .getFirstQIndex(s) +
+                               coord.getMobilizerQIndex();
+            lengthPartials[qIndex] = dLdq[i];
+        }
+        SimTK::Vector lengthPartialsU;
+        matter.multiplyByN(s, true, lengthPartials, lengthPartialsU);
+        mobilityForces -= tension * lengthPartialsU;
+        return;
+    }
+
     AbstractPathPoint* start = NULL;
     AbstractPathPoint* end = NULL;
     const SimTK::MobilizedBody* bo = NULL;
@@ -448,6 +562,12 @@ void GeometryPath::updateGeometry(const SimTK::State& s) const
  */
 double GeometryPath::getLength( const SimTK::State& s) const
 {
+    if (isUsingPolynomialApproximation()) {
+        if (!isCacheVariableValid(s, _lengthCV)) {
+            setLength(s, calcPolynomialLength(s));
+        }
+        return getCacheVariableValue(s, _lengthCV);
+    }
     computePath(s);  // compute checks if path needs to be recomputed
     return getCacheVariableValue(s, _lengthCV);
 }
@@ -845,6 +965,23 @@ void GeometryPath::computeLengtheningSpeed(const SimTK::State& s) const
         return;
     }
 
+    if (isUsingPolynomialApproximation()) {
+        const SimTK::SimbodyMatterSubsystem& matter =
+                getModel().getMatterSubsystem();
+        SimTK::Vec4 dLdq;
+        calcPolynomialLength(s, &dLdq);
+        double speed = 0.0;
+        for (int i = 0; i < (int)_polynomialCoordinates.size(); ++i) {
+            const Coordinate& coord = *_polynomialCoordinates[i];
+            const int qIndex = matter.getMobilizedBody(coord.getBodyIndex())
+                                       .getFirstQIndex(s) +
+                               coord.getMobilizerQIndex();
+            speed += dLdq[i] * s.getQDot()[qIndex];
+        }
+        setLengtheningSpeed(s, speed);
+        return;
+    }
+
     const Array<AbstractPathPoint*>& currentPath = getCurrentPath(s);
 
     double speed = 0.0;
@@ -988,6 +1125,7 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
                             // Store the best wrap in the pathWrap for possible 
                             // use next time.
                             ws.setPreviousWrap(wr);
+                            ws.setWarmStartWrap(s, wr);
                             break;
                         }  else if (result[i] == WrapObject::wrapped) {
                             // "wrapped" means the path segment was wrapped over
@@ -1002,6 +1140,7 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
                                 // Store the best wrap in the pathWrap for 
                                 // possible use next time
                                 ws.setPreviousWrap(wr);
+                                ws.setWarmStartWrap(s, wr);
                                 min_length_change = path_length_change;
                             } else {
                                 // The wrap was not shorter than the current 
@@ -1020,6 +1159,7 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
 
                 if (best_wrap.wrap_pts.getSize() == 0) {
                     ws.resetPreviousWrap();
+                    ws.resetWarmStartWrap(s);
                     ws.updWrapPoint2().getWrapPath().setSize(0);
                 } else {
                     // If wrapping did occur, copy wrap info into the PathStruct.
@@ -1134,7 +1274,10 @@ calcLengthAfterPathComputation(const SimTK::State& s,
         }
     }
 
-    setLength(s,length);
+    // When the path is approximated by a polynomial, the path points are
+    // only computed for visualization and must not overwrite the length.
+    if (!isUsingPolynomialApproximation())
+        setLength(s,length);
     return( length );
 }
 
@@ -1153,6 +1296,186 @@ computeMomentArm(const SimTK::State& s, const Coordinate& aCoord) const
     return _maSolver->solve(s, aCoord,  *this);
 }
 
+//=============================================================================
+// POLYNOMIAL APPROXIMATION
+//=============================================================================
+double GeometryPath::calcPolynomialLength(const SimTK::State& s,
+        SimTK::Vec4* lengthPartials) const
+{
+    const MultivariatePolynomialFunction& polynomial = get_length_polynomial();
+    const SimTK::Vector& coefficients = polynomial.getCoefficients();
+    const int order = polynomial.getOrder();
+    const int n = (int)_polynomialCoordinates.size();
+
+    SimTK::Vec4 x(0);
+    for (int i = 0; i < n; ++i) x[i] = _polynomialCoordinates[i]->getValue(s);
+    std::vector<double> powers;
+    calcPowers(x, n, order, powers);
+
+    double length = 0.0;
+    if (lengthPartials) *lengthPartials = 0;
+    SimTK::Vec4 partials;
+    for (int t = 0; t < (int)_polynomialExponents.size(); ++t) {
+        length += coefficients[t] * calcMonomial(_polynomialExponents[t],
+                powers, n, order, lengthPartials ? &partials : nullptr);
+        if (lengthPartials) *lengthPartials += coefficients[t] * partials;
+    }
+    return length;
+}
+
+SimTK::Vec4 GeometryPath::fitPolynomialApproximation(const SimTK::State& s,
+        int order, int numSamplesPerCoordinate)
+{
+    OPENSIM_THROW_IF_FRMOBJ(order < 1, Exception,
+            "Expected order to be at least 1, but got {}.", order);
+
+    const Model& model = getModel();
+    const SimTK::SimbodyMatterSubsystem& matter = model.getMatterSubsystem();
+
+    // Sample the path geometry, even if the path is currently approximated.
+    _polynomialCoordinates.clear();
+    _polynomialExponents.clear();
+    SimTK::State state = s;
+
+    // Find the coordinates that change the length of the path by sweeping
+    // each independent coordinate over its range.
+    const double lengthChangeTolerance = 1e-6;
+    const int numSweepPoints = 7;
+    std::vector<const Coordinate*> coords;
+    for (const Coordinate& coord : model.getComponentList<Coordinate>()) {
+        if (coord.isDependent(state) || coord.getLocked(state)) continue;
+        const double defaultValue = coord.getValue(state);
+        const double rangeMin = coord.getRangeMin();
+        const double rangeMax = coord.getRangeMax();
+        double minLength = SimTK::Infinity;
+        double maxLength = -SimTK::Infinity;
+        for (int k = 0; k < numSweepPoints; ++k) {
+            coord.setValue(state,
+                    rangeMin + k * (rangeMax - rangeMin) / (numSweepPoints - 1),
+                    false);
+            model.realizePosition(state);
+            const double length = getLength(state);
+            minLength = std::min(minLength, length);
+            maxLength = std::max(maxLength, length);
+        }
+        coord.setValue(state, defaultValue, false);
+        if (maxLength - minLength > lengthChangeTolerance) {
+            coords.push_back(&coord);
+        }
+    }
+    const int n = (int)coords.size();
+    OPENSIM_THROW_IF_FRMOBJ(n == 0, Exception,
+            "The length of the path does not depend on any coordinate.");
+    OPENSIM_THROW_IF_FRMOBJ(n > 4, Exception,
+            "Expected the path to span at most 4 coordinates, but it spans "
+            "{}.", n);
+
+    if (numSamplesPerCoordinate <= 0) {
+        numSamplesPerCoordinate = std::max(order + 2,
+                (int)std::ceil(std::pow(3000.0, 1.0 / n)));
+    }
+    OPENSIM_THROW_IF_FRMOBJ(numSamplesPerCoordinate < 2, Exception,
+            "Expected at least 2 samples per coordinate, but got {}.",
+            numSamplesPerCoordinate);
+    int numSamples = 1;
+    for (int i = 0; i < n; ++i) numSamples *= numSamplesPerCoordinate;
+
+    const std::vector<std::array<int, 4>> exponents =
+            calcPolynomialExponents(n, order);
+    const int numTerms = (int)exponents.size();
+
+    // Each sample contributes one row for the length and one row for each
+    // of its partial derivatives with respect to the coordinates.
+    SimTK::Matrix A(numSamples * (n + 1), numTerms);
+    SimTK::Vector b(numSamples * (n + 1));
+    SimTK::Vector_<SimTK::Vec4> sampleCoords(numSamples);
+    std::vector<double> powers;
+    SimTK::Vector_<SimTK::SpatialVec> bodyForces(matter.getNumBodies());
+    SimTK::Vector mobilityForces(state.getNU());
+    SimTK::Vector generalizedForces;
+    SimTK::Vector lengthPartials;
+    for (int isample = 0; isample < numSamples; ++isample) {
+        SimTK::Vec4& x = sampleCoords[isample];
+        x = 0;
+        int index = isample;
+        for (int i = 0; i < n; ++i) {
+            const int k = index % numSamplesPerCoordinate;
+            index /= numSamplesPerCoordinate;
+            x[i] = coords[i]->getRangeMin() +
+                   k * (coords[i]->getRangeMax() - coords[i]->getRangeMin()) /
+                           (numSamplesPerCoordinate - 1);
+            coords[i]->setValue(state, x[i], false);
+        }
+        model.realizePosition(state);
+
+        // The partial derivatives of the length with respect to q follow
+        // from the generalized forces of a unit tension, f = -~N * dL/dq
+        // (see MomentArmSolver).
+        bodyForces = SimTK::SpatialVec(SimTK::Vec3(0), SimTK::Vec3(0));
+        mobilityForces = 0;
+        addInEquivalentForces(state, 1.0, bodyForces, mobilityForces);
+        matter.multiplyBySystemJacobianTranspose(
+                state, bodyForces, generalizedForces);
+        generalizedForces += mobilityForces;
+        matter.multiplyByNInv(state, true, generalizedForces, lengthPartials);
+
+        const int row = isample * (n + 1);
+        b[row] = getLength(state);
+        for (int i = 0; i < n; ++i) {
+            const int qIndex = matter.getMobilizedBody(coords[i]->getBodyIndex())
+                                       .getFirstQIndex(state) +
+                               coords[i]->getMobilizerQIndex();
+            b[row + 1 + i] = -lengthPartials[qIndex];
+        }
+
+        calcPowers(x, n, order, powers);
+        SimTK::Vec4 partials;
+        for (int t = 0; t < numTerms; ++t) {
+            A(row, t) = calcMonomial(exponents[t], powers, n, order, &partials);
+            for (int i = 0; i < n; ++i) A(row + 1 + i, t) = partials[i];
+        }
+    }
+
+    SimTK::Vector coefficients;
+    SimTK::FactorQTZ(A).solve(b, coefficients);
+
+    // Errors in the length and in the moment arms (-dL/dq) over all samples.
+    const SimTK::Vector residuals = A * coefficients - b;
+    double sumSqLength = 0, maxLength = 0, sumSqMomentArm = 0, maxMomentArm = 0;
+    for (int isample = 0; isample < numSamples; ++isample) {
+        const int row = isample * (n + 1);
+        sumSqLength += SimTK::square(residuals[row]);
+        maxLength = std::max(maxLength, std::abs(residuals[row]));
+        for (int i = 0; i < n; ++i) {
+            sumSqMomentArm += SimTK::square(residuals[row + 1 + i]);
+            maxMomentArm =
+                    std::max(maxMomentArm, std::abs(residuals[row + 1 + i]));
+        }
+    }
+    const SimTK::Vec4 errors(std::sqrt(sumSqLength / numSamples), maxLength,
+            std::sqrt(sumSqMomentArm / (numSamples * n)), maxMomentArm);
+
+    updProperty_polynomial_coordinates().clear();
+    for (const Coordinate* coord : coords) {
+        updProperty_polynomial_coordinates().appendValue(
+                coord->getAbsolutePathString());
+    }
+    set_length_polynomial(MultivariatePolynomialFunction(coefficients, n, order));
+
+    log_info("Fitted a polynomial of order {} in {} coordinates to the path "
+             "'{}' using {} samples: length error RMS {} (max {}), moment "
+             "arm error RMS {} (max {}).",
+            order, n, getAbsolutePathString(), numSamples, errors[0],
+            errors[1], errors[2], errors[3]);
+    return errors;
+}
+
+void GeometryPath::clearPolynomialApproximation()
+{
+    updProperty_polynomial_coordinates().clear();
+    updProperty_length_polynomial().clear();
+}
+
 //_____________________________________________________________________________
 // Override default implementation by object to intercept and fix the XML node
 // underneath the model to match current version.
@@ -30,6 +30,8 @@
 #include "PathPointSet.h"
 #include <OpenSim/Simulation/Wrap/PathWrapSet.h>
 #include <OpenSim/Simulation/MomentArmSolver.h>
+#include <OpenSim/Common/MultivariatePolynomialFunction.h>
+#include <array>
 
 
 #ifdef SWIG
@@ -52,6 +54,14 @@ class WrapObject;
 /**
  * A base class representing a path (muscle, ligament, etc.).
  *
+ * The length of the path is normally computed from its path points and wrap
+ * objects. Alternatively, the path can be approximated by a polynomial of the
+ * coordinates it spans (see fitPolynomialApproximation()). When the
+ * length_polynomial property is set, the length, lengthening speed, and the
+ * generalized forces applied by the path are computed from the polynomial and
+ * its partial derivatives, which is much cheaper than evaluating the path
+ * geometry with wrapping. The path points are still used for visualization.
+ *
  * @author Peter Loan
  * @version 1.0
  */
@@ -72,6 +82,16 @@ public:
     OpenSim_DECLARE_UNNAMED_PROPERTY(Appearance,
         "Default appearance attributes for this GeometryPath");
 
+    OpenSim_DECLARE_LIST_PROPERTY(polynomial_coordinates, std::string,
+        "Paths to the coordinates (at most 4) that are the independent "
+        "variables of the length_polynomial, in order.");
+
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(length_polynomial,
+        MultivariatePolynomialFunction,
+        "If specified, the path length is computed from this polynomial of "
+        "the polynomial_coordinates instead of from the path points and wrap "
+        "objects. See fitPolynomialApproximation().");
+
 private:
     OpenSim_DECLARE_UNNAMED_PROPERTY(PathPointSet,
         "The set of points defining the path");
@@ -87,6 +107,12 @@ private:
     // cleared on copy.
     SimTK::ResetOnCopy<std::unique_ptr<MomentArmSolver> > _maSolver;
 
+    // Coordinates of the length_polynomial and the exponents of each of its
+    // terms, in the order of its coefficients. These are empty if the path is
+    // not approximated by a polynomial.
+    SimTK::ResetOnCopy<std::vector<const Coordinate*> > _polynomialCoordinates;
+    SimTK::ResetOnCopy<std::vector<std::array<int, 4> > > _polynomialExponents;
+
     mutable CacheVariable<double> _lengthCV;
     mutable CacheVariable<double> _speedCV;
     mutable CacheVariable<Array<AbstractPathPoint*>> _currentPathCV;
@@ -187,6 +213,47 @@ public:
     //--------------------------------------------------------------------------
     virtual double computeMomentArm(const SimTK::State& s, const Coordinate& aCoord) const;
 
+    //--------------------------------------------------------------------------
+    // POLYNOMIAL APPROXIMATION
+    //--------------------------------------------------------------------------
+    /** Fit a polynomial of the coordinates spanned by this path to its length
+    and moment arms, and store it in the length_polynomial and
+    polynomial_coordinates properties. The spanned coordinates are found by
+    sweeping each independent coordinate over its range; at most 4 coordinates
+    are supported. The path length and moment arms are sampled on a uniform
+    grid over the ranges of the spanned coordinates while all other
+    coordinates keep their values in the given state, and the coefficients are
+    found by a least-squares fit to both the lengths and the moment arms.
+    Coupled (dependent) coordinates are not detected, so paths that depend on
+    them should not be approximated.
+
+    The approximation takes effect the next time the system is created
+    (e.g., Model::initSystem()).
+
+    @param s       state providing the values of the coordinates that the
+                   path does not span.
+    @param order   order of the polynomial.
+    @param numSamplesPerCoordinate  number of grid points along each spanned
+                   coordinate. By default, this is chosen so that the grid has
+                   a few thousand points.
+    @returns the root-mean-square and maximum errors of the fitted length, and
+             the root-mean-square and maximum errors of the fitted moment
+             arms, over all samples. */
+    SimTK::Vec4 fitPolynomialApproximation(const SimTK::State& s,
+            int order = 4, int numSamplesPerCoordinate = 0);
+
+    /** Remove the polynomial approximation, if any, so that the path is
+    computed from its path points and wrap objects again (once the system is
+    recreated). */
+    void clearPolynomialApproximation();
+
+    /** Whether the length of this path is currently computed from the
+    length_polynomial. This is false until the model's connections are
+    finalized (e.g., by Model::initSystem()). */
+    bool isUsingPolynomialApproximation() const {
+        return !_polynomialCoordinates.empty();
+    }
+
     //--------------------------------------------------------------------------
     // SCALING
     //--------------------------------------------------------------------------
@@ -233,6 +300,10 @@ private:
                                 const Array<AbstractPathPoint*>& path) const; 
     double calcLengthAfterPathComputation
        (const SimTK::State& s, const Array<AbstractPathPoint*>& currentPath) const;
+    // Evaluate the length_polynomial and, optionally, its partial derivatives
+    // with respect to the polynomial_coordinates.
+    double calcPolynomialLength(const SimTK::State& s,
+            SimTK::Vec4* lengthPartials = nullptr) const;
 
     void constructProperties();
     void namePathPoints(int aStartingIndex);
@@ -35,6 +35,7 @@
 #include "ContactGeometrySet.h"
 #include "ControllerSet.h"
 #include "CoordinateSet.h"
+#include "ForceAdapter.h"
 #include "ForceSet.h"
 #include "Ligament.h"
 #include "MarkerSet.h"
@@ -79,6 +80,7 @@ Model::Model() : ModelComponent(),
     _coordinateSet(CoordinateSet()),
     _workingState(),
     _useVisualizer(false),
+    _numForceThreads(1),
     _allControllersEnabled(true)
 {
     constructProperties();
@@ -96,6 +98,7 @@ Model::Model(const string &aFileName) :
     _coordinateSet(CoordinateSet()),
     _workingState(),
     _useVisualizer(false),
+    _numForceThreads(1),
     _allControllersEnabled(true)
 {   
     constructProperties();
@@ -317,6 +320,7 @@ void Model::updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber)
 void Model::setNull()
 {
     _useVisualizer = false;
+    _numForceThreads = 1;
     _allControllersEnabled = true;
 
     _validationLog="";
@@ -1010,6 +1014,24 @@ void Model::extendAddToSystem(SimTK::MultibodySystem& system) const
         Stage::Velocity, Stage::Acceleration);
 
     mutableThis->_modelControlsIndex = modelControls.getSubsystemMeasureIndex();
+
+    // Compute the forces along a GeometryPath together, on a pool of
+    // threads, if requested. Each of these forces still adds its own
+    // ForceAdapter (which does not compute the force) to the system.
+    if (_numForceThreads != 1) {
+        std::vector<const Force*> parallelForces;
+        for (const Force& force : getComponentList<Force>()) {
+            if (isForceComputedInParallel(force))
+                parallelForces.push_back(&force);
+        }
+        if (!parallelForces.empty()) {
+            SimTK::Force::Custom(mutableThis->updForceSubsystem(),
+                    new ParallelForceAdapter(*this, parallelForces,
+                            _numForceThreads));
+            log_debug("Model '{}': computing {} forces along paths in "
+                      "parallel.", getName(), parallelForces.size());
+        }
+    }
 }
 
 
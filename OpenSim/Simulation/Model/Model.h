@@ -333,6 +333,28 @@ public:
     take effect at the next call to initSystem() on this %Model. **/
     bool getUseVisualizer() const {return _useVisualizer;}
 
+    /** %Set the number of threads used to compute the forces that act along
+    a GeometryPath (e.g., Muscles and other PathActuators, PathSprings and
+    Ligaments). These forces are usually the most expensive part of
+    computing the dynamics of large musculoskeletal models, and the force of
+    each depends only on its own path and on the Model's controls. If 
+    numThreads is not 1, these forces are divided among a pool of threads;
+    each thread applies its forces to its own copy of the body and mobility
+    forces, and the copies are then summed. A value less than 1 uses as many
+    threads as there are processors. The default is 1 (forces are computed
+    one at a time). Like the visualizer flag, this takes effect at the next
+    call to initSystem(). **/
+    void setNumForceThreads(int numThreads) {_numForceThreads=numThreads;}
+    /** Return the current setting of the number of threads used to compute
+    the forces that act along a GeometryPath. @see setNumForceThreads() **/
+    int getNumForceThreads() const {return _numForceThreads;}
+    /** Return true if the given force is one of those that are divided among
+    the threads requested with setNumForceThreads(). **/
+    bool isForceComputedInParallel(const Force& force) const {
+        return _numForceThreads != 1 && force.hasGeometryPath()
+                && !force.shouldBeParallelized();
+    }
+
     /** Test whether a ModelVisualizer has been created for this Model. Even
     if visualization has been requested there will be no visualizer present
     until initSystem() has been successfully invoked. Use this method prior
@@ -1162,6 +1184,10 @@ private:
     // a ModelVisualizer for display.
     bool _useVisualizer;
 
+    // Number of threads used to compute the forces along a GeometryPath;
+    // takes effect when initSystem() is called.
+    int _numForceThreads;
+
     // Global flag used to disable all Controllers.
     bool _allControllersEnabled;
 
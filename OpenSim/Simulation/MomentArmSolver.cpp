@@ -93,7 +93,43 @@ double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
     return ~_coupling*_generalizedForces;
 }
 
+Matrix MomentArmSolver::solve(const State &state,
+        const std::vector<const Coordinate*>& coordinates,
+        const std::vector<const GeometryPath*>& paths) const
+{
+    //Local modifiable copy of the state
+    State& s_ma = _stateCopy;
+    s_ma.updQ() = state.getQ();
+
+    // The coupling vectors depend only on the coordinate (and q), so compute
+    // them once, as the columns of the coupling matrix.
+    const int nc = (int)coordinates.size();
+    Matrix coupling(s_ma.getNU(), nc);
+    for (int j = 0; j < nc; ++j) {
+        coupling(j) = computeCouplingVector(s_ma, *coordinates[j]);
+    }
 
+    // set speeds to zero
+    s_ma.updU() = 0;
+
+    // The generalized forces due to a unit tension in each path, dotted with
+    // the coupling vector of each coordinate, give the moment-arms.
+    const int np = (int)paths.size();
+    Matrix momentArms(np, nc);
+    Vector pathDependentMobilityForces(s_ma.getNU());
+    for (int i = 0; i < np; ++i) {
+        _bodyForces *= 0;
+        pathDependentMobilityForces = 0;
+        paths[i]->addInEquivalentForces(s_ma, 1.0, _bodyForces,
+                pathDependentMobilityForces);
+        getModel().getMultibodySystem().getMatterSubsystem()
+            .multiplyBySystemJacobianTranspose(s_ma, _bodyForces,
+                    _generalizedForces);
+        _generalizedForces += pathDependentMobilityForces;
+        momentArms[i] = ~_generalizedForces * coupling;
+    }
+    return momentArms;
+}
 
 double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
                               const Array<PointForceDirection *> &pfds) const
@@ -26,6 +26,8 @@
 #include "Solver.h"
 #include "SimTKcommon/internal/State.h"
 
+#include <vector>
+
 namespace OpenSim {
 
 class GeometryPath;
@@ -83,6 +85,25 @@ public:
     double solve(const SimTK::State& state, const Coordinate &coordinate, 
         const Array<PointForceDirection *> &pfds) const;
 
+#ifndef SWIG
+    /** Solve for the moment-arms of several GeometryPaths about several
+        coordinates at once. The result is the same as calling
+        solve(state, coordinate, path) for every pair, but the coupling of
+        each coordinate to the others (due to constraints) is computed only
+        once per coordinate, and the generalized forces of each path only
+        once per path, so the cost grows with the number of paths plus the
+        number of coordinates rather than with their product.
+    @param  state               current state of the model
+    @param  coordinates         Coordinates about which we want the moment-arms
+    @param  paths               GeometryPaths for which to calculate moment-arms
+    @return                     matrix of moment-arms, with a row for each
+                                path and a column for each coordinate
+    */
+    SimTK::Matrix solve(const SimTK::State& state,
+        const std::vector<const Coordinate*>& coordinates,
+        const std::vector<const GeometryPath*>& paths) const;
+#endif
+
 private:
     // Internal state of the solver initialized as a copy of the default state
     mutable SimTK::State _stateCopy;
@@ -139,6 +139,13 @@ TimeSeriesTable StatesTrajectory::exportToTable(const Model& model,
     table.setColumnLabels(stateVars);
     size_t numDepColumns = stateVars.size();
 
+    // Look up the requested state variables once, rather than for each row.
+    std::vector<Component::StateVariableHandle> handles;
+    if (!requestedStateVars.empty()) {
+        handles = model.getStateVariableHandles(stateVars);
+    }
+    SimTK::Vector values(static_cast<int>(numDepColumns));
+
     // Fill up the table with the data.
     for (size_t itime = 0; itime < getSize(); ++itime) {
         const auto& state = get(itime);
@@ -149,10 +156,8 @@ TimeSeriesTable StatesTrajectory::exportToTable(const Model& model,
             // This is *much* faster than getting the values one-by-one.
             row = model.getStateVariableValues(state).transpose();
         } else {
-            for (unsigned icol = 0; icol < numDepColumns; ++icol) {
-                row[static_cast<int>(icol)] =
-                    model.getStateVariableValue(state, stateVars[icol]);
-            }
+            model.getStateVariableValues(state, handles, values);
+            row = values.transpose();
         }
 
         table.appendRow(state.getTime(), row);
@@ -30,8 +30,10 @@
 //
 //==============================================================================
 #include <iostream>
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/Exception.h>
+#include <OpenSim/Common/Stopwatch.h>
 
 #include <OpenSim/Simulation/Model/BodySet.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
@@ -77,6 +79,7 @@ int testBallToBallContact(bool useElasticFoundation, bool useMesh1, bool useMesh
 void compareHertzAndMeshContactResults();
 template <typename ContactType> // e.g., HuntCrossley.
 void testIntermediateFrames();
+void testBoundingVolumeHierarchy();
 
 int main()
 {
@@ -97,6 +100,8 @@ int main()
 
         testIntermediateFrames<OpenSim::HuntCrossleyForce>();
         testIntermediateFrames<OpenSim::ElasticFoundationForce>();
+
+        testBoundingVolumeHierarchy();
     }
     catch (const OpenSim::Exception& e) {
         e.print(cerr);
@@ -612,3 +617,148 @@ void testIntermediateFrames() {
 
 
 
+
+// Compare the forces and potential energy of an ElasticFoundationForce
+// computed with the bounding volume hierarchies of the meshes to those
+// computed by Simbody, for a mesh ball pressed into a mesh, a sphere, and a
+// half space, and report how long each takes to compute the forces.
+void testBoundingVolumeHierarchy()
+{
+    // The ball is on a free body; the other geometry is fixed to ground.
+    auto createModel = [](const std::string& otherType, bool useBVH,
+            int numThreads) -> std::unique_ptr<Model> {
+        std::unique_ptr<Model> model(new Model());
+        model->setGravity(Vec3(0));
+        auto* ball = new OpenSim::Body("ball", mass, Vec3(0), Inertia(1.0));
+        auto* free = new FreeJoint("free", model->getGround(), Vec3(0),
+                Vec3(0), *ball, Vec3(0), Vec3(0));
+        model->addBody(ball);
+        model->addJoint(free);
+        model->addContactGeometry(new ContactMesh(mesh_files[0], Vec3(0),
+                Vec3(0), *ball, "ball"));
+        const auto& ground = model->getGround();
+        if (otherType == "mesh") {
+            model->addContactGeometry(new ContactMesh(mesh_files[0], Vec3(0),
+                    Vec3(0), ground, "other"));
+        } else if (otherType == "sphere") {
+            model->addContactGeometry(
+                    new ContactSphere(radius, Vec3(0), ground, "other"));
+        } else {
+            model->addContactGeometry(new ContactHalfSpace(Vec3(0),
+                    Vec3(0, 0, -0.5*SimTK_PI), ground, "other"));
+        }
+
+        auto* contactParams =
+            new OpenSim::ElasticFoundationForce::ContactParameters(
+                    1.0e6/(2*radius), 0.001, 0.9, 0.8, 0.1);
+        contactParams->addGeometry("ball");
+        contactParams->addGeometry("other");
+        auto* force = new OpenSim::ElasticFoundationForce(contactParams);
+        force->setName("contact");
+        force->setUseBoundingVolumeHierarchy(useBVH);
+        force->setNumThreads(numThreads);
+        model->addForce(force);
+        model->initSystem();
+        return model;
+    };
+
+    // Place the ball so that it penetrates the other geometry by the given
+    // depth, with an arbitrary orientation and velocity.
+    auto setState = [](const std::string& otherType, double depth,
+            SimTK::State& state) {
+        const double height = (otherType == "halfspace" ? 1 : 2) * radius;
+        state.updQ() = Vector(Vec6(0.1, 0.2, 0.3, 0, height - depth, 0));
+        state.updU() = Vector(Vec6(0.5, -0.3, 0.2, 0.1, -0.2, 0.05));
+    };
+
+    const int numEvaluations = 100;
+    for (const std::string otherType : {"mesh", "sphere", "halfspace"}) {
+        cout << "Testing ElasticFoundationForce with bounding volume "
+                "hierarchies, mesh to " << otherType << endl;
+        auto simbodyModel = createModel(otherType, false, 1);
+        auto bvhModel = createModel(otherType, true, 1);
+        auto parallelModel = createModel(otherType, true, 4);
+        const auto& simbodyForce = simbodyModel->getForceSet().get("contact");
+        const auto& bvhForce = bvhModel->getForceSet().get("contact");
+        const auto& parallelForce = parallelModel->getForceSet().get("contact");
+
+        SimTK::State simbodyState = simbodyModel->getWorkingState();
+        SimTK::State bvhState = bvhModel->getWorkingState();
+        SimTK::State parallelState = parallelModel->getWorkingState();
+        for (double depth : {0.002, 0.01, 0.03}) {
+            setState(otherType, depth, simbodyState);
+            setState(otherType, depth, bvhState);
+            setState(otherType, depth, parallelState);
+            simbodyModel->realizeDynamics(simbodyState);
+            bvhModel->realizeDynamics(bvhState);
+            parallelModel->realizeDynamics(parallelState);
+
+            const auto expected = simbodyForce.getRecordValues(simbodyState);
+            const auto bvhValues = bvhForce.getRecordValues(bvhState);
+            const auto parallelValues =
+                    parallelForce.getRecordValues(parallelState);
+            double scale = 0;
+            for (int i = 0; i < expected.getSize(); ++i)
+                scale = std::max(scale, std::abs(expected[i]));
+            // Make sure the geometry is in contact; otherwise, the test is
+            // not meaningful.
+            SimTK_TEST(scale > 0);
+            for (int i = 0; i < expected.getSize(); ++i) {
+                ASSERT_EQUAL(expected[i], bvhValues[i], 1e-3 * scale,
+                        __FILE__, __LINE__,
+                        "BVH contact FAILED to match Simbody contact.");
+                ASSERT_EQUAL(bvhValues[i], parallelValues[i], 1e-10 * scale,
+                        __FILE__, __LINE__,
+                        "Parallel BVH contact FAILED to match serial.");
+            }
+            const double expectedEnergy = simbodyModel->getMultibodySystem()
+                    .calcPotentialEnergy(simbodyState);
+            ASSERT_EQUAL(expectedEnergy, bvhModel->getMultibodySystem()
+                    .calcPotentialEnergy(bvhState), 1e-3 * expectedEnergy,
+                    __FILE__, __LINE__,
+                    "BVH contact energy FAILED to match Simbody contact.");
+        }
+
+        // Computing the potential energy for several States at once must give
+        // the same results as computing it for one State at a time.
+        const auto& system = parallelModel->getMultibodySystem();
+        std::vector<SimTK::State> states;
+        std::vector<double> energies;
+        for (double depth : {0.002, 0.01, 0.03}) {
+            states.push_back(parallelState);
+            setState(otherType, depth, states.back());
+            system.realize(states.back(), SimTK::Stage::Position);
+            energies.push_back(system.calcPotentialEnergy(states.back()));
+        }
+        const int numStates = (int)states.size();
+        std::vector<double> concurrentEnergies(10 * numStates);
+        executeInParallel((int)concurrentEnergies.size(), numStates,
+                [&](int i, int) {
+                    concurrentEnergies[i] =
+                            system.calcPotentialEnergy(states[i % numStates]);
+                });
+        for (int i = 0; i < (int)concurrentEnergies.size(); ++i) {
+            const double expectedEnergy = energies[i % numStates];
+            ASSERT_EQUAL(expectedEnergy, concurrentEnergies[i],
+                    1e-10 * expectedEnergy, __FILE__, __LINE__,
+                    "Concurrent BVH contact energy FAILED to match serial.");
+        }
+
+        // Benchmark: compute the forces repeatedly at the deepest
+        // penetration, invalidating the positions each time.
+        auto timeForces = [&](const Model& model, SimTK::State& state)
+                -> std::string {
+            Stopwatch watch;
+            for (int i = 0; i < numEvaluations; ++i) {
+                state.updQ();
+                model.realizeDynamics(state);
+            }
+            return watch.formatNs(watch.getElapsedTimeInNs() / numEvaluations);
+        };
+        cout << "    time per force evaluation:"
+             << " Simbody " << timeForces(*simbodyModel, simbodyState)
+             << "; BVH " << timeForces(*bvhModel, bvhState)
+             << "; BVH (4 threads) "
+             << timeForces(*parallelModel, parallelState) << endl;
+    }
+}
@@ -0,0 +1,129 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  testEnsembleSimulator.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch.hpp>
+#include <OpenSim/Common/Reporter.h>
+#include <OpenSim/Simulation/Manager/EnsembleSimulator.h>
+#include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
+
+using namespace OpenSim;
+
+namespace {
+Model createPendulum() {
+    Model model;
+    model.setName("pendulum");
+    auto* body = new Body("body", 1.0, SimTK::Vec3(0), SimTK::Inertia(1));
+    model.addBody(body);
+    auto* joint = new PinJoint("pin", model.getGround(), SimTK::Vec3(0),
+            SimTK::Vec3(0), *body, SimTK::Vec3(0, 1, 0), SimTK::Vec3(0));
+    joint->updCoordinate().setName("q");
+    model.addJoint(joint);
+
+    auto* reporter = new TableReporter();
+    reporter->setName("reporter");
+    reporter->set_report_time_interval(0.1);
+    reporter->addToReport(joint->getCoordinate().getOutput("value"));
+    model.addComponent(reporter);
+    model.finalizeConnections();
+    return model;
+}
+
+void perturbInitialAngle(int run, const Model& model, SimTK::State& state) {
+    model.getCoordinateSet().get("q").setValue(state, 0.05 * run);
+}
+
+SimTK::Vector finalAngle(int, const Model& model, const SimTK::State& state) {
+    return SimTK::Vector(1, model.getCoordinateSet().get("q").getValue(state));
+}
+}
+
+TEST_CASE("EnsembleSimulator results do not depend on the number of threads") {
+    const int numRuns = 7;
+    std::vector<std::vector<EnsembleRunResult>> resultsPerNumThreads;
+    for (int numThreads : {1, 3}) {
+        EnsembleSimulator ensemble(createPendulum());
+        ensemble.setNumThreads(numThreads);
+        ensemble.setFinalTime(0.5);
+        ensemble.setIntegratorAccuracy(1e-8);
+        ensemble.setStatePerturbation(perturbInitialAngle);
+        ensemble.setSummaryFunction(finalAngle);
+        resultsPerNumThreads.push_back(ensemble.run(numRuns));
+    }
+
+    const auto& serial = resultsPerNumThreads[0];
+    const auto& parallel = resultsPerNumThreads[1];
+    REQUIRE(serial.size() == numRuns);
+    REQUIRE(parallel.size() == numRuns);
+    for (int irun = 0; irun < numRuns; ++irun) {
+        INFO("run " << irun);
+        REQUIRE(serial[irun].success);
+        REQUIRE(parallel[irun].success);
+        CHECK(serial[irun].runIndex == irun);
+        CHECK(serial[irun].finalState.getTime() == Approx(0.5));
+        REQUIRE(serial[irun].summary.size() == 1);
+        CHECK(serial[irun].summary[0] == parallel[irun].summary[0]);
+
+        // Each worker performs several runs, which would fail if the reporter
+        // were not cleared between runs.
+        const auto& table = serial[irun].reporterTables.at("/reporter");
+        const auto& tableParallel =
+                parallel[irun].reporterTables.at("/reporter");
+        CHECK(table.getNumRows() >= 5);
+        CHECK(table.getIndependentColumn() ==
+                tableParallel.getIndependentColumn());
+        CHECK(serial[irun].states.getNumRows() == 0);
+    }
+    // The pendulum starting at rest at the bottom stays there.
+    CHECK(serial[0].summary[0] == Approx(0).margin(1e-10));
+    CHECK(serial[1].summary[0] != Approx(0.05));
+}
+
+TEST_CASE("EnsembleSimulator property perturbations and errors") {
+    EnsembleSimulator ensemble(createPendulum());
+    ensemble.setNumThreads(2);
+    ensemble.setFinalTime(0.5);
+    ensemble.setRecordStates(true);
+    ensemble.setStatePerturbation(
+            [](int, const Model& model, SimTK::State& state) {
+        perturbInitialAngle(1, model, state);
+    });
+    // Without gravity, the pendulum does not move.
+    ensemble.setPropertyPerturbation([](int run, Model& model) {
+        if (run == 3) OPENSIM_THROW(Exception, "Invalid run.");
+        model.setGravity(SimTK::Vec3(0, run % 2 ? -9.81 : 0, 0));
+    });
+    ensemble.setSummaryFunction(finalAngle);
+    const auto results = ensemble.run(4);
+
+    CHECK(results[0].success);
+    CHECK(results[1].success);
+    CHECK(results[2].success);
+    CHECK_FALSE(results[3].success);
+    CHECK_THAT(results[3].errorMessage, Catch::Contains("Invalid run."));
+    CHECK(results[0].summary[0] == Approx(0.05));
+    CHECK(results[2].summary[0] == Approx(0.05));
+    CHECK(results[1].summary[0] != Approx(0.05));
+    CHECK(results[0].states.getNumRows() > 1);
+
+    CHECK_THROWS_AS(ensemble.run(-1), Exception);
+}
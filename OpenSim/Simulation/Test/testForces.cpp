@@ -74,6 +74,8 @@ void testSerializeDeserialize();
 void testTranslationalDampingEffect(Model& osimModel, Coordinate& sliderCoord,
         double start_h, Component& componentWithDamping);
 void testBlankevoort1991Ligament();
+void testParallelPathForces();
+void testParallelPathForcesSharingWrapObject();
 
 int main() {
     SimTK::Array_<std::string> failures;
@@ -174,6 +176,18 @@ int main() {
         failures.push_back("testBlankevoort1991Ligament");
     }
 
+    try { testParallelPathForces(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testParallelPathForces");
+    }
+
+    try { testParallelPathForcesSharingWrapObject(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testParallelPathForcesSharingWrapObject");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -284,6 +298,11 @@ void testExpressionBasedCoordinateForce() {
 
     osimModel.print("ExpressionBasedCoordinateForceModel.osim");
 
+    // Unknown variables are reported when the model is connected, rather than
+    // when the force is first computed.
+    spring.setExpression("-10*q-5*x");
+    ASSERT_THROW(OpenSim::Exception, osimModel.initSystem());
+
     osimModel.disownAllComponents();
 }
 
@@ -2382,3 +2401,146 @@ void testBlankevoort1991Ligament() {
         "reference state be equal to the strain value input "
         "to setSlackLengthFromReferenceStrain().");
 }
+
+// Computing the forces along paths on several threads must give the same
+// dynamics as computing them one at a time.
+void testParallelPathForces() {
+    using namespace SimTK;
+
+    Model serialModel("arm26.osim");
+    Model parallelModel("arm26.osim");
+    parallelModel.setNumForceThreads(3);
+    ASSERT(serialModel.getNumForceThreads() == 1);
+    ASSERT(parallelModel.getNumForceThreads() == 3);
+
+    State& serialState = serialModel.initSystem();
+    State& parallelState = parallelModel.initSystem();
+
+    const auto& serialMuscles = serialModel.getMuscles();
+    const auto& parallelMuscles = parallelModel.getMuscles();
+    ASSERT(serialMuscles.getSize() > 1);
+    for (int i = 0; i < serialMuscles.getSize(); ++i) {
+        ASSERT(!serialModel.isForceComputedInParallel(serialMuscles[i]));
+        ASSERT(parallelModel.isForceComputedInParallel(parallelMuscles[i]));
+        serialMuscles[i].setActivation(serialState, 0.1 + 0.1*i);
+        parallelMuscles[i].setActivation(parallelState, 0.1 + 0.1*i);
+    }
+    const Coordinate& serialElbow =
+            serialModel.getCoordinateSet().get("r_elbow_flex");
+    const Coordinate& parallelElbow =
+            parallelModel.getCoordinateSet().get("r_elbow_flex");
+    serialElbow.setValue(serialState, 1.0);
+    serialElbow.setSpeedValue(serialState, 0.5);
+    parallelElbow.setValue(parallelState, 1.0);
+    parallelElbow.setSpeedValue(parallelState, 0.5);
+
+    auto compareAccelerations = [&]() {
+        serialModel.realizeAcceleration(serialState);
+        parallelModel.realizeAcceleration(parallelState);
+        ASSERT((serialState.getUDot() - parallelState.getUDot()).normInf()
+                < 1e-10, __FILE__, __LINE__,
+                "Parallel force evaluation changed the accelerations.");
+    };
+    compareAccelerations();
+
+    // Disabled forces must still be skipped.
+    serialMuscles[0].setAppliesForce(serialState, false);
+    parallelMuscles[0].setAppliesForce(parallelState, false);
+    compareAccelerations();
+    serialMuscles[0].setAppliesForce(serialState, true);
+    parallelMuscles[0].setAppliesForce(parallelState, true);
+
+    // The same forward simulation.
+    Manager serialManager(serialModel);
+    serialManager.initialize(serialState);
+    const State& serialFinal = serialManager.integrate(0.1);
+    Manager parallelManager(parallelModel);
+    parallelManager.initialize(parallelState);
+    const State& parallelFinal = parallelManager.integrate(0.1);
+    ASSERT((serialFinal.getY() - parallelFinal.getY()).normInf() < 1e-6,
+            __FILE__, __LINE__,
+            "Parallel force evaluation changed the simulation.");
+}
+
+// Many paths that wrap over the same WrapEllipsoid and share the same Frames,
+// computed on several threads: the paths and accelerations must match those
+// computed one at a time, in every one of many configurations.
+void testParallelPathForcesSharingWrapObject() {
+    using namespace SimTK;
+
+    const int numActuators = 32;
+    auto buildModel = [](int numForceThreads) -> Model* {
+        Model* model = new Model();
+        model->setName("shared_wrap");
+        Ground& ground = model->updGround();
+
+        OpenSim::Body* arm = new OpenSim::Body("arm", 1.0, Vec3(0.2, 0, 0),
+                Inertia::brick(0.2, 0.02, 0.02));
+        PinJoint* pin = new PinJoint("pin", ground, *arm);
+        model->addBody(arm);
+        model->addJoint(pin);
+
+        WrapEllipsoid* ellipsoid = new WrapEllipsoid();
+        ellipsoid->setName("ellipsoid");
+        ellipsoid->set_dimensions(Vec3(0.05, 0.06, 0.07));
+        ground.addWrapObject(ellipsoid);
+
+        PrescribedController* controller = new PrescribedController();
+        for (int i = 0; i < numActuators; ++i) {
+            const std::string name = "actuator" + std::to_string(i);
+            PathActuator* actuator = new PathActuator();
+            actuator->setName(name);
+            actuator->setOptimalForce(10.0 + i);
+            const double z = 0.003 * (i - numActuators / 2);
+            actuator->addNewPathPoint("origin", ground, Vec3(-0.3, 0, z));
+            actuator->addNewPathPoint("insertion", *arm, Vec3(0.3, 0, -z));
+            actuator->updGeometryPath().addPathWrap(*ellipsoid);
+            model->addForce(actuator);
+            controller->addActuator(*actuator);
+            controller->prescribeControlForActuator(name,
+                    new Constant(0.5 + 0.01 * i));
+        }
+        model->addController(controller);
+        model->setNumForceThreads(numForceThreads);
+        return model;
+    };
+
+    std::unique_ptr<Model> serialModel(buildModel(1));
+    std::unique_ptr<Model> parallelModel(buildModel(4));
+    State& serialState = serialModel->initSystem();
+    State& parallelState = parallelModel->initSystem();
+    const auto serialPaths = serialModel->getComponentList<GeometryPath>();
+    const Coordinate& serialAngle = serialModel->getCoordinateSet()[0];
+    const Coordinate& parallelAngle = parallelModel->getCoordinateSet()[0];
+
+    int numWrapped = 0;
+    Random::Uniform random(-0.3, 0.3);
+    random.setSeed(0);
+    for (int k = 0; k < 200; ++k) {
+        const double angle = random.getValue();
+        const double speed = 10 * random.getValue();
+        serialAngle.setValue(serialState, angle);
+        serialAngle.setSpeedValue(serialState, speed);
+        parallelAngle.setValue(parallelState, angle);
+        parallelAngle.setSpeedValue(parallelState, speed);
+        serialModel->realizeAcceleration(serialState);
+        parallelModel->realizeAcceleration(parallelState);
+
+        ASSERT((serialState.getUDot() - parallelState.getUDot()).normInf()
+                < 1e-10, __FILE__, __LINE__,
+                "Parallel force evaluation changed the accelerations.");
+        for (const auto& serialPath : serialPaths) {
+            const auto& parallelPath = parallelModel->getComponent<
+                    GeometryPath>(serialPath.getAbsolutePathString());
+            ASSERT_EQUAL(serialPath.getLength(serialState),
+                    parallelPath.getLength(parallelState), 1e-12,
+                    __FILE__, __LINE__,
+                    "Parallel force evaluation changed a path.");
+            if (parallelPath.getCurrentPath(parallelState).getSize() > 2)
+                ++numWrapped;
+        }
+    }
+    // Make sure the paths actually wrapped over the shared ellipsoid.
+    ASSERT(numWrapped > 0, __FILE__, __LINE__,
+            "Expected the paths to wrap over the ellipsoid.");
+}
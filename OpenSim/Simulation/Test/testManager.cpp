@@ -37,6 +37,8 @@ Manager Tests:
 4. testConstructors: Ensure different constructors work as intended.
 5. testIntegratorInterface: Ensure setting integrator options works as intended.
 6. testExceptions: Test that misuse actually triggers exceptions.
+7. testRecordingStates: Record a subset of the steps or state variables, and
+   write the states to a file.
 
 //=============================================================================*/
 #include <OpenSim/Simulation/Model/Model.h>
@@ -47,6 +49,10 @@ Manager Tests:
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 #include <OpenSim/Simulation/Control/PrescribedController.h>
 #include <OpenSim/Common/Constant.h>
+#include <OpenSim/Common/CommonUtilities.h>
+
+#include <algorithm>
+#include <functional>
 
 using namespace OpenSim;
 using namespace std;
@@ -56,6 +62,7 @@ void testExcitationUpdatesWithManager();
 void testConstructors();
 void testIntegratorInterface();
 void testExceptions();
+void testRecordingStates();
 
 int main()
 {
@@ -97,6 +104,12 @@ int main()
         failures.push_back("testExceptions");
     }
 
+    try { testRecordingStates(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testRecordingStates");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -478,3 +491,112 @@ void testExceptions()
     manager.setIntegratorAccuracy(1e-4);
     manager.setIntegratorMinimumStepSize(0.01);
 }
+
+void testRecordingStates()
+{
+    cout << "Running testRecordingStates" << endl;
+
+    using SimTK::Vec3;
+
+    Model model;
+    model.setGravity(Vec3(0, -9.81, 0));
+    auto ball = new Body("ball", 1., Vec3(0), SimTK::Inertia::sphere(1.));
+    model.addBody(ball);
+    auto freeJoint = new FreeJoint("freeJoint", model.getGround(), *ball);
+    model.addJoint(freeJoint);
+    SimTK::State state = model.initSystem();
+    const int numStates = model.getNumStateVariables();
+
+    const double finalTime = 1.0;
+    auto simulate = [&](const std::function<void(Manager&)>& configure)
+            -> TimeSeriesTable {
+        Manager manager(model);
+        manager.setIntegratorMaximumStepSize(0.01);
+        configure(manager);
+        state.setTime(0);
+        manager.initialize(state);
+        // Integrate twice, to check that no duplicates are recorded.
+        manager.integrate(0.5 * finalTime);
+        manager.integrate(finalTime);
+        return manager.getStatesTable();
+    };
+
+    // Every step.
+    const TimeSeriesTable all = simulate([](Manager&) {});
+    const auto& allTimes = all.getIndependentColumn();
+    ASSERT(all.getNumColumns() == (size_t)numStates);
+    ASSERT(all.getNumRows() > 100);
+
+    // Every third step, plus the initial and final states of each integrate().
+    {
+        const TimeSeriesTable table = simulate(
+                [](Manager& manager) { manager.setRecordEveryNSteps(3); });
+        const auto& times = table.getIndependentColumn();
+        ASSERT(table.getNumRows() < all.getNumRows() / 3 + 4);
+        ASSERT(times.front() == 0);
+        ASSERT_EQUAL(finalTime, times.back(), 1e-10);
+        for (size_t i = 0; i < table.getNumRows(); ++i) {
+            ASSERT(std::find(allTimes.begin(), allTimes.end(), times[i]) !=
+                   allTimes.end());
+        }
+    }
+
+    // A minimum interval.
+    {
+        const double interval = 0.1;
+        const TimeSeriesTable table = simulate([interval](Manager& manager) {
+                manager.setRecordInterval(interval); });
+        const auto& times = table.getIndependentColumn();
+        ASSERT(table.getNumRows() <= 13);
+        // Apart from the initial and final states of each integrate().
+        for (size_t i = 1; i < times.size(); ++i) {
+            if (times[i] != 0.5 * finalTime && times[i] != finalTime)
+                ASSERT(times[i] - times[i - 1] >= interval * (1 - 1e-6));
+        }
+    }
+
+    // A subset of the state variables.
+    {
+        const TimeSeriesTable table = simulate([](Manager& manager) {
+                manager.setRecordStatesMatching(".*/value"); });
+        ASSERT(table.getNumColumns() == 6);
+        ASSERT(table.getNumRows() == all.getNumRows());
+        for (const auto& label : table.getColumnLabels()) {
+            ASSERT(label.substr(label.size() - 6) == "/value");
+            const auto& column = table.getDependentColumn(label);
+            const auto& expected = all.getDependentColumn(label);
+            for (int i = 0; i < column.size(); ++i)
+                ASSERT(column[i] == expected[i]);
+        }
+    }
+    ASSERT_THROW(Exception, simulate([](Manager& manager) {
+            manager.setRecordStatesMatching("("); }));
+
+    // Writing to a file.
+    {
+        const std::string fileName = "testManager_recordedStates.sto";
+        FileRemover fileRemover(fileName);
+        const TimeSeriesTable table = simulate([&](Manager& manager) {
+                manager.setRecordStatesToFile(fileName); });
+        ASSERT(table.getNumRows() == 0);
+        const TimeSeriesTable fromFile(fileName);
+        ASSERT(fromFile.getColumnLabels() == all.getColumnLabels());
+        ASSERT(fromFile.getNumRows() == all.getNumRows());
+        for (size_t i = 0; i < all.getNumRows(); ++i) {
+            ASSERT_EQUAL(allTimes[i], fromFile.getIndependentColumn()[i],
+                    1e-12);
+            const auto rowAll = all.getRowAtIndex(i);
+            const auto rowFile = fromFile.getRowAtIndex(i);
+            for (int j = 0; j < numStates; ++j)
+                ASSERT_EQUAL(rowAll[j], rowFile[j], 1e-12);
+        }
+    }
+
+    // Settings cannot change once integration started.
+    Manager manager(model);
+    state.setTime(0);
+    manager.initialize(state);
+    manager.integrate(0.1);
+    ASSERT_THROW(Exception, manager.setRecordEveryNSteps(2));
+    ASSERT_THROW(Exception, manager.setRecordStatesToFile("states.sto"));
+}
@@ -56,6 +56,10 @@ void testMomentArmDefinitionForModel(const string &filename,
 
 void testMomentArmsAcrossCompoundJoint();
 
+void testPolynomialPathApproximation();
+
+void testMomentArmMatrix(const string& filename);
+
 int main()
 {
     clock_t startTime = clock();
@@ -67,6 +71,9 @@ int main()
         testMomentArmsAcrossCompoundJoint();
         cout << "Joint composed of more than one mobilized body: PASSED\n" << endl;
 
+        testPolynomialPathApproximation();
+        cout << "Polynomial approximation of a path: PASSED\n" << endl;
+
         testMomentArmDefinitionForModel("BothLegs22.osim", "r_knee_angle", "VASINT", 
             SimTK::Vec2(-2*SimTK::Pi/3, SimTK::Pi/18), 0.0, 
             "VASINT of BothLegs with no mass: FAILED");
@@ -128,6 +135,10 @@ int main()
 
         testMomentArmDefinitionForModel("CoupledCoordinatesMPPsMomentArmTest.osim", "foot_angle", "vas_int_r", SimTK::Vec2(-2*SimTK::Pi/3, SimTK::Pi/18), -1.0, "Multiple moving path points: FAILED");
         cout << "Multiple moving path points coupled coordinates test: PASSED\n" << endl;
+
+        testMomentArmMatrix("testMomentArmsConstraintB.osim");
+        testMomentArmMatrix("CoupledCoordinatesMPPsMomentArmTest.osim");
+        cout << "Moment-arm matrix of all muscles and coordinates: PASSED\n" << endl;
     }
     catch (const Exception& e) {
         e.print(cerr);
@@ -166,6 +177,81 @@ void testMomentArmsAcrossCompoundJoint()
         0.0, "testMomentArmsAcrossCompoundJoint: FAILED");
 }
 
+void testPolynomialPathApproximation()
+{
+    Model geometricModel("arm26.osim");
+    SimTK::State& sg = geometricModel.initSystem();
+
+    Model model("arm26.osim");
+    const SimTK::State& state = model.initSystem();
+    GeometryPath& path =
+            model.updComponent<PathActuator>("/forceset/BIClong")
+                    .updGeometryPath();
+    SimTK::Vec4 errors = path.fitPolynomialApproximation(state, 5);
+    ASSERT(errors[1] < 1e-3, __FILE__, __LINE__,
+        "Polynomial fit of the BIClong length is inaccurate.");
+    ASSERT(errors[3] < 5e-3, __FILE__, __LINE__,
+        "Polynomial fit of the BIClong moment arms is inaccurate.");
+    ASSERT(path.getProperty_polynomial_coordinates().size() == 2,
+        __FILE__, __LINE__, "Expected BIClong to span 2 coordinates.");
+
+    // The approximation must survive serialization.
+    model.print("testPolynomialPathApproximation.osim");
+    Model approxModel("testPolynomialPathApproximation.osim");
+    SimTK::State& s = approxModel.initSystem();
+    const GeometryPath& approxPath =
+            approxModel.getComponent<PathActuator>("/forceset/BIClong")
+                    .getGeometryPath();
+    const GeometryPath& geometricPath =
+            geometricModel.getComponent<PathActuator>("/forceset/BIClong")
+                    .getGeometryPath();
+    ASSERT(approxPath.isUsingPolynomialApproximation(), __FILE__, __LINE__,
+        "Expected the deserialized path to use the polynomial.");
+    ASSERT(!geometricPath.isUsingPolynomialApproximation(), __FILE__,
+        __LINE__, "Expected the original path to be geometric.");
+
+    const Coordinate& shoulder =
+            approxModel.getCoordinateSet().get("r_shoulder_elev");
+    const Coordinate& elbow = approxModel.getCoordinateSet().get("r_elbow_flex");
+    const Coordinate& gShoulder =
+            geometricModel.getCoordinateSet().get("r_shoulder_elev");
+    const Coordinate& gElbow =
+            geometricModel.getCoordinateSet().get("r_elbow_flex");
+    for (int i = 0; i < 5; ++i) {
+        const double q0 = -0.5 + 0.4 * i;
+        const double q1 = 0.1 + 0.5 * i;
+        shoulder.setValue(s, q0, false);
+        elbow.setValue(s, q1, false);
+        shoulder.setSpeedValue(s, 0.3);
+        elbow.setSpeedValue(s, -0.7);
+        gShoulder.setValue(sg, q0, false);
+        gElbow.setValue(sg, q1, false);
+        gShoulder.setSpeedValue(sg, 0.3);
+        gElbow.setSpeedValue(sg, -0.7);
+        approxModel.realizeVelocity(s);
+        geometricModel.realizeVelocity(sg);
+
+        ASSERT_EQUAL(geometricPath.getLength(sg), approxPath.getLength(s),
+            2e-3, __FILE__, __LINE__, "Approximated length is inaccurate.");
+        ASSERT_EQUAL(geometricPath.getLengtheningSpeed(sg),
+            approxPath.getLengtheningSpeed(s), 1e-2, __FILE__, __LINE__,
+            "Approximated lengthening speed is inaccurate.");
+        ASSERT_EQUAL(geometricPath.computeMomentArm(sg, gShoulder),
+            approxPath.computeMomentArm(s, shoulder), 5e-3, __FILE__,
+            __LINE__, "Approximated shoulder moment arm is inaccurate.");
+        ASSERT_EQUAL(geometricPath.computeMomentArm(sg, gElbow),
+            approxPath.computeMomentArm(s, elbow), 5e-3, __FILE__, __LINE__,
+            "Approximated elbow moment arm is inaccurate.");
+
+        // The lengthening speed must be consistent with the moment arms.
+        const double speed = -approxPath.computeMomentArm(s, shoulder) * 0.3
+                + approxPath.computeMomentArm(s, elbow) * 0.7;
+        ASSERT_EQUAL(speed, approxPath.getLengtheningSpeed(s), 1e-10,
+            __FILE__, __LINE__,
+            "Lengthening speed is inconsistent with the moment arms.");
+    }
+}
+
 //==========================================================================================================
 // moment_arm = dl/dtheta, definition using inexact perturbation technique
 //==========================================================================================================
@@ -442,3 +528,44 @@ void testMomentArmDefinitionForModel(const string &filename, const string &coord
     // dL/dTheta definition or is at least dynamically consistent, in which dL/dTheta is not
     ASSERT(passesDefinition || passesDynamicConsistency, __FILE__, __LINE__, errorMessage);
 }
+
+// The moment-arms of all muscles about all coordinates computed at once must
+// match those computed one pair at a time.
+void testMomentArmMatrix(const string& filename)
+{
+    Model model(filename);
+    SimTK::State& s = model.initSystem();
+    MomentArmSolver maSolver(model);
+
+    std::vector<const Coordinate*> coordinates;
+    for (const auto& coord : model.getComponentList<Coordinate>()) {
+        coordinates.push_back(&coord);
+    }
+    std::vector<const GeometryPath*> paths;
+    for (const auto& muscle : model.getComponentList<Muscle>()) {
+        paths.push_back(&muscle.getGeometryPath());
+    }
+
+    for (int k = 0; k < 5; ++k) {
+        for (const auto* coord : coordinates) {
+            if (coord->getLocked(s)) continue;
+            coord->setValue(s, coord->getRangeMin() + 0.2 * k *
+                    (coord->getRangeMax() - coord->getRangeMin()), false);
+        }
+        model.assemble(s);
+        model.realizePosition(s);
+
+        const SimTK::Matrix momentArms = maSolver.solve(s, coordinates, paths);
+        ASSERT_EQUAL((int)paths.size(), momentArms.nrow());
+        ASSERT_EQUAL((int)coordinates.size(), momentArms.ncol());
+        for (int i = 0; i < (int)paths.size(); ++i) {
+            for (int j = 0; j < (int)coordinates.size(); ++j) {
+                ASSERT_EQUAL(maSolver.solve(s, *coordinates[j], *paths[i]),
+                        momentArms(i, j), 1e-10, __FILE__, __LINE__,
+                        "Moment-arm matrix of " + filename + " differs from "
+                        "moment-arm of " + paths[i]->getAbsolutePathString() +
+                        " about " + coordinates[j]->getName() + ".");
+            }
+        }
+    }
+}
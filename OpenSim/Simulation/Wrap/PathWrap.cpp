@@ -136,20 +136,30 @@ void PathWrap::setEndPoint( const SimTK::State& s, int aIndex)
     }
 }
 
-void PathWrap::resetPreviousWrap()
+namespace {
+void resetWrapResult(WrapResult& wrapResult)
 {
-    _previousWrap.startPoint = -1;
-    _previousWrap.endPoint = -1;
+    wrapResult.startPoint = -1;
+    wrapResult.endPoint = -1;
 
-    _previousWrap.wrap_pts.setSize(0);
-    _previousWrap.wrap_path_length = 0.0;
+    wrapResult.wrap_pts.setSize(0);
+    wrapResult.wrap_path_length = 0.0;
 
     int i;
     for (i = 0; i < 3; i++) {
-        _previousWrap.r1[i] = -std::numeric_limits<SimTK::Real>::infinity();
-        _previousWrap.r2[i] = -std::numeric_limits<SimTK::Real>::infinity();
-        _previousWrap.sv[i] = -std::numeric_limits<SimTK::Real>::infinity();
+        wrapResult.r1[i] = -std::numeric_limits<SimTK::Real>::infinity();
+        wrapResult.r2[i] = -std::numeric_limits<SimTK::Real>::infinity();
+        wrapResult.sv[i] = -std::numeric_limits<SimTK::Real>::infinity();
     }
+    wrapResult.p1 = SimTK::Vec3(SimTK::NaN);
+    wrapResult.p2 = SimTK::Vec3(SimTK::NaN);
+    wrapResult.q = SimTK::Vec2(SimTK::NaN);
+}
+}
+
+void PathWrap::resetPreviousWrap()
+{
+    resetWrapResult(_previousWrap);
 }
 
 void PathWrap::setPreviousWrap(const WrapResult& aWrapResult)
@@ -157,6 +167,43 @@ void PathWrap::setPreviousWrap(const WrapResult& aWrapResult)
     _previousWrap = aWrapResult;
 }
 
+void PathWrap::extendAddToSystem(SimTK::MultibodySystem& system) const
+{
+    Super::extendAddToSystem(system);
+
+    // Like the color of a GeometryPath, this cache entry is valid any time
+    // after it has been created and first marked valid, and is never
+    // invalidated: it holds the last wrap calculated in each State.
+    WrapResult noWrap;
+    resetWrapResult(noWrap);
+    _warmStartWrapCV = addCacheVariable("warm_start_wrap", noWrap,
+            SimTK::Stage::Topology);
+}
+
+void PathWrap::extendInitStateFromProperties(SimTK::State& s) const
+{
+    Super::extendInitStateFromProperties(s);
+    resetWarmStartWrap(s);
+}
+
+const WrapResult& PathWrap::getWarmStartWrap(const SimTK::State& s) const
+{
+    return getCacheVariableValue(s, _warmStartWrapCV);
+}
+
+void PathWrap::setWarmStartWrap(const SimTK::State& s,
+        const WrapResult& aWrapResult) const
+{
+    setCacheVariableValue(s, _warmStartWrapCV, aWrapResult);
+}
+
+void PathWrap::resetWarmStartWrap(const SimTK::State& s) const
+{
+    WrapResult& wrapResult = updCacheVariableValue(s, _warmStartWrapCV);
+    resetWrapResult(wrapResult);
+    markCacheVariableValid(s, _warmStartWrapCV);
+}
+
 void PathWrap::setWrapObject(WrapObject& aWrapObject)
 {
     _wrapObject = &aWrapObject;
@@ -116,9 +116,21 @@ public:
     void setPreviousWrap(const WrapResult& aWrapResult);
     void resetPreviousWrap();
 
+#ifndef SWIG
+    /** The wrap most recently calculated for this path in the given State,
+    from which WrapEllipsoid and WrapTorus can warm start their search. Unlike
+    the previous wrap, this depends only on the State. */
+    const WrapResult& getWarmStartWrap(const SimTK::State& s) const;
+    void setWarmStartWrap(const SimTK::State& s,
+            const WrapResult& aWrapResult) const;
+    void resetWarmStartWrap(const SimTK::State& s) const;
+#endif
+
 private:
     void constructProperties();
     void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    void extendInitStateFromProperties(SimTK::State& s) const override;
     void setNull();
 
 private:
@@ -128,6 +140,7 @@ private:
     const GeometryPath* _path;
 
     WrapResult _previousWrap;  // results from previous wrapping
+    mutable CacheVariable<WrapResult> _warmStartWrapCV;
 
     MemberSubcomponentIndex _wrapPoint1Ix{
         constructSubcomponent<PathWrapPoint>("pwpt1") };
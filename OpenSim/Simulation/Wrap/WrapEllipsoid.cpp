@@ -48,6 +48,7 @@ static const char* wrapTypeName = "ellipsoid";
 #define NUM_DISPLAY_SAMPLES   30
 #define N_STEPS               16
 #define SV_BOUNDARY_BLEND     0.3
+#define WARM_START_MAX_CHANGE 0.1      // largest move of the normalized path points for a warm start
 
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
@@ -83,6 +84,7 @@ void WrapEllipsoid::constructProperties()
 
     SimTK::Vec3 defaultDimensions = {0.05, 0.05, 0.05};
     constructProperty_dimensions(defaultDimensions);
+    constructProperty_warm_start(false);
 }
 
 //_____________________________________________________________________________
@@ -230,6 +232,37 @@ int WrapEllipsoid::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::
         a[i]  = get_dimensions()[i] * aWrapResult.factor;
     }
 
+    // With warm_start, the search for the tangent points can start from
+    // the last wrap of this path in this State, if it is a wrap of the same
+    // path segment.
+    const WrapResult& warmStartWrap = aPathWrap.getWarmStartWrap(s);
+    bool warmStart = false;
+    if (get_warm_start() && warmStartWrap.wrap_pts.getSize() > 0 &&
+        warmStartWrap.startPoint == aWrapResult.startPoint &&
+        warmStartWrap.endPoint == aWrapResult.endPoint)
+    {
+        if (warmStartWrap.p1 == aPoint1 && warmStartWrap.p2 == aPoint2)
+        {
+            // The path points have not moved, so the last wrap is still the
+            // solution. wrapPathSegment() converted its points to the
+            // frame of the wrap object's body; convert them back.
+            aWrapResult.r1 = _pose.shiftBaseStationToFrame(warmStartWrap.r1);
+            aWrapResult.r2 = _pose.shiftBaseStationToFrame(warmStartWrap.r2);
+            aWrapResult.wrap_pts = warmStartWrap.wrap_pts;
+            for (i = 0; i < aWrapResult.wrap_pts.getSize(); i++)
+                aWrapResult.wrap_pts.updElt(i) = _pose.shiftBaseStationToFrame(aWrapResult.wrap_pts.get(i));
+            aWrapResult.wrap_path_length = warmStartWrap.wrap_path_length;
+            aWrapResult.p1 = aPoint1;
+            aWrapResult.p2 = aPoint2;
+
+            recordWrap(true, 0);
+            return mandatoryWrap;
+        }
+
+        warmStart = (aPoint1 - warmStartWrap.p1).norm() * aWrapResult.factor < WARM_START_MAX_CHANGE &&
+                    (aPoint2 - warmStartWrap.p2).norm() * aWrapResult.factor < WARM_START_MAX_CHANGE;
+    }
+
     p1e = -1.0;
     p2e = -1.0;
 
@@ -538,9 +571,34 @@ int WrapEllipsoid::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::
 
     vs4 = - Mtx::DotProduct(3, vs, aWrapResult.c1);
 
+    int numIterations = 0;
+    bool warmStarted = false;
+
+    if (warmStart)
+    {
+        // Start from the tangent points of the last wrap. Fall back to
+        // the usual search if this search does not converge, or if it finds
+        // a tangent point on the other side of the muscle line from c1.
+        SimTK::Vec3 wr1 = _pose.shiftBaseStationToFrame(warmStartWrap.r1) * aWrapResult.factor;
+        SimTK::Vec3 wr2 = _pose.shiftBaseStationToFrame(warmStartWrap.r2) * aWrapResult.factor;
+
+        if (calcTangentPoint(p1e, wr1, p1, m, a, vs, vs4, numIterations) &&
+            calcTangentPoint(p2e, wr2, p2, m, a, vs, vs4, numIterations) &&
+            ~((p1 - p2) % (p1 - wr1)) * vs >= 0.0 &&
+            ~((p1 - p2) % (p1 - wr2)) * vs >= 0.0)
+        {
+            aWrapResult.r1 = wr1;
+            aWrapResult.r2 = wr2;
+            warmStarted = true;
+        }
+    }
+
     // find r1 & r2 by starting at c1 moving toward p1 & p2
-    calcTangentPoint(p1e, aWrapResult.r1, p1, m, a, vs, vs4);
-    calcTangentPoint(p2e, aWrapResult.r2, p2, m, a, vs, vs4);
+    if (!warmStarted)
+    {
+        calcTangentPoint(p1e, aWrapResult.r1, p1, m, a, vs, vs4, numIterations);
+        calcTangentPoint(p2e, aWrapResult.r2, p2, m, a, vs, vs4, numIterations);
+    }
 
     // create a series of line segments connecting r1 & r2 along the
     // surface of the ellipsoid.
@@ -592,6 +650,10 @@ calc_wrap_path:
         aWrapResult.r2[i] /= aWrapResult.factor;
     }
 
+    aWrapResult.p1 = aPoint1;
+    aWrapResult.p2 = aPoint2;
+    recordWrap(warmStarted, numIterations);
+
     return mandatoryWrap;
 }
 
@@ -609,10 +671,12 @@ calc_wrap_path:
  * @param a Ellipsoid axis
  * @param vs Plane vector
  * @param vs4 Plane coefficient
- * @return '1' if the point was adjusted, '0' otherwise
+ * @param numIterations Incremented by the number of iterations of the search
+ * @return '1' if the search converged, '0' otherwise
  */
 int WrapEllipsoid::calcTangentPoint(double p1e, SimTK::Vec3& r1, SimTK::Vec3& p1, SimTK::Vec3& m,
-                                                SimTK::Vec3& a, SimTK::Vec3& vs, double vs4) const
+                                                SimTK::Vec3& a, SimTK::Vec3& vs, double vs4,
+                                                int& numIterations) const
 {
     int i, j, k, nit, nit2, maxit=50, maxit2=1000;
     Vec3 nr1, p1r1, p1m;
@@ -793,6 +857,13 @@ int WrapEllipsoid::calcTangentPoint(double p1e, SimTK::Vec3& r1, SimTK::Vec3& p1
             ssq = SQR(ee[0]) + SQR(ee[1]) + SQR(ee[2]) + SQR(ee[3]);
             ssqo = ssq;     
         }
+
+        numIterations += nit;
+
+        // The search did not converge within maxit iterations; r1 holds its
+        // last iterate.
+        if (ssq > ELLIPSOID_TINY)
+            return 0;
     }   
     return 1;
 
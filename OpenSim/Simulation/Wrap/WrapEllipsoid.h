@@ -37,6 +37,18 @@ class WrapResult;
 /**
  * A class implementing an ellipsoid for muscle wrapping.
  *
+ * If the warm_start property is true, the search for the tangent points
+ * starts from the tangent points of the last wrap of the path in the same
+ * State (see PathWrap::getWarmStartWrap()) when both path points have moved
+ * less than a tenth of the mean radius of the ellipsoid since then, and the
+ * last wrap is reused if the path points have not moved at all. The last
+ * wrap is kept in the State, so other States evaluated in between (e.g., on
+ * other threads) do not affect the search. The wrapping plane is still
+ * computed from the current path points, so the wrap depends only on the
+ * path points, to within the tolerance of the search. getWrapStatistics()
+ * reports how often the search was warm started and how many iterations it
+ * took.
+ *
  * @author Peter Loan
  * updated for OpenSim 4.0 by Benjamin Michaud, 2019.
  */
@@ -48,6 +60,10 @@ public:
 //=============================================================================
     OpenSim_DECLARE_PROPERTY(dimensions, SimTK::Vec3,
                              "The length of the radii of the ellipsoid.");
+    OpenSim_DECLARE_PROPERTY(warm_start, bool,
+        "Whether to start the search for the tangent points from those of "
+        "the last wrap of the path, if the path points have moved little "
+        "since then (default: false).");
 
 //=============================================================================
 // METHODS
@@ -78,7 +94,8 @@ private:
     void constructProperties();
 
     int calcTangentPoint(double p1e, SimTK::Vec3& r1, SimTK::Vec3& p1, SimTK::Vec3& m,
-                                                SimTK::Vec3& a, SimTK::Vec3& vs, double vs4) const;
+                                                SimTK::Vec3& a, SimTK::Vec3& vs, double vs4,
+                                                int& numIterations) const;
     void CalcDistanceOnEllipsoid(SimTK::Vec3& r1, SimTK::Vec3& r2, SimTK::Vec3& m, SimTK::Vec3& a, 
                                                           SimTK::Vec3& vs, double vs4, bool far_side_wrap,
                                                           WrapResult& aWrapResult) const;
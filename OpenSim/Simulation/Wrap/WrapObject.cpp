@@ -180,6 +180,34 @@ int WrapObject::wrapPathSegment(const SimTK::State& s,
    return return_code;
 }
 
+WrapObject::WrapStatistics WrapObject::getWrapStatistics() const
+{
+    WrapStatistics statistics;
+    statistics.numWraps = _wrapCounters.numWraps;
+    statistics.numWarmStarts = _wrapCounters.numWarmStarts;
+    statistics.numEarlyExits = _wrapCounters.numEarlyExits;
+    statistics.numIterations = _wrapCounters.numIterations;
+    return statistics;
+}
+
+void WrapObject::resetWrapStatistics() const
+{
+    _wrapCounters.numWraps = 0;
+    _wrapCounters.numWarmStarts = 0;
+    _wrapCounters.numEarlyExits = 0;
+    _wrapCounters.numIterations = 0;
+}
+
+void WrapObject::recordWrap(bool warmStarted, int numIterations) const
+{
+    ++_wrapCounters.numWraps;
+    if (warmStarted) {
+        ++_wrapCounters.numWarmStarts;
+        if (numIterations == 0) ++_wrapCounters.numEarlyExits;
+    }
+    _wrapCounters.numIterations += numIterations;
+}
+
 void WrapObject::updateFromXMLNode(SimTK::Xml::Element& node,
         int versionNumber) {
     int documentVersion = versionNumber;
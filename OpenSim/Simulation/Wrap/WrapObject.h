@@ -26,6 +26,8 @@
 // INCLUDE
 #include <OpenSim/Simulation/Model/ModelComponent.h>
 #include <OpenSim/Simulation/Model/Appearance.h>
+
+#include <atomic>
 namespace OpenSim {
 
 class PathWrap;
@@ -131,6 +133,27 @@ public:
                          const PathWrap& aPathWrap,
                          WrapResult& aWrapResult) const;
 
+#ifndef SWIG
+    /** Counts of the work done by the iterative searches of this WrapObject,
+    for profiling. WrapEllipsoid and WrapTorus record them (the counts are
+    zero for the other WrapObjects). The counts may be updated by several
+    threads at once, and are reset when the WrapObject is copied. */
+    struct WrapStatistics {
+        /// Number of path segments wrapped over this WrapObject.
+        long long numWraps = 0;
+        /// Number of wraps whose search started from the previous wrap of
+        /// the PathWrap (see the warm_start property of the WrapObject).
+        long long numWarmStarts = 0;
+        /// Number of warm-started wraps that needed no iterations, because
+        /// the previous solution was still converged.
+        long long numEarlyExits = 0;
+        /// Total number of iterations of the searches.
+        long long numIterations = 0;
+    };
+    WrapStatistics getWrapStatistics() const;
+    void resetWrapStatistics() const;
+#endif
+
 protected:
     virtual int wrapLine(const SimTK::State& state,
                          SimTK::Vec3& aPoint1, SimTK::Vec3& aPoint2,
@@ -150,10 +173,27 @@ protected:
     void updateFromXMLNode(SimTK::Xml::Element& node, int versionNumber)
         override;
 
+#ifndef SWIG
+    /** Record one wrap in the statistics (see getWrapStatistics()). */
+    void recordWrap(bool warmStarted, int numIterations) const;
+#endif
+
 private:
     void constructProperties();
 
     SimTK::ReferencePtr<const PhysicalFrame> _frame;
+#ifndef SWIG
+    struct WrapCounters {
+        WrapCounters() = default;
+        WrapCounters(const WrapCounters&) {}
+        WrapCounters& operator=(const WrapCounters&) { return *this; }
+        std::atomic<long long> numWraps{0};
+        std::atomic<long long> numWarmStarts{0};
+        std::atomic<long long> numEarlyExits{0};
+        std::atomic<long long> numIterations{0};
+    };
+    mutable WrapCounters _wrapCounters;
+#endif
 
 protected:
 
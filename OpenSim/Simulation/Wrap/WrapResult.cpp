@@ -56,6 +56,9 @@ void WrapResult::copyData(const WrapResult& aWrapResult) {
         c1[i] = aWrapResult.c1[i];
         sv[i] = aWrapResult.sv[i];
     }
+    p1 = aWrapResult.p1;
+    p2 = aWrapResult.p2;
+    q = aWrapResult.q;
 
     // TODO: Should factor be omitted from the copy?
 }
@@ -61,6 +61,11 @@ public:
     // so we can more easily detect any bugs caused by not copying this
     // variable.
     double factor = SimTK::NaN;  // scale factor used to normalize parameters
+    // Used by the wrap objects that can warm start their search from the
+    // previous wrap (WrapEllipsoid, WrapTorus):
+    SimTK::Vec3 p1{SimTK::NaN};  // path points, in the wrap object's frame,
+    SimTK::Vec3 p2{SimTK::NaN};  // for which this wrap was calculated
+    SimTK::Vec2 q{SimTK::NaN};   // solution of the wrap object's search
 
 //=============================================================================
 // METHODS
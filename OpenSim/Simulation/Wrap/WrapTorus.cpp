@@ -44,6 +44,7 @@ using SimTK::Vec3;
 static const char* wrapTypeName = "torus";
 
 #define CYL_LENGTH 10000.0
+#define WARM_START_MAX_CHANGE 0.1     // largest move of the path points for a warm start, relative to the outer radius
 
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
@@ -76,6 +77,7 @@ void WrapTorus::constructProperties()
 {
     constructProperty_inner_radius(0.01);
     constructProperty_outer_radius(0.05);
+    constructProperty_warm_start(false);
 }
 
 void WrapTorus::extendScale(const SimTK::State& s, const ScaleSet& scaleSet)
@@ -211,7 +213,30 @@ int WrapTorus::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::Vec3
     //bool far_side_wrap = false;
     aFlag = true;
 
-    if (findClosestPoint(get_outer_radius(), &aPoint1[0], &aPoint2[0], &closestPt[0], &closestPt[1], &closestPt[2], _wrapSign, _wrapAxis) == 0)
+    // With warm_start, the search for the closest point can start from the
+    // solution of the last wrap of this path in this State, if it is a wrap
+    // of the same path segment; if the path points have not moved, there is
+    // nothing to search.
+    const WrapResult& warmStartWrap = aPathWrap.getWarmStartWrap(s);
+    SimTK::Vec2 q(0.0);
+    bool warmStarted = false, search = true;
+    int numIterations = 0;
+    if (get_warm_start() && !warmStartWrap.q.isNaN() &&
+        warmStartWrap.startPoint == aWrapResult.startPoint &&
+        warmStartWrap.endPoint == aWrapResult.endPoint)
+    {
+        const double maxChange = WARM_START_MAX_CHANGE * get_outer_radius();
+        if ((aPoint1 - warmStartWrap.p1).norm() < maxChange &&
+            (aPoint2 - warmStartWrap.p2).norm() < maxChange)
+        {
+            q = warmStartWrap.q;
+            warmStarted = true;
+            search = !(aPoint1 == warmStartWrap.p1 && aPoint2 == warmStartWrap.p2);
+        }
+    }
+
+    if (findClosestPoint(get_outer_radius(), &aPoint1[0], &aPoint2[0], &closestPt[0], &closestPt[1], &closestPt[2],
+                         _wrapSign, _wrapAxis, q, search, numIterations) == 0)
         return noWrap;
 
     // Now put a cylinder at closestPt and call the cylinder wrap code.
@@ -249,6 +274,11 @@ int WrapTorus::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::Vec3
             aWrapResult.wrap_pts.updElt(i) = cylinderToTorus.shiftBaseStationToFrame(aWrapResult.wrap_pts.get(i));
     }
 
+    aWrapResult.p1 = aPoint1;
+    aWrapResult.p2 = aPoint2;
+    aWrapResult.q = q;
+    recordWrap(warmStarted, numIterations);
+
     return wrapped;
 }
 
@@ -266,18 +296,23 @@ int WrapTorus::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::Vec3
  * @param zc The Z coordinate of the closest point
  * @param wrap_sign If wrap is constrained to a quadrant, the sign of the relevant axis
  * @param wrap_axis If wrap is constrained to a quadrant, the relevant axis
+ * @param q On input, the starting values of the two passes of the search (the
+ * distances along the line from p1 and from p2); on output, their solutions
+ * @param search If false, q is already the solution and is not searched for
+ * @param numIterations Incremented by the number of residual evaluations
  * @return '1' if a closest point was found, '0' if there was an error while trying to constrain the wrap
  */
 int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
                                           double* xc, double* yc, double* zc,
-                                          int wrap_sign, int wrap_axis) const
+                                          int wrap_sign, int wrap_axis,
+                                          SimTK::Vec2& q, bool search, int& numIterations) const
 {
    int info;                  // output flag
    int num_func_calls;        // number of calls to func (nfev)
    int ldfjac = 1;            // leading dimension of fjac (nres)
    int numResid = 1;
    int numQs = 1;
-   double q[2], resid[2], fjac[2];            // m X n array
+   double resid[2], fjac[2];            // m X n array
    CircleCallback cb;
    bool constrained = (bool) (wrap_sign != 0);
    // solution parameters
@@ -298,12 +333,14 @@ int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
    cb.p2[2] = p2[2];
    cb.r = radius;
 
-   q[0] = 0.0;
-
-   lmdif_C(calcCircleResids, numResid, numQs, q, resid,
-           ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
-           nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
-           wa1, wa2, wa3, wa4, (void*)&cb);
+   if (search)
+   {
+      lmdif_C(calcCircleResids, numResid, numQs, &q[0], resid,
+              ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
+              nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
+              wa1, wa2, wa3, wa4, (void*)&cb);
+      numIterations += num_func_calls;
+   }
 
    u = q[0];
 
@@ -333,14 +370,16 @@ int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
    cb.p2[2] = p1[2];
    cb.r = radius;
 
-   q[0] = 0.0;
-
-   lmdif_C(calcCircleResids, numResid, numQs, q, resid,
-           ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
-           nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
-           wa1, wa2, wa3, wa4, (void*)&cb);
+   if (search)
+   {
+      lmdif_C(calcCircleResids, numResid, numQs, &q[1], resid,
+              ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
+              nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
+              wa1, wa2, wa3, wa4, (void*)&cb);
+      numIterations += num_func_calls;
+   }
 
-   u = q[0];
+   u = q[1];
 
    mag = sqrt((p2[0]-p1[0])*(p2[0]-p1[0]) + (p2[1]-p1[1])*(p2[1]-p1[1]) + (p2[2]-p1[2])*(p2[2]-p1[2]));
 
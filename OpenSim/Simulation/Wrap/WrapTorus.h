@@ -37,6 +37,13 @@ class WrapResult;
 /**
  * A class implementing a torus for muscle wrapping.
  *
+ * If the warm_start property is true, the search for the point of the
+ * torus's inner circle closest to the path starts from the solution of the
+ * last wrap of the path in the same State (see PathWrap::getWarmStartWrap())
+ * when both path points have moved less than a tenth of the outer radius
+ * since then, and is skipped if the path points have not moved at all. See
+ * getWrapStatistics().
+ *
  * @author Peter Loan  
  * updated for OpenSim 4.0 by Benjamin Michaud, 2019.
  */
@@ -54,6 +61,10 @@ public:
 //==============================================================================
     OpenSim_DECLARE_PROPERTY(inner_radius, double, "The inner radius of the Torus.");
     OpenSim_DECLARE_PROPERTY(outer_radius, double, "The outer radius of the Torus.");
+    OpenSim_DECLARE_PROPERTY(warm_start, bool,
+        "Whether to start the search for the closest point from the solution "
+        "of the last wrap of the path, if the path points have moved "
+        "little since then (default: false).");
 
 //=============================================================================
 // METHODS
@@ -89,7 +100,8 @@ private:
 
     int findClosestPoint(double radius, double p1[], double p2[],
         double* xc, double* yc, double* zc,
-        int wrap_sign, int wrap_axis) const;
+        int wrap_sign, int wrap_axis,
+        SimTK::Vec2& q, bool search, int& numIterations) const;
     static void calcCircleResids(int numResid, int numQs, double q[],
         double resid[], int *flag2, void *ptr);
 
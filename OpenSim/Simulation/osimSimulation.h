@@ -74,6 +74,7 @@
 #include "Model/Ground.h"
 
 #include "Manager/Manager.h"
+#include "Manager/EnsembleSimulator.h"
 
 #include "Control/ControlSet.h"
 #include "Control/ControlSetController.h"
@@ -48,6 +48,7 @@ public:
 
 void testWrapCylinder();
 void testWrapObjectUpdateFromXMLNode30515();
+void testWarmStartedWrapping();
 void simulate(Model& osimModel, State& si, double initialTime, double finalTime);
 void simulateModelWithMusclesNoViz(const string &modelFile, double finalTime, double activation=0.5);
 void simulateModelWithPassiveMuscles(const string &modelFile, double finalTime);
@@ -74,6 +75,13 @@ int main()
          failures.push_back("testWrapObjectUpdateFromXMLNode30515");
     }
 
+    try{
+        testWarmStartedWrapping();
+    } catch (const std::exception& e) {
+         std::cout << "Exception: " << e.what() << std::endl;
+         failures.push_back("testWarmStartedWrapping");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -942,7 +950,83 @@ void testWrapObjectUpdateFromXMLNode30515() {
     }
 }
 
+// Warm starting the searches of the wrap objects must not change the paths,
+// and should reduce the number of iterations.
+void testWarmStartedWrapping() {
+    Model coldModel("TestShoulderWrapping.osim");
+    Model warmModel("TestShoulderWrapping.osim");
+    for (auto& ellipsoid : warmModel.updComponentList<WrapEllipsoid>())
+        ellipsoid.set_warm_start(true);
+    for (auto& torus : warmModel.updComponentList<WrapTorus>())
+        torus.set_warm_start(true);
+    State& coldState = coldModel.initSystem();
+    State& warmState = warmModel.initSystem();
+
+    // Move the humerus in small steps, as a simulation would.
+    const Coordinate& coldElv = coldModel.getCoordinateSet().get("shoulder_elv");
+    const Coordinate& warmElv = warmModel.getCoordinateSet().get("shoulder_elv");
+    const double start = coldElv.getValue(coldState);
+    const int numSteps = 100;
+    for (int i = 0; i <= numSteps; ++i) {
+        const double elv = start + SimTK::Pi / 2 * i / numSteps;
+        coldElv.setValue(coldState, elv);
+        warmElv.setValue(warmState, elv);
+        for (const auto& coldPath :
+                coldModel.getComponentList<GeometryPath>()) {
+            const auto& warmPath = warmModel.getComponent<GeometryPath>(
+                    coldPath.getAbsolutePathString());
+            const double length = coldPath.getLength(coldState);
+            ASSERT_EQUAL(length, warmPath.getLength(warmState),
+                    1e-4 * length, __FILE__, __LINE__,
+                    "Warm-started path " + warmPath.getAbsolutePathString() +
+                    " differs from the cold-started path.");
+        }
+    }
 
-
-
-
+    auto sumStatistics = [](const Model& model) -> WrapObject::WrapStatistics {
+        WrapObject::WrapStatistics total;
+        for (const auto& wrapObject : model.getComponentList<WrapObject>()) {
+            const auto statistics = wrapObject.getWrapStatistics();
+            total.numWraps += statistics.numWraps;
+            total.numWarmStarts += statistics.numWarmStarts;
+            total.numEarlyExits += statistics.numEarlyExits;
+            total.numIterations += statistics.numIterations;
+        }
+        return total;
+    };
+    const auto cold = sumStatistics(coldModel);
+    const auto warm = sumStatistics(warmModel);
+    cout << "Cold start: " << cold.numWraps << " wraps, "
+         << cold.numIterations << " iterations." << endl;
+    cout << "Warm start: " << warm.numWraps << " wraps ("
+         << warm.numWarmStarts << " warm started), "
+         << warm.numIterations << " iterations." << endl;
+    SimTK_TEST(cold.numWraps > 0);
+    SimTK_TEST(cold.numWarmStarts == 0);
+    SimTK_TEST(warm.numWarmStarts > 0);
+    SimTK_TEST(warm.numIterations < cold.numIterations);
+
+    // Evaluating the paths again in the same configuration reuses the
+    // previous wraps.
+    warmState.updQ();
+    warmModel.realizePosition(warmState);
+    for (const auto& path : warmModel.getComponentList<GeometryPath>())
+        path.getLength(warmState);
+    const auto reused = sumStatistics(warmModel);
+    SimTK_TEST(reused.numEarlyExits > warm.numEarlyExits);
+
+    // The previous wraps are kept in each State, so evaluating the paths in
+    // another State in between (e.g., on another thread) does not change
+    // which wraps are reused.
+    State otherState = warmState;
+    warmElv.setValue(otherState, start);
+    for (const auto& path : warmModel.getComponentList<GeometryPath>())
+        path.getLength(otherState);
+    const auto other = sumStatistics(warmModel);
+    warmState.updQ();
+    warmModel.realizePosition(warmState);
+    for (const auto& path : warmModel.getComponentList<GeometryPath>())
+        path.getLength(warmState);
+    SimTK_TEST(sumStatistics(warmModel).numEarlyExits - other.numEarlyExits ==
+               reused.numEarlyExits - warm.numEarlyExits);
+}
@@ -22,6 +22,8 @@
 #include <OpenSim/Common/XMLDocument.h>
 #include "AnalyzeTool.h"
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/Stopwatch.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 
 #include <OpenSim/Simulation/Control/ControlLinear.h>
@@ -195,6 +197,7 @@ setNull()
     _statesStore = NULL;
 
     _printResultFiles = true;
+    _numThreads = 1;
     _replaceForceSet = false;
 }
 //_____________________________________________________________________________
@@ -261,6 +264,7 @@ operator=(const AnalyzeTool &aTool)
     _lowpassCutoffFrequency= aTool._lowpassCutoffFrequency;
     _statesStore = aTool._statesStore;
     _printResultFiles = aTool._printResultFiles;
+    _numThreads = aTool._numThreads;
     return(*this);
 }
 
@@ -590,7 +594,8 @@ bool AnalyzeTool::run(bool plotting)
     //}
 
     log_info("Executing the analyses from {} to {}...", ti, tf);
-    run(s, *_model, iInitial, iFinal, *_statesStore, _solveForEquilibriumForAuxiliaryStates);
+    run(s, *_model, iInitial, iFinal, *_statesStore,
+            _solveForEquilibriumForAuxiliaryStates, _numThreads);
     _model->getMultibodySystem().realize(s, SimTK::Stage::Position );
     } catch (const Exception& x) {
         x.print(cout);
@@ -613,22 +618,20 @@ bool AnalyzeTool::run(bool plotting)
 //=============================================================================
 // HELPER
 //=============================================================================
-void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium)
+namespace {
+// Set the state of the model to each of the frames iFirst to iLast of the
+// states storage, calling begin() on the analyses of the model at the first
+// frame, end() at the last, and step() in between.
+void runFrames(SimTK::State& s, Model& model, int iFirst, int iLast,
+        const Storage& statesStore, bool solveForEquilibrium)
 {
-    AnalysisSet& analysisSet = aModel.updAnalysisSet();
-
-    for(int i=0;i<analysisSet.getSize();i++) {
-        analysisSet.get(i).setStatesStore(aStatesStore);
-    }
-
-
     // PERFORM THE ANALYSES
     double /*tPrev=0.0,*/t=0.0/*,dt=0.0*/;
     int ny = s.getNY();
     Array<double> dydt(0.0,ny);
     Array<double> yFromStorage(0.0,ny);
 
-    const Array<string>& labels =  aStatesStore.getColumnLabels();
+    const Array<string>& labels =  statesStore.getColumnLabels();
     int numOpenSimStates = labels.getSize()-1;
 
     SimTK::Vector stateData;
@@ -642,8 +645,8 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
     // The model's order is given by its getStateVariableNames() so we can 
     // compare to the column labels of the storage and construct a dataToModel
     // mapping.
-    const Array<std::string>& stateNames = aStatesStore.getColumnLabels();
-    Array<std::string> modelStateNames = aModel.getStateVariableNames();
+    const Array<std::string>& stateNames = statesStore.getColumnLabels();
+    Array<std::string> modelStateNames = model.getStateVariableNames();
 
     int nsData = stateNames.size() - 1;  //-1 since time is a column
     Array<int> dataToModel(-1, nsData);
@@ -661,33 +664,34 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
     // assume all the important/necessary state values for running an analysis
     // are provided by the Storage. Here we initialize the state values to their
     // model defaults.
-    SimTK::Vector stateValues = aModel.getStateVariableValues(s);
+    SimTK::Vector stateValues = model.getStateVariableValues(s);
 
-    for(int i=iInitial;i<=iFinal;i++) {
+    AnalysisSet& analysisSet = model.updAnalysisSet();
+    for(int i=iFirst;i<=iLast;i++) {
         // tPrev = t;
-        aStatesStore.getTime(i,s.updTime()); // time
+        statesStore.getTime(i,s.updTime()); // time
         t = s.getTime();
-        aModel.setAllControllersEnabled(true);
+        model.setAllControllersEnabled(true);
 
-        aStatesStore.getData(i,numOpenSimStates,&stateData[0]); // states
+        statesStore.getData(i,numOpenSimStates,&stateData[0]); // states
         // Get data into local Vector and assign to State using common utility
         // to handle internal (non-OpenSim) states that may exist
 
         for (int k=0; k < nsData; ++k) {
             stateValues[dataToModel[k]] = stateData[k];
         }
-        aModel.setStateVariableValues(s, stateValues);
+        model.setStateVariableValues(s, stateValues);
        
         // Adjust configuration to match constraints and other goals
-        aModel.assemble(s);
+        model.assemble(s);
 
         // equilibrateMuscles before realization as it may affect forces
-        if(aSolveForEquilibrium){
+        if(solveForEquilibrium){
             try{// might not be able to equilibrate if model is in
                 // a non-physical pose. For example, a pose where the 
                 // muscle length is shorter than the tendon slack-length.
                 // the muscle will throw an Exception in this case.
-                aModel.equilibrateMuscles(s);
+                model.equilibrateMuscles(s);
             }
             catch (const std::exception& e) {
                 log_warn("AnalyzeTool::run() unable to equilibrate muscles at "
@@ -695,11 +699,11 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
             }
         }
         // Make sure model is at least ready to provide kinematics
-        aModel.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
+        model.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
 
-        if(i==iInitial) {
+        if(i==iFirst) {
             analysisSet.begin(s);
-        } else if(i==iFinal) {
+        } else if(i==iLast) {
             analysisSet.end(s);
         // Step
         } else {
@@ -707,3 +711,134 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
         }
     }
 }
+} // anonymous namespace
+
+void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
+        const Storage &aStatesStore, bool aSolveForEquilibrium, int numThreads)
+{
+    AnalysisSet& analysisSet = aModel.updAnalysisSet();
+
+    for(int i=0;i<analysisSet.getSize();i++) {
+        analysisSet.get(i).setStatesStore(aStatesStore);
+    }
+
+    // Analyses whose results at a frame depend only on the state at that
+    // frame can be run on contiguous ranges of frames concurrently. Any other
+    // analysis must see all the frames in order, and is run serially. With
+    // a step interval other than 1, splitting the frames would change which
+    // frames are recorded, so such analyses are also run serially.
+    const int numFrames = iFinal - iInitial + 1;
+    const int numRanges = numThreads == 1 ? 1
+            : std::min(getNumThreadsToUse(numThreads), numFrames);
+    std::vector<bool> wasOn(analysisSet.getSize());
+    std::vector<bool> isParallel(analysisSet.getSize(), false);
+    int numParallel = 0;
+    for(int i=0;i<analysisSet.getSize();i++) {
+        const Analysis& analysis = analysisSet.get(i);
+        wasOn[i] = analysis.getOn();
+        if(numRanges > 1 && analysis.getOn() &&
+                analysis.getSupportsParallelFrames() &&
+                analysis.getStepInterval() == 1) {
+            isParallel[i] = true;
+            ++numParallel;
+        }
+    }
+    if(numParallel == 0) {
+        runFrames(s, aModel, iInitial, iFinal, aStatesStore,
+                aSolveForEquilibrium);
+        return;
+    }
+
+    Stopwatch watch;
+    // The first range of frames is processed by the analyses of the model
+    // itself, so that their storages hold the results of that range; each
+    // of the other ranges is processed by the analyses of a copy of the
+    // model. The copies are made, and their systems initialized, serially.
+    std::vector<std::unique_ptr<Model>> models(numRanges - 1);
+    std::vector<SimTK::State> states(numRanges - 1);
+    for(int ir=1;ir<numRanges;ir++) {
+        models[ir-1].reset(aModel.clone());
+        states[ir-1] = models[ir-1]->initSystem();
+        AnalysisSet& copies = models[ir-1]->updAnalysisSet();
+        for(int i=0;i<copies.getSize();i++) {
+            copies.get(i).setOn(isParallel[i]);
+            copies.get(i).setStatesStore(aStatesStore);
+        }
+    }
+    for(int i=0;i<analysisSet.getSize();i++) {
+        analysisSet.get(i).setOn(isParallel[i]);
+    }
+
+    std::vector<std::string> errors(numRanges);
+    executeInParallel(numRanges, numRanges,
+        [&](int irange, int /*ithread*/) {
+            const int iFirst = iInitial + irange * numFrames / numRanges;
+            const int iLast = iInitial + (irange + 1) * numFrames / numRanges - 1;
+            try {
+                if(irange == 0) {
+                    runFrames(s, aModel, iFirst, iLast, aStatesStore,
+                            aSolveForEquilibrium);
+                } else {
+                    runFrames(states[irange-1], *models[irange-1], iFirst,
+                            iLast, aStatesStore, aSolveForEquilibrium);
+                }
+            } catch (const std::exception& ex) {
+                errors[irange] = ex.what();
+            }
+        });
+
+    // Restore the analyses that were turned off above before reporting any
+    // error, and run the remaining analyses over all the frames. If there
+    // are none, only set the state to the last frame, as the serial run does.
+    bool haveSerial = false;
+    for(int i=0;i<analysisSet.getSize();i++) {
+        analysisSet.get(i).setOn(wasOn[i] && !isParallel[i]);
+        haveSerial = haveSerial || analysisSet.get(i).getOn();
+    }
+    for(int irange=0;irange<numRanges;irange++) {
+        if(!errors[irange].empty()) {
+            for(int i=0;i<analysisSet.getSize();i++) {
+                analysisSet.get(i).setOn(wasOn[i]);
+            }
+            OPENSIM_THROW(Exception, "AnalyzeTool: analyses failed on range "
+                    "{} of frames: {}", irange, errors[irange]);
+        }
+    }
+    try {
+        runFrames(s, aModel, haveSerial ? iInitial : iFinal, iFinal,
+                aStatesStore, aSolveForEquilibrium);
+    } catch (...) {
+        for(int i=0;i<analysisSet.getSize();i++) {
+            analysisSet.get(i).setOn(wasOn[i]);
+        }
+        throw;
+    }
+    for(int i=0;i<analysisSet.getSize();i++) {
+        analysisSet.get(i).setOn(wasOn[i]);
+    }
+
+    // Append the results of the copies, in the order of the ranges (i.e.,
+    // in time order), to the storages of the analyses of the model.
+    for(int i=0;i<analysisSet.getSize();i++) {
+        if(!isParallel[i]) continue;
+        ArrayPtrs<Storage>& stores = analysisSet.get(i).getStorageList();
+        for(int ir=1;ir<numRanges;ir++) {
+            ArrayPtrs<Storage>& copyStores =
+                    models[ir-1]->updAnalysisSet().get(i).getStorageList();
+            OPENSIM_THROW_IF(copyStores.getSize() != stores.getSize(),
+                    Exception, "AnalyzeTool: the copies of analysis '{}' "
+                    "have {} storages but the analysis has {}.",
+                    analysisSet.get(i).getName(), copyStores.getSize(),
+                    stores.getSize());
+            for(int k=0;k<stores.getSize();k++) {
+                if(stores[k] == nullptr || copyStores[k] == nullptr) continue;
+                for(int r=0;r<copyStores[k]->getSize();r++) {
+                    stores[k]->append(*copyStores[k]->getStateVector(r));
+                }
+            }
+        }
+    }
+    log_info("Ran {} of {} analyses over {} frames in {} parallel ranges "
+            "in {}.", numParallel, analysisSet.getSize(), numFrames,
+            numRanges, watch.getElapsedTimeFormatted());
+}
@@ -77,6 +77,9 @@ private:
 
     /** Whether the model and states should be loaded from input files */
     bool _loadModelAndInput;
+
+    /** Number of threads used to run the analyses over the states. */
+    int _numThreads;
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -121,6 +124,15 @@ public:
     void setLowpassCutoffFrequency(double aLowpassCutoffFrequency) { _lowpassCutoffFrequency = aLowpassCutoffFrequency; }
     bool getLoadModelAndInput() const { return _loadModelAndInput; }
     void setLoadModelAndInput(bool b) { _loadModelAndInput = b; }
+    /** The number of threads used to run the analyses over the states. The
+    frames of the states are split into contiguous ranges that are processed
+    concurrently, each by its own copy of the model, by the analyses that
+    support it (see Analysis::getSupportsParallelFrames()); the results are
+    then merged in time order. Other analyses are run serially. The default,
+    1, runs all analyses serially; 0 uses as many threads as the hardware
+    supports. */
+    int getNumThreads() const { return _numThreads; }
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
 
     //--------------------------------------------------------------------------
     // UTILITIES
@@ -140,7 +152,9 @@ public:
     // HELPER
     //--------------------------------------------------------------------------
 #ifndef SWIG
-    static void run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium);
+    /** Run the analyses of the model over the frames iInitial to iFinal of
+    the states storage. See setNumThreads() for the meaning of numThreads. */
+    static void run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium, int numThreads = 1);
 #endif
 //=============================================================================
 };  // END of class AnalyzeTool
@@ -120,6 +120,7 @@ void InverseDynamicsTool::setNull()
     _model = NULL;
     _lowpassCutoffFrequency = -1.0;
     _coordinateValues = NULL;
+    _numThreads = 1;
 }
 //_____________________________________________________________________________
 /**
@@ -183,6 +184,7 @@ operator=(const InverseDynamicsTool &aTool)
     _outputGenForceFileName = aTool._outputGenForceFileName;
     _outputBodyForcesAtJointsFileName = aTool._outputBodyForcesAtJointsFileName;
     _coordinateValues = NULL;
+    _numThreads = aTool._numThreads;
 
     return(*this);
 }
@@ -416,8 +418,15 @@ bool InverseDynamicsTool::run()
 
         // solve for the trajectory of generalized forces that correspond to the 
         // coordinate trajectories provided
-        ivdSolver.solve(s, coordFunctions, coordinatesToSpeedsIndexMap, times,
-                genForceTraj);
+        if (_model->getAnalysisSet().getSize() == 0) {
+            // No analyses to step, so all frames can be solved at once.
+            const Matrix genForces = ivdSolver.solve(s, coordFunctions,
+                    coordinatesToSpeedsIndexMap, times, _numThreads);
+            for (int i = 0; i < nt; ++i) genForceTraj[i] = ~genForces[i];
+        } else {
+            ivdSolver.solve(s, coordFunctions, coordinatesToSpeedsIndexMap,
+                    times, genForceTraj);
+        }
         success = true;
 
         log_info("InverseDynamicsTool: {} time frames in {}.", nt, 
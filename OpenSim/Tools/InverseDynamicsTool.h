@@ -88,6 +88,9 @@ protected:
     PropertyStr _outputBodyForcesAtJointsFileNameProp;
     std::string &_outputBodyForcesAtJointsFileName;
 
+    /** Number of threads used to solve the time frames. */
+    int _numThreads;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -156,6 +159,12 @@ public:
     void setLowpassCutoffFrequency(double aFrequency) {
         _lowpassCutoffFrequency = aFrequency;
     }
+    /** The number of threads over which the time frames are distributed.
+    The default, 1, solves the frames serially; 0 uses as many threads as the
+    hardware supports. If the model has analyses, they are stepped at each
+    frame and the frames are always solved serially. */
+    int getNumThreads() const { return _numThreads; }
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
     //--------------------------------------------------------------------------
     // INTERFACE
     //--------------------------------------------------------------------------
@@ -30,6 +30,7 @@
 #include "IKTaskSet.h"
 
 #include <OpenSim/Analyses/Kinematics.h>
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/FunctionSet.h>
 #include <OpenSim/Common/GCVSplineSet.h>
@@ -104,7 +105,6 @@ bool InverseKinematicsTool::run()
 {
     bool success = false;
     bool modelFromFile=true;
-    Kinematics* kinematicsReporter = nullptr;
     try{
         //Load and create the indicated model
         if (_model.empty()) { 
@@ -124,25 +124,172 @@ bool InverseKinematicsTool::run()
         // parsing code behaves properly if called from a different directory.
         auto cwd = IO::CwdChanger::changeToParentOf(getDocumentFileName());
 
-        // Define reporter for output
-        kinematicsReporter = new Kinematics();
-        kinematicsReporter->setRecordAccelerations(false);
-        kinematicsReporter->setInDegrees(true);
-        _model->addAnalysis(kinematicsReporter);
-
         log_info("Running tool {}.", getName());
 
-        // Get the trial name to label data written to files
-        string trialName = getName();
-
         // Initialize the model's underlying system and get its default state.
         SimTK::State& s = _model->initSystem();
 
+        Stopwatch watch;
+        const int Nframes = solveTrial(*_model, s, get_marker_file(),
+                get_output_motion_file(), getName());
+
+        success = true;
+
+        log_info("InverseKinematicsTool completed {} frames in {}.", Nframes,
+            watch.getElapsedTimeFormatted());
+    }
+    catch (const std::exception& ex) {
+        log_error("InverseKinematicsTool Failed: {}", ex.what());
+        throw (Exception("InverseKinematicsTool Failed, "
+            "please see messages window for details..."));
+    }
+
+    if (modelFromFile) 
+        _model.reset();
+
+    return success;
+}
+
+//_____________________________________________________________________________
+/**
+ * Run the inverse kinematics tool on several trials concurrently.
+ */
+std::vector<double> InverseKinematicsTool::runBatch(
+        const std::vector<std::string>& markerFiles,
+        const std::vector<std::string>& outputMotionFiles, int numThreads)
+{
+    OPENSIM_THROW_IF_FRMOBJ(markerFiles.size() != outputMotionFiles.size(),
+            Exception,
+            "Expected the same number of marker files and output motion files, "
+            "but got {} and {}.", markerFiles.size(), outputMotionFiles.size());
+    OPENSIM_THROW_IF_FRMOBJ(numThreads < 0, Exception,
+            "Expected numThreads to be non-negative, but got {}.", numThreads);
+
+    const int numTrials = (int)markerFiles.size();
+    std::vector<double> trialTimes(numTrials, SimTK::NaN);
+    if (numTrials == 0) return trialTimes;
+
+    // Label the error and marker location files of each trial with the name
+    // of its output motion file (or, if it has none, the index of the trial).
+    // The trials are solved concurrently, so no two of them may write the
+    // same file.
+    std::vector<std::string> trialNames(numTrials);
+    for (int itrial = 0; itrial < numTrials; ++itrial) {
+        const std::string& outputFile = outputMotionFiles[itrial];
+        if (outputFile.empty() || outputFile == "Unassigned") {
+            trialNames[itrial] = getName() + "_trial" + std::to_string(itrial);
+        } else {
+            bool dontApplySearchPath;
+            std::string directory, extension;
+            SimTK::Pathname::deconstructPathname(outputFile,
+                    dontApplySearchPath, directory, trialNames[itrial],
+                    extension);
+        }
+        for (int jtrial = 0; jtrial < itrial; ++jtrial) {
+            OPENSIM_THROW_IF_FRMOBJ(trialNames[itrial] == trialNames[jtrial],
+                    Exception,
+                    "Expected output motion files with distinct names, but "
+                    "trials {} and {} are both named '{}'.", jtrial, itrial,
+                    trialNames[itrial]);
+        }
+    }
+
+    bool modelFromFile = true;
+    if (_model.empty()) {
+        OPENSIM_THROW_IF_FRMOBJ(get_model_file().empty(), Exception,
+                "No model filename was provided.");
+        _model.reset(new Model(get_model_file()));
+    }
+    else
+        modelFromFile = false;
+    _model->finalizeFromProperties();
+    _model->printBasicInfo();
+
+    auto cwd = IO::CwdChanger::changeToParentOf(getDocumentFileName());
+
+    const int numWorkers = std::min(getNumThreadsToUse(numThreads), numTrials);
+    log_info("Running tool {} on {} trial(s) using {} thread(s).", getName(),
+            numTrials, numWorkers);
+
+    // Each worker gets its own copy of the model, whose system is initialized
+    // only once and then reused for all the trials the worker solves.
+    // Copying and initializing the models is done serially, before any of
+    // the workers start.
+    std::vector<std::unique_ptr<Model>> models(numWorkers);
+    std::vector<SimTK::State> defaultStates(numWorkers);
+    for (int iw = 0; iw < numWorkers; ++iw) {
+        models[iw].reset(_model->clone());
+        defaultStates[iw] = models[iw]->initSystem();
+    }
+    if (modelFromFile)
+        _model.reset();
+
+    std::vector<int> trialFrames(numTrials, 0);
+    std::vector<std::string> trialErrors(numTrials);
+    Stopwatch batchWatch;
+    executeInParallel(numTrials, numWorkers,
+        [&](int itrial, int iworker) {
+            Model& model = *models[iworker];
+            // Each trial starts from the model's default state, so that the
+            // result does not depend on which trials a worker solved before.
+            SimTK::State s = defaultStates[iworker];
+            Stopwatch trialWatch;
+            try {
+                trialFrames[itrial] = solveTrial(model, s,
+                        markerFiles[itrial], outputMotionFiles[itrial],
+                        trialNames[itrial]);
+            } catch (const std::exception& ex) {
+                trialErrors[itrial] = ex.what();
+            }
+            trialTimes[itrial] = trialWatch.getElapsedTime();
+        });
+
+    int numFailed = 0;
+    log_info("InverseKinematicsTool batch timing:");
+    for (int itrial = 0; itrial < numTrials; ++itrial) {
+        if (trialErrors[itrial].empty()) {
+            log_info("  {}: {} frames in {}.", markerFiles[itrial],
+                    trialFrames[itrial],
+                    Stopwatch::formatNs(
+                            (long long)(1e9 * trialTimes[itrial])));
+        } else {
+            ++numFailed;
+            log_error("  {}: failed: {}", markerFiles[itrial],
+                    trialErrors[itrial]);
+        }
+    }
+    log_info("InverseKinematicsTool completed {} trial(s) in {}.", numTrials,
+            batchWatch.getElapsedTimeFormatted());
+
+    OPENSIM_THROW_IF_FRMOBJ(numFailed > 0, Exception,
+            "{} of {} trial(s) failed; see the log for details.", numFailed,
+            numTrials);
+    return trialTimes;
+}
+
+//_____________________________________________________________________________
+/**
+ * Solve the inverse kinematics problem for a single trial, writing the
+ * results to the requested files.
+ */
+int InverseKinematicsTool::solveTrial(Model& model, SimTK::State& s,
+        const std::string& markerFile, const std::string& outputMotionFile,
+        const std::string& trialName) const
+{
+    // Define reporter for output
+    Kinematics* kinematicsReporter = new Kinematics();
+    kinematicsReporter->setRecordAccelerations(false);
+    kinematicsReporter->setInDegrees(true);
+    kinematicsReporter->setModel(model);
+    model.addAnalysis(kinematicsReporter);
+
+    try {
         //Convert old Tasks to references for assembly and tracking
         MarkersReference markersReference;
         SimTK::Array_<CoordinateReference> coordinateReferences;
         // populate the references according to the setting of this Tool
-        populateReferences(markersReference, coordinateReferences);
+        populateReferences(&model, markerFile, markersReference,
+                coordinateReferences);
 
         // Determine the start time, if the provided time range is not 
         // specified then use time from marker reference.
@@ -167,14 +314,14 @@ bool InverseKinematicsTool::run()
         const auto& times = markersTable.getIndependentColumn();
 
         // create the solver given the input data
-        InverseKinematicsSolver ikSolver(*_model, make_shared<MarkersReference>(markersReference),
+        InverseKinematicsSolver ikSolver(model, make_shared<MarkersReference>(markersReference),
             coordinateReferences, get_constraint_weight());
         ikSolver.setAccuracy(get_accuracy());
         s.updTime() = times[start_ix];
         ikSolver.assemble(s);
         kinematicsReporter->begin(s);
 
-        AnalysisSet& analysisSet = _model->updAnalysisSet();
+        AnalysisSet& analysisSet = model.updAnalysisSet();
         analysisSet.begin(s);
         // Get the actual number of markers the Solver is using, which
         // can be fewer than the number of references if there isn't a
@@ -188,8 +335,6 @@ bool InverseKinematicsTool::run()
         Storage *modelMarkerErrors = get_report_errors() ? 
             new Storage(Nframes, "ModelMarkerErrors") : nullptr;
 
-        Stopwatch watch;
-
         for (int i = start_ix; i <= final_ix; ++i) {
             s.updTime() = times[i];
             ikSolver.track(s);
@@ -242,13 +387,12 @@ bool InverseKinematicsTool::run()
 
         // Do the maneuver to change then restore working directory 
         // so that output files are saved to same folder as setup file.
-        if (get_output_motion_file() != "" &&
-                get_output_motion_file() != "Unassigned") {
-            kinematicsReporter->getPositionStorage()->print(
-                    get_output_motion_file());
+        if (outputMotionFile != "" && outputMotionFile != "Unassigned") {
+            kinematicsReporter->getPositionStorage()->print(outputMotionFile);
         }
         // Remove the analysis we added to the model, this also deletes it
-        _model->removeAnalysis(kinematicsReporter);
+        model.removeAnalysis(kinematicsReporter);
+        kinematicsReporter = nullptr;
 
         if (modelMarkerErrors) {
             Array<string> labels("", 4);
@@ -289,24 +433,14 @@ bool InverseKinematicsTool::run()
             delete modelMarkerLocations;
         }
 
-        success = true;
-
-        log_info("InverseKinematicsTool completed {} frames in {}.", Nframes,
-            watch.getElapsedTimeFormatted());
+        return Nframes;
     }
-    catch (const std::exception& ex) {
-        log_error("InverseKinematicsTool Failed: {}", ex.what());
+    catch (...) {
         // If failure happened after kinematicsReporter was added, make sure to cleanup
-        if (kinematicsReporter!= nullptr)
-            _model->removeAnalysis(kinematicsReporter);
-        throw (Exception("InverseKinematicsTool Failed, "
-            "please see messages window for details..."));
+        if (kinematicsReporter != nullptr)
+            model.removeAnalysis(kinematicsReporter);
+        throw;
     }
-
-    if (modelFromFile) 
-        _model.reset();
-
-    return success;
 }
 
 // Handle conversion from older format
@@ -400,6 +534,14 @@ void InverseKinematicsTool::updateFromXMLNode(SimTK::Xml::Element& aNode, int ve
 
 void InverseKinematicsTool::populateReferences(MarkersReference& markersReference,
     SimTK::Array_<CoordinateReference>&coordinateReferences) const
+{
+    populateReferences(_model.get(), get_marker_file(), markersReference,
+            coordinateReferences);
+}
+
+void InverseKinematicsTool::populateReferences(const Model* model,
+    const std::string& markerFile, MarkersReference& markersReference,
+    SimTK::Array_<CoordinateReference>&coordinateReferences) const
 {
     FunctionSet *coordFunctions = NULL;
     // Load the coordinate data
@@ -407,7 +549,7 @@ void InverseKinematicsTool::populateReferences(MarkersReference& markersReferenc
     if (get_coordinate_file() != "" && get_coordinate_file() != "Unassigned") {
         Storage coordinateValues(get_coordinate_file());
         // Convert degrees to radian (TODO: this needs to have a check that the storage is, in fact, in degrees!)
-        _model->getSimbodyEngine().convertDegreesToRadians(coordinateValues);
+        model->getSimbodyEngine().convertDegreesToRadians(coordinateValues);
         // haveCoordinateFile = true;
         coordFunctions = new GCVSplineSet(5, &coordinateValues);
     }
@@ -434,7 +576,7 @@ void InverseKinematicsTool::populateReferences(MarkersReference& markersReferenc
                 coordRef = new CoordinateReference(coordTask->getName(), reference);
             }
             else { // assume it should be held at its default value
-                double value = _model->getCoordinateSet().get(coordTask->getName()).getDefaultValue();
+                double value = model->getCoordinateSet().get(coordTask->getName()).getDefaultValue();
                 Constant reference = Constant(value);
                 coordRef = new CoordinateReference(coordTask->getName(), reference);
             }
@@ -458,7 +600,7 @@ void InverseKinematicsTool::populateReferences(MarkersReference& markersReferenc
     //Read in the marker data file and set the weights for associated markers.
     //Markers in the model and the marker file but not in the markerWeights are
     //ignored
-    markersReference.initializeFromMarkersFile(get_marker_file(), markerWeights);
+    markersReference.initializeFromMarkersFile(markerFile, markerWeights);
 }
 
 
@@ -106,6 +106,31 @@ public:
     // INTERFACE
     //--------------------------------------------------------------------------
     bool run() override SWIG_DECLARE_EXCEPTION;
+
+    /** Run inverse kinematics on several trials at the same time, using the
+    settings of this Tool (tasks, coordinate file, time range, accuracy,
+    etc.) for every trial. Each of the `numThreads` worker threads gets its
+    own copy of the model, whose system is initialized only once and reused
+    for all the trials that the worker solves. Trial i tracks the markers in
+    `markerFiles[i]` and writes the resulting motion to
+    `outputMotionFiles[i]`; marker errors and locations (if requested) are
+    written to the results directory, labeled with the name of the output
+    motion file (or with the index of the trial, if its output motion file is
+    empty). The marker_file and output_motion_file properties are ignored.
+    @param markerFiles TRC files containing the marker trajectories to track.
+    @param outputMotionFiles Names of the resulting .mot files; must have
+        the same length as markerFiles, and their names (without directory
+        and extension) must be distinct.
+    @param numThreads Number of trials to solve concurrently. If 0, use
+        the number of concurrent threads supported by the hardware.
+    @returns The wall-clock time (in seconds) spent solving each trial. This
+        timing report is also written to the log.
+    @throws Exception if two trials would write the same file (checked
+        before any trial is solved), or if any of the trials failed; the
+        other trials are still solved and their results written. */
+    std::vector<double> runBatch(const std::vector<std::string>& markerFiles,
+            const std::vector<std::string>& outputMotionFiles,
+            int numThreads = 0) SWIG_DECLARE_EXCEPTION;
 #ifndef SWIG
     /** @cond **/ // hide from Doxygen
 #endif
@@ -120,6 +145,18 @@ public:
 private:
     void constructProperties();
 
+    // Track the markers in markerFile with the provided model (whose system
+    // must already be initialized), starting from the state s. Returns the
+    // number of frames solved.
+    int solveTrial(Model& model, SimTK::State& s,
+            const std::string& markerFile,
+            const std::string& outputMotionFile,
+            const std::string& trialName) const;
+
+    void populateReferences(const Model* model, const std::string& markerFile,
+        MarkersReference& markersReference,
+        SimTK::Array_<CoordinateReference>& coordinateReferences) const;
+
     //=============================================================================
 };  // END of class InverseKinematicsTool
 //=============================================================================
@@ -77,11 +77,25 @@ public:
      * Evaluate the expression.  The values of all variables should have been set before calling this.
      */
     double evaluate() const;
+    /**
+     * Get the index of a variable, for use with evaluate(const double*, const std::vector<int>&).  If the expression
+     * does not use the variable, this returns -1 (rather than throwing an exception), so that several expressions of
+     * the same variables can be evaluated in the same way.
+     */
+    int getVariableIndex(const std::string& name) const;
+    /**
+     * Evaluate the expression for the values of a list of variables: values[i] is the value of the variable whose index
+     * (see getVariableIndex()) is variableIndices[i].  Indices of -1 are ignored.  Because the indices are looked up
+     * once, rather than on every evaluation, this involves no string comparisons.  Unlike evaluate(), this does not
+     * modify the CompiledExpression, so it may be called from several threads at the same time.
+     */
+    double evaluate(const double* values, const std::vector<int>& variableIndices) const;
 private:
     friend class ParsedExpression;
     CompiledExpression(const ParsedExpression& expression);
     void compileExpression(const ExpressionTreeNode& node, std::vector<std::pair<ExpressionTreeNode, int> >& temps);
     int findTempIndex(const ExpressionTreeNode& node, std::vector<std::pair<ExpressionTreeNode, int> >& temps);
+    void foldConstants();
     std::vector<std::vector<int> > arguments;
     std::vector<int> target;
     std::vector<Operation*> operation;
@@ -54,6 +54,8 @@ CompiledExpression::CompiledExpression(const ParsedExpression& expression) : jit
     argValues.resize(maxArguments);
 #ifdef LEPTON_USE_JIT
     generateJitCode();
+#else
+    foldConstants();
 #endif
 }
 
@@ -68,11 +70,16 @@ CompiledExpression::CompiledExpression(const CompiledExpression& expression) : j
 }
 
 CompiledExpression& CompiledExpression::operator=(const CompiledExpression& expression) {
+    if (&expression == this)
+        return *this;
+    for (int i = 0; i < (int) operation.size(); i++)
+        if (operation[i] != NULL)
+            delete operation[i];
     arguments = expression.arguments;
     target = expression.target;
     variableIndices = expression.variableIndices;
     variableNames = expression.variableNames;
-    workspace.resize(expression.workspace.size());
+    workspace = expression.workspace; // Includes the values of folded constants.
     argValues.resize(expression.argValues.size());
     operation.resize(expression.operation.size());
     for (int i = 0; i < (int) operation.size(); i++)
@@ -125,6 +132,27 @@ void CompiledExpression::compileExpression(const ExpressionTreeNode& node, vecto
     workspace.push_back(0.0);
 }
 
+void CompiledExpression::foldConstants() {
+    // A constant always has the same value, so store it in the workspace once, rather than evaluating it every time
+    // the expression is evaluated.
+
+    int numSteps = 0;
+    for (int step = 0; step < (int) operation.size(); step++) {
+        if (operation[step]->getId() == Operation::CONSTANT) {
+            workspace[target[step]] = operation[step]->evaluate(&argValues[0], dummyVariables);
+            delete operation[step];
+            continue;
+        }
+        arguments[numSteps] = arguments[step];
+        target[numSteps] = target[step];
+        operation[numSteps] = operation[step];
+        numSteps++;
+    }
+    arguments.resize(numSteps);
+    target.resize(numSteps);
+    operation.resize(numSteps);
+}
+
 int CompiledExpression::findTempIndex(const ExpressionTreeNode& node, vector<pair<ExpressionTreeNode, int> >& temps) {
     for (int i = 0; i < (int) temps.size(); i++)
         if (temps[i].first == node)
@@ -143,6 +171,48 @@ double& CompiledExpression::getVariableReference(const string& name) {
     return workspace[index->second];
 }
 
+int CompiledExpression::getVariableIndex(const string& name) const {
+    map<string, int>::const_iterator index = variableIndices.find(name);
+    if (index == variableIndices.end())
+        return -1;
+    return index->second;
+}
+
+double CompiledExpression::evaluate(const double* values, const vector<int>& variableIndices) const {
+    // Use a workspace on the stack (unless the expression is large), initialized with the values of the constants,
+    // followed by space for the arguments of an operation.
+
+    const int workspaceSize = (int) workspace.size();
+    const int size = workspaceSize + (int) argValues.size();
+    double stackWorkspace[64];
+    vector<double> heapWorkspace;
+    double* work = stackWorkspace;
+    if (size > 64) {
+        heapWorkspace.resize(size);
+        work = &heapWorkspace[0];
+    }
+    double* args = work + workspaceSize;
+    for (int i = 0; i < workspaceSize; i++)
+        work[i] = workspace[i];
+    for (int i = 0; i < (int) variableIndices.size(); i++)
+        if (variableIndices[i] >= 0)
+            work[variableIndices[i]] = values[i];
+
+    // Loop over the operations and evaluate each one.
+
+    for (unsigned step = 0; step < operation.size(); step++) {
+        const vector<int>& stepArgs = arguments[step];
+        if (stepArgs.size() == 1)
+            work[target[step]] = operation[step]->evaluate(&work[stepArgs[0]], dummyVariables);
+        else {
+            for (unsigned i = 0; i < stepArgs.size(); i++)
+                args[i] = work[stepArgs[i]];
+            work[target[step]] = operation[step]->evaluate(args, dummyVariables);
+        }
+    }
+    return work[workspaceSize-1];
+}
+
 double CompiledExpression::evaluate() const {
 #ifdef LEPTON_USE_JIT
     return ((double (*)()) jitCode)();
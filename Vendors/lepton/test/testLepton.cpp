@@ -35,6 +35,28 @@ int main() {
         value = Lepton::Parser::parse("sqrt(x)-1").evaluate(variables);
         ASSERT(fabs(value-2.) < 1E-7);
         Lepton::Parser::parse("state.muscle1.activation^2");
+
+        // Compiled expressions, evaluated with variable references and with
+        // variable indices.
+        Lepton::CompiledExpression compiled =
+            Lepton::Parser::parse("2*x^2+exp(-y)-max(x,3)").createCompiledExpression();
+        compiled.getVariableReference("x") = 1.5;
+        compiled.getVariableReference("y") = 0.5;
+        const double expected = 2*1.5*1.5+exp(-0.5)-3;
+        ASSERT(fabs(compiled.evaluate()-expected) < 1E-12);
+        vector<int> indices;
+        indices.push_back(compiled.getVariableIndex("y"));
+        indices.push_back(compiled.getVariableIndex("z")); // not used
+        indices.push_back(compiled.getVariableIndex("x"));
+        ASSERT(indices[1] == -1);
+        const double values[] = {0.5, 100.0, 1.5};
+        ASSERT(fabs(compiled.evaluate(values, indices)-expected) < 1E-12);
+        Lepton::CompiledExpression copy = compiled;
+        ASSERT(fabs(copy.evaluate(values, indices)-expected) < 1E-12);
+        Lepton::CompiledExpression constant =
+            Lepton::Parser::parse("3*4-2").createCompiledExpression();
+        ASSERT(fabs(constant.evaluate()-10.) < 1E-12);
+        ASSERT(fabs(constant.evaluate(values, vector<int>())-10.) < 1E-12);
     }
     catch (...) {
         //cout << "Failed" << endl;